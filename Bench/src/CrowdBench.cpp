@@ -0,0 +1,140 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+// Crowd locomotion benchmark: N agents ticked with the scalar
+// CharacterController::Tick and with CharacterPool (1 and N threads).
+// Verifies the pool matches the scalar path exactly, then prints timings.
+//
+// usage: MadusBenchCrowd [agents=10000] [ticks=600] [threads=hw] [terrain=1]
+
+#include "Madus/CharacterController.h"
+#include "Madus/CharacterPool.h"
+#include "Madus/Heightfield.h"
+#include "Madus/Parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static uint32_t Rng(uint32_t& s){ s = s * 1664525u + 1013904223u; return s >> 8; }
+static float    Rng01(uint32_t& s){ return (float)(Rng(s) & 0xFFFF) / 65535.f; }
+
+// Deterministic per-agent input script: new wish direction every 30 ticks, occasional dash.
+static InputState ScriptInput(size_t agent, int tick){
+    uint32_t s = (uint32_t)(agent * 7919u + (uint32_t)(tick / 30) * 104729u + 1u);
+    Rng(s);
+    InputState in{};
+    in.MoveX = Rng01(s) * 2.f - 1.f;
+    in.MoveZ = Rng01(s) * 2.f - 1.f;
+    if (Rng01(s) < 0.15f) in.MoveX = in.MoveZ = 0.f;
+    in.Dash = ((tick + (int)agent) % 97) == 0;
+    return in;
+}
+
+static double NowMs(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+static bool Same(float a, float b){ return std::memcmp(&a, &b, sizeof(float)) == 0 || a == b; }
+
+static size_t CountMismatches(const std::vector<CharacterController>& ref, const CharacterPool& pool){
+    size_t bad = 0;
+    CharacterController c;
+    for (size_t i = 0; i < ref.size(); ++i) {
+        pool.CopyTo(i, c);
+        const CharacterController& r = ref[i];
+        const bool ok = Same(c.Position.x, r.Position.x) && Same(c.Position.y, r.Position.y) && Same(c.Position.z, r.Position.z)
+                     && Same(c.Velocity.x, r.Velocity.x) && Same(c.Velocity.y, r.Velocity.y) && Same(c.Velocity.z, r.Velocity.z)
+                     && Same(c.DashTimer, r.DashTimer) && Same(c.DashCDTimer, r.DashCDTimer)
+                     && Same(c.OnGroundTime, r.OnGroundTime) && Same(c.OffGroundTime, r.OffGroundTime)
+                     && c.Grounded == r.Grounded && c.Invulnerable == r.Invulnerable && c.State == r.State;
+        bad += ok ? 0 : 1;
+    }
+    return bad;
+}
+
+int main(int argc, char** argv){
+    const size_t agents  = (argc > 1) ? (size_t)std::atoll(argv[1]) : 10000;
+    const int    ticks   = (argc > 2) ? std::atoi(argv[2]) : 600;
+    const int    threads = (argc > 3) ? std::atoi(argv[3]) : Parallel_HardwareThreads();
+    const bool   terrain = (argc > 4) ? std::atoi(argv[4]) != 0 : true;
+    const float  dt      = 1.f / 60.f;
+
+    // Rolling hills with a few steep mounds the agents can't walk up.
+    Heightfield hf;
+    hf.Init(257, 257, 1.f, -128.f, -128.f);
+    for (int z = 0; z < hf.SizeZ; ++z)
+        for (int x = 0; x < hf.SizeX; ++x) {
+            const float wx = hf.OriginX + x * hf.CellSize, wz = hf.OriginZ + z * hf.CellSize;
+            const float mound = std::max(0.f, 6.f - 0.8f * std::sqrt((wx - 20.f) * (wx - 20.f) + (wz + 30.f) * (wz + 30.f)));
+            hf.At(x, z) = 1.5f * std::sin(wx * 0.1f) * std::cos(wz * 0.13f) + mound;
+        }
+    hf.RebuildNormals();
+
+    // A walled arena with some pillars, so the swept collision path runs too.
+    std::vector<AABB2> walls = {
+        {-101,-101, 101,-100}, {-101, 100, 101, 101}, {-101,-100,-100, 100}, { 100,-100, 101, 100},
+    };
+    for (int z = -80; z <= 80; z += 40)
+        for (int x = -80; x <= 80; x += 40)
+            walls.push_back({x - 2.f, z - 2.f, x + 2.f, z + 2.f});
+
+    const Vec3 camF = Normalize(Vec3{0.7f, -0.5f, -0.7f});
+    const Vec3 camR = Normalize(Cross(camF, Vec3{0,1,0}));
+
+    std::vector<CharacterController> scalar(agents);
+    uint32_t seed = 12345;
+    for (CharacterController& c : scalar) {
+        c.Position = {Rng01(seed) * 180.f - 90.f, 0.9f, Rng01(seed) * 180.f - 90.f};
+        c.Colliders = walls.data(); c.ColliderCount = walls.size();
+        c.Ground = terrain ? &hf : nullptr;
+    }
+
+    CharacterPool single, multi;
+    for (CharacterPool* p : {&single, &multi}) {
+        p->Archetype = scalar[0];
+        p->Reserve(agents);
+        for (const CharacterController& c : scalar) p->Spawn(c);
+    }
+
+    double tScalar = 0, tSingle = 0, tMulti = 0;
+    for (int t = 0; t < ticks; ++t) {
+        for (size_t i = 0; i < agents; ++i) {
+            const InputState in = ScriptInput(i, t);
+            single.SetInput(i, in, camF, camR);
+            multi.SetInput(i, in, camF, camR);
+        }
+
+        double t0 = NowMs();
+        for (size_t i = 0; i < agents; ++i) scalar[i].Tick(ScriptInput(i, t), dt, camF, camR);
+        double t1 = NowMs();
+        single.Tick(dt, 1);
+        double t2 = NowMs();
+        multi.Tick(dt, threads);
+        double t3 = NowMs();
+
+        tScalar += t1 - t0; tSingle += t2 - t1; tMulti += t3 - t2;
+    }
+    // The scalar timing includes regenerating its input; measure that alone and subtract.
+    double tInput = NowMs();
+    for (int t = 0; t < ticks; ++t)
+        for (size_t i = 0; i < agents; ++i) { volatile float sink = ScriptInput(i, t).MoveX; (void)sink; }
+    tInput = NowMs() - tInput;
+    tScalar = std::max(0.0, tScalar - tInput);
+
+    const size_t badSingle = CountMismatches(scalar, single);
+    const size_t badMulti  = CountMismatches(scalar, multi);
+
+    const double per = 1e6 / (double)(agents * (size_t)ticks); // ms -> ns per agent-tick
+    std::printf("agents=%zu ticks=%d colliders=%zu threads=%d terrain=%s\n", agents, ticks, walls.size(), threads, terrain ? "heightfield" : "flat");
+    std::printf("  scalar Tick        : %8.2f ms/tick  %7.1f ns/agent\n", tScalar / ticks, tScalar * per);
+    std::printf("  CharacterPool x1   : %8.2f ms/tick  %7.1f ns/agent\n", tSingle / ticks, tSingle * per);
+    std::printf("  CharacterPool x%-3d : %8.2f ms/tick  %7.1f ns/agent\n", threads, tMulti / ticks, tMulti * per);
+    std::printf("  mismatches vs scalar: single=%zu multi=%zu\n", badSingle, badMulti);
+    return (badSingle == 0 && badMulti == 0) ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+// Job system scheduling overhead. Every job body is empty or nearly so, so
+// the timings are the cost of submitting, stealing, running and retiring a
+// job, per job:
+//   - flat:      the main thread submits N empty jobs and waits
+//   - split:     Jobs_ParallelFor over N items with grain 1 (recursive halving)
+//   - graph:     a layered TaskGraph, each task depending on two of the layer above
+//   - main lane: N jobs through Jobs_SubmitMain + Jobs_PumpMain
+// and a small parallel loop per call (the crowd/ECS shape) through
+// ParallelFor against spawning std::threads per call, which is what
+// ParallelFor did before the job system.
+//
+// usage: MadusBenchJobs [jobs=200000] [workers=-1] [reps=5]
+
+#include "Madus/Jobs.h"
+#include "Madus/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+static double NowMs(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+// Best of 'reps' runs of fn, in ms.
+template<class F> static double Best(int reps, F&& fn){
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        const double t0 = NowMs();
+        fn();
+        best = std::min(best, NowMs() - t0);
+    }
+    return best;
+}
+
+static void ThreadForkJoin(size_t count, int workers, const std::function<void(size_t, size_t)>& fn){
+    const size_t per = (count + (size_t)workers - 1) / (size_t)workers;
+    std::vector<std::thread> threads;
+    for (int c = 1; c < workers; ++c) {
+        const size_t b = (size_t)c * per, e = std::min(count, b + per);
+        if (b < e) threads.emplace_back([&fn, b, e]{ fn(b, e); });
+    }
+    fn(0, std::min(count, per));
+    for (std::thread& t : threads) t.join();
+}
+
+int main(int argc, char** argv){
+    const int jobs    = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const int workers = argc > 2 ? std::atoi(argv[2]) : -1;
+    const int reps    = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    Jobs_Init(workers);
+    const int threads = Jobs_WorkerCount() + 1;
+    std::atomic<uint64_t> sink{0};
+    bool ok = true;
+
+    // flat
+    const double tFlat = Best(reps, [&]{
+        JobCounter c;
+        for (int i = 0; i < jobs; ++i) Jobs_Run(c, []{});
+        Jobs_Wait(c);
+    });
+
+    // split
+    const double tSplit = Best(reps, [&]{
+        Jobs_ParallelFor((size_t)jobs, 1, [&](size_t b, size_t e){ sink.fetch_add(e - b, std::memory_order_relaxed); });
+    });
+    ok &= sink.load() == (uint64_t)jobs * (uint64_t)reps;
+
+    // graph: layers x width, task (l,i) after (l-1,i) and (l-1,(i+1)%width)
+    const int width = 64, layers = std::max(1, jobs / width);
+    TaskGraph g;
+    std::vector<uint32_t> ran((size_t)width * layers, 0);
+    for (int l = 0; l < layers; ++l)
+        for (int i = 0; i < width; ++i) {
+            uint32_t* slot = &ran[(size_t)l * width + i];
+            const TaskGraph::TaskId t = g.Add([slot]{ ++*slot; });
+            if (l > 0) {
+                g.Depend(t, (TaskGraph::TaskId)((l - 1) * width + i));
+                g.Depend(t, (TaskGraph::TaskId)((l - 1) * width + (i + 1) % width));
+            }
+        }
+    const double tGraph = Best(reps, [&]{ g.Run(); });
+    for (uint32_t r : ran) ok &= r == (uint32_t)reps;
+
+    // main lane
+    int pumped = 0;
+    const double tMain = Best(reps, [&]{
+        JobCounter c;
+        for (int i = 0; i < jobs; ++i) Jobs_RunMain(c, []{});
+        pumped += Jobs_PumpMain();
+    });
+    ok &= pumped == jobs * reps;
+
+    // per-call parallel loop: 4096 items of trivial work, 100 calls
+    const size_t items = 4096;
+    const int calls = 100;
+    std::vector<float> data(items, 1.f);
+    auto body = [&](size_t b, size_t e){ for (size_t i = b; i < e; ++i) data[i] = data[i] * 0.5f + 1.f; };
+    const double tLoopJobs = Best(reps, [&]{ for (int k = 0; k < calls; ++k) ParallelFor(items, 256, body); });
+    const double tLoopThreads = Best(reps, [&]{ for (int k = 0; k < calls; ++k) ThreadForkJoin(items, threads, body); });
+
+    std::printf("\njob system: %d threads (main + %d workers), %d jobs, best of %d\n", threads, threads - 1, jobs, reps);
+    std::printf("  flat submit+wait     %8.1f ns/job\n", tFlat * 1e6 / jobs);
+    std::printf("  ParallelFor split    %8.1f ns/leaf\n", tSplit * 1e6 / jobs);
+    std::printf("  task graph           %8.1f ns/task  (%d x %d, 2 deps each)\n", tGraph * 1e6 / ((double)layers * width), layers, width);
+    std::printf("  main lane            %8.1f ns/job\n", tMain * 1e6 / jobs);
+    std::printf("  parallel loop (%zu items)\n", items);
+    std::printf("    jobs               %8.2f us/call\n", tLoopJobs * 1e3 / calls);
+    std::printf("    thread fork-join   %8.2f us/call  (%.1fx)\n", tLoopThreads * 1e3 / calls, tLoopThreads / tLoopJobs);
+    std::printf("  results %s\n", ok ? "complete" : "MISSING");
+
+    Jobs_Shutdown();
+    return ok ? 0 : 1;
+}
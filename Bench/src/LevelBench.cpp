@@ -0,0 +1,115 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+// Level load benchmark: writes an N-collider text map, then times the old
+// ifstream/istringstream loader, Level::LoadTxt, and Level::LoadBin (mapped)
+// against a plain read of the same bytes. Verifies all paths agree.
+//
+// usage: MadusBenchLevel [colliders=1000000] [dir=.]
+
+#include "Madus/File.h"
+#include "Madus/Level.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static double NowMs(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+// The loader this replaced, kept as the baseline.
+static bool LegacyLoadTxt(const char* path, std::vector<AABB2>& out){
+    std::ifstream f(path);
+    if (!f.is_open()) return false;
+    out.clear();
+    std::string line;
+    while (std::getline(f, line)) {
+        const size_t i = line.find_first_not_of(" \t\r\n");
+        if (i == std::string::npos || line[i] == '#' || (i + 1 < line.size() && line[i] == '/' && line[i+1] == '/')) continue;
+        std::istringstream iss(line);
+        float minx, minz, maxx, maxz;
+        if (!(iss >> minx >> minz >> maxx >> maxz)) continue;
+        if (maxx < minx) std::swap(maxx, minx);
+        if (maxz < minz) std::swap(maxz, minz);
+        out.push_back({minx, minz, maxx, maxz});
+    }
+    return !out.empty();
+}
+
+static bool WriteTestMap(const char* path, size_t n){
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    std::fprintf(f, "# generated: %zu colliders\n", n);
+    uint32_t s = 12345u;
+    for (size_t i = 0; i < n; ++i) {
+        s = s * 1664525u + 1013904223u; const float x = (float)((s >> 8) % 200000) * 0.01f - 1000.f;
+        s = s * 1664525u + 1013904223u; const float z = (float)((s >> 8) % 200000) * 0.01f - 1000.f;
+        s = s * 1664525u + 1013904223u; const float w = 0.25f + (float)((s >> 8) % 400) * 0.01f;
+        std::fprintf(f, "%.2f %.2f %.2f %.2f\n", x, z, x + w, z + 0.5f * w);
+    }
+    return std::fclose(f) == 0;
+}
+
+// Touches every collider so mapped pages are actually faulted in.
+static double Checksum(const AABB2* b, size_t n){
+    double acc = 0.0;
+    for (size_t i = 0; i < n; ++i) acc += b[i].minx + b[i].minz + b[i].maxx + b[i].maxz;
+    return acc;
+}
+
+int main(int argc, char** argv){
+    const size_t n = argc > 1 ? (size_t)std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::string dir = argc > 2 ? argv[2] : ".";
+    const std::string txt = dir + "/bench_level.txt", bin = dir + "/bench_level.mlvl";
+
+    if (!WriteTestMap(txt.c_str(), n)) { std::printf("cannot write %s\n", txt.c_str()); return 1; }
+
+    std::string raw;
+    double t0 = NowMs();
+    File_ReadAll(txt.c_str(), raw);
+    const double tRead = NowMs() - t0;
+
+    std::vector<AABB2> legacy;
+    t0 = NowMs();
+    LegacyLoadTxt(txt.c_str(), legacy);
+    const double tLegacy = NowMs() - t0;
+
+    Level lt;
+    t0 = NowMs();
+    lt.LoadTxt(txt.c_str());
+    const double tTxt = NowMs() - t0;
+
+    if (!lt.SaveBin(bin.c_str())) return 1;
+
+    Level lb;
+    t0 = NowMs();
+    lb.LoadBin(bin.c_str());
+    const double tMap = NowMs() - t0;
+    t0 = NowMs();
+    const double sum = Checksum(lb.Colliders().data(), lb.Colliders().size());
+    const double tTouch = NowMs() - t0;
+
+    const bool same = legacy.size() == lt.Colliders().size() && lt.Colliders().size() == lb.Colliders().size()
+        && std::memcmp(legacy.data(), lt.Colliders().data(), legacy.size() * sizeof(AABB2)) == 0
+        && std::memcmp(legacy.data(), lb.Colliders().data(), legacy.size() * sizeof(AABB2)) == 0;
+
+    std::printf("\ncolliders %zu  text %.1f MB  bin %.1f MB  (checksum %.1f)\n", n,
+                raw.size() / 1048576.0, (double)(lb.Colliders().size_bytes() + sizeof(LevelBinHeader)) / 1048576.0, sum);
+    std::printf("  read text bytes     %9.2f ms\n", tRead);
+    std::printf("  legacy istringstream%9.2f ms\n", tLegacy);
+    std::printf("  LoadTxt from_chars  %9.2f ms  (%.1fx legacy)\n", tTxt, tLegacy / tTxt);
+    std::printf("  LoadBin map         %9.2f ms\n", tMap);
+    std::printf("  LoadBin map + touch %9.2f ms\n", tMap + tTouch);
+    std::printf("  results %s\n", same ? "identical" : "MISMATCH");
+
+    std::remove(txt.c_str());
+    std::remove(bin.c_str());
+    return same ? 0 : 1;
+}
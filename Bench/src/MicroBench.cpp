@@ -0,0 +1,380 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+// Microbenchmarks for engine hot paths, one case per line:
+//   math/*                Perspective, LookAt, TRS, QuatToMat4, MulM over 1024 inputs
+//   collision/resolve     ResolveCircleAABB2 against N colliders
+//   collision/slide       MoveAndSlideXZ into a corner with 0, 1 and 3 slides (checks it gets there)
+//   controller/tick       CharacterController::Tick for 256 agents, flat and on terrain with walls
+//   level/loadtxt         Level::LoadTxt on generated maps of 1k to 1M lines
+//   texture/checker       CreateCheckerTexture's pixel generation (no GL)
+//
+// Each case is calibrated to at least --min-ms per repetition, then timed
+// --reps times. Reported per call: min, median, mean and stddev in ns, and
+// items/s at the median (items are inputs, colliders, agents, lines or pixels).
+// Pin to one core (--pin) and compare medians across builds.
+//
+// usage: MadusBench [--reps N=10] [--min-ms ms=20] [--pin cpu] [--filter substr]
+//                   [--max-lines N=1000000] [--dir path=.] [--json out.json]
+
+#include "Madus/CharacterController.h"
+#include "Madus/Collision.h"
+#include "Madus/File.h"
+#include "Madus/Heightfield.h"
+#include "Madus/Level.h"
+#include "Madus/Math.h"
+#include "Madus/Texture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+static double NowMs(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+static uint32_t Rng(uint32_t& s){ s = s * 1664525u + 1013904223u; return s >> 8; }
+static float    Rng01(uint32_t& s){ return (float)(Rng(s) & 0xFFFF) / 65535.f; }
+
+// Results are folded into this so the optimizer can't drop the work.
+static volatile float gSink;
+
+static bool PinToCpu(int cpu){
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+struct BenchResult {
+    std::string Name, Param;
+    uint64_t Iters = 0;          // calls per repetition
+    double   Items = 0.0;        // per call
+    double   MinNs = 0.0, MedianNs = 0.0, MeanNs = 0.0, StddevNs = 0.0;   // per call
+};
+
+class Suite {
+public:
+    int         Reps = 10;
+    double      MinMs = 20.0;
+    std::string Filter;
+    std::vector<BenchResult> Results;
+
+    bool Enabled(const char* name) const { return Filter.empty() || std::string_view(name).find(Filter) != std::string_view::npos; }
+
+    // fn() is one call; items is the work it does, for the throughput column.
+    template<class F>
+    void Run(const char* name, const std::string& param, double items, F&& fn){
+        BenchResult r;
+        r.Name = name; r.Param = param; r.Items = items;
+
+        double t0 = NowMs();   // warm-up call doubles as the calibration
+        gSink = gSink + fn();
+        const double once = std::max(NowMs() - t0, 1e-5);
+        r.Iters = (uint64_t)std::clamp(std::ceil(MinMs / once), 1.0, 1e9);
+
+        std::vector<double> ns((size_t)Reps);
+        for (double& v : ns) {
+            float acc = 0.f;
+            t0 = NowMs();
+            for (uint64_t i = 0; i < r.Iters; ++i) acc += fn();
+            v = (NowMs() - t0) * 1e6 / (double)r.Iters;
+            gSink = gSink + acc;
+        }
+        std::sort(ns.begin(), ns.end());
+        r.MinNs = ns.front();
+        r.MedianNs = (ns.size() & 1) ? ns[ns.size() / 2] : 0.5 * (ns[ns.size() / 2 - 1] + ns[ns.size() / 2]);
+        for (double v : ns) r.MeanNs += v;
+        r.MeanNs /= (double)ns.size();
+        for (double v : ns) r.StddevNs += (v - r.MeanNs) * (v - r.MeanNs);
+        r.StddevNs = ns.size() > 1 ? std::sqrt(r.StddevNs / (double)(ns.size() - 1)) : 0.0;
+
+        std::printf("  %-22s %-18s %12.1f ns min %12.1f ns med %6.2f%% sd %10.2f M items/s\n", name, param.c_str(),
+                    r.MinNs, r.MedianNs, r.MeanNs > 0.0 ? 100.0 * r.StddevNs / r.MeanNs : 0.0, items / r.MedianNs * 1e3);
+        Results.push_back(std::move(r));
+    }
+};
+
+// ---- math ------------------------------------------------------------------
+
+constexpr size_t MATH_N = 1024;
+
+static void BenchMath(Suite& s){
+    uint32_t seed = 1;
+    std::vector<Vec3> a(MATH_N), b(MATH_N), sc(MATH_N);
+    std::vector<Quat> q(MATH_N);
+    std::vector<float> f(MATH_N);
+    for (size_t i = 0; i < MATH_N; ++i) {
+        a[i]  = { Rng01(seed) * 20.f - 10.f, Rng01(seed) * 20.f - 10.f, Rng01(seed) * 20.f - 10.f };
+        b[i]  = { Rng01(seed) * 20.f - 10.f, Rng01(seed) * 20.f - 10.f, Rng01(seed) * 20.f - 10.f };
+        sc[i] = { 0.5f + Rng01(seed), 0.5f + Rng01(seed), 0.5f + Rng01(seed) };
+        q[i]  = AngleAxis(Rng01(seed) * 6.28f, Normalize({ Rng01(seed) - 0.5f, Rng01(seed) - 0.5f, 1.f }));
+        f[i]  = 0.5f + Rng01(seed);
+    }
+    std::vector<Mat4> m(MATH_N), out(MATH_N);
+    for (size_t i = 0; i < MATH_N; ++i) m[i] = TRS(a[i], q[i], sc[i]);
+
+    const std::string param = "n=" + std::to_string(MATH_N);
+    if (s.Enabled("math/perspective"))
+        s.Run("math/perspective", param, MATH_N, [&]{
+            for (size_t i = 0; i < MATH_N; ++i) out[i] = Perspective(f[i], 1.777f, 0.05f, 500.f);
+            return out[MATH_N - 1].m[0];
+        });
+    if (s.Enabled("math/lookat"))
+        s.Run("math/lookat", param, MATH_N, [&]{
+            for (size_t i = 0; i < MATH_N; ++i) out[i] = LookAt(a[i], b[i], {0, 1, 0});
+            return out[MATH_N - 1].m[0];
+        });
+    if (s.Enabled("math/trs"))
+        s.Run("math/trs", param, MATH_N, [&]{
+            for (size_t i = 0; i < MATH_N; ++i) out[i] = TRS(a[i], q[i], sc[i]);
+            return out[MATH_N - 1].m[0];
+        });
+    if (s.Enabled("math/quattomat4"))
+        s.Run("math/quattomat4", param, MATH_N, [&]{
+            for (size_t i = 0; i < MATH_N; ++i) out[i] = QuatToMat4(q[i]);
+            return out[MATH_N - 1].m[0];
+        });
+    if (s.Enabled("math/mulm"))
+        s.Run("math/mulm", param, MATH_N, [&]{
+            for (size_t i = 0; i < MATH_N; ++i) out[i] = MulM(m[i], m[MATH_N - 1 - i]);
+            return out[MATH_N - 1].m[0];
+        });
+}
+
+// ---- collision ---------------------------------------------------------------
+
+// n boxes of 0.5..2.5 m over a square that grows with n, so they cover ~15% of it at any n.
+static std::vector<AABB2> RandomBoxes(size_t n, uint32_t seed){
+    const float half = 2.f + std::sqrt((float)n) * 2.f;
+    std::vector<AABB2> boxes(n);
+    for (AABB2& b : boxes) {
+        const float x = Rng01(seed) * 2.f * half - half, z = Rng01(seed) * 2.f * half - half;
+        const float w = 0.5f + Rng01(seed) * 2.f, d = 0.5f + Rng01(seed) * 2.f;
+        b = { x, z, x + w, z + d };
+    }
+    return boxes;
+}
+
+static void BenchCollision(Suite& s){
+    if (!s.Enabled("collision/resolve")) return;
+    for (size_t n : { 1u, 8u, 64u, 512u, 4096u }) {
+        const std::vector<AABB2> boxes = RandomBoxes(n, 7u + (uint32_t)n);
+        // Probes on a grid across the same area, so some calls push out and most miss.
+        std::vector<Vec3> probes;
+        const float half = 2.f + std::sqrt((float)n) * 2.f;
+        for (int z = 0; z < 4; ++z)
+            for (int x = 0; x < 4; ++x) probes.push_back({ -half + (x + 0.5f) * half * 0.5f, 0.f, -half + (z + 0.5f) * half * 0.5f });
+        size_t k = 0;
+        s.Run("collision/resolve", "colliders=" + std::to_string(n), (double)n, [&]{
+            Vec3 pos = probes[k++ & 15], vel{ 3.f, 0.f, -2.f };
+            for (const AABB2& b : boxes) ResolveCircleAABB2(pos, vel, 0.45f, b);
+            return pos.x + vel.z;
+        });
+    }
+}
+
+// A diagonal move into an inside corner: the first contact is the floor wall,
+// the slide along it ends at the end wall. With fewer slides than contacts
+// the rest of the move must still be taken up to the next wall, not dropped.
+static bool BenchSlide(Suite& s){
+    if (!s.Enabled("collision/slide")) return true;
+    const AABB2 walls[] = { { -10.f, -2.f, 10.f, -1.f }, { 2.f, -10.f, 3.f, 10.f } };
+    constexpr float radius = 0.45f, dt = 1.f / 60.f;
+    for (int iterations : { 0, 1, 3 }) {
+        Vec3 pos{ 0.f, 0.f, 0.f }, vel{ 240.f, 0.f, -240.f };
+        MoveAndSlideXZ(pos, vel, dt, radius, walls, 2, iterations);
+        if (std::fabs(pos.x - (2.f - radius)) > 0.01f || std::fabs(pos.z - (-1.f + radius)) > 0.01f) {
+            std::fprintf(stderr, "collision/slide: %d slides stopped at (%.3f, %.3f), not in the corner\n", iterations, pos.x, pos.z);
+            return false;
+        }
+        s.Run("collision/slide", "slides=" + std::to_string(iterations), 1.0, [&]{
+            Vec3 p{ 0.f, 0.f, 0.f }, v{ 240.f, 0.f, -240.f };
+            MoveAndSlideXZ(p, v, dt, radius, walls, 2, iterations);
+            return p.x + p.z;
+        });
+    }
+    return true;
+}
+
+// ---- character controller --------------------------------------------------
+
+constexpr size_t CTRL_AGENTS = 256;
+
+// Same script as MadusBenchCrowd: new wish direction every 30 ticks, occasional dash.
+static InputState ScriptInput(size_t agent, int tick){
+    uint32_t s = (uint32_t)(agent * 7919u + (uint32_t)(tick / 30) * 104729u + 1u);
+    Rng(s);
+    InputState in{};
+    in.MoveX = Rng01(s) * 2.f - 1.f;
+    in.MoveZ = Rng01(s) * 2.f - 1.f;
+    if (Rng01(s) < 0.15f) in.MoveX = in.MoveZ = 0.f;
+    in.Dash = ((tick + (int)agent) % 97) == 0;
+    return in;
+}
+
+static void BenchController(Suite& s){
+    if (!s.Enabled("controller/tick")) return;
+    Heightfield hf;
+    hf.Init(129, 129, 1.f, -64.f, -64.f);
+    for (int z = 0; z < hf.SizeZ; ++z)
+        for (int x = 0; x < hf.SizeX; ++x) {
+            const float wx = hf.OriginX + x * hf.CellSize, wz = hf.OriginZ + z * hf.CellSize;
+            hf.At(x, z) = 1.5f * std::sin(wx * 0.1f) * std::cos(wz * 0.13f);
+        }
+    hf.RebuildNormals();
+    const std::vector<AABB2> walls = RandomBoxes(64, 99u);
+
+    const Vec3 camFwd = Normalize({ 0.57f, -0.57f, -0.57f }), camRight = Normalize(Cross(camFwd, { 0, 1, 0 }));
+    for (const bool world : { false, true }) {
+        std::vector<CharacterController> agents(CTRL_AGENTS);
+        uint32_t seed = 5;
+        for (CharacterController& c : agents) {
+            c.Position = { Rng01(seed) * 40.f - 20.f, 0.f, Rng01(seed) * 40.f - 20.f };
+            if (world) { c.Ground = &hf; c.Colliders = walls.data(); c.ColliderCount = walls.size(); }
+        }
+        std::vector<InputState> inputs(CTRL_AGENTS * 60);   // one second of script, replayed cyclically
+        for (int t = 0; t < 60; ++t)
+            for (size_t i = 0; i < CTRL_AGENTS; ++i) inputs[t * CTRL_AGENTS + i] = ScriptInput(i, t);
+        int tick = 0;
+        s.Run("controller/tick", world ? "terrain+64walls" : "flat", (double)CTRL_AGENTS, [&]{
+            const InputState* in = &inputs[(size_t)(tick++ % 60) * CTRL_AGENTS];
+            for (size_t i = 0; i < CTRL_AGENTS; ++i) agents[i].Tick(in[i], 1.f / 60.f, camFwd, camRight);
+            return agents[0].Position.x;
+        });
+    }
+}
+
+// ---- level text loader ------------------------------------------------------
+
+// Same format and value ranges as MadusBenchLevel's map.
+static bool WriteTestMap(const char* path, size_t n){
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    std::fprintf(f, "# generated: %zu colliders\n", n);
+    uint32_t s = 12345u;
+    for (size_t i = 0; i < n; ++i) {
+        const float x = (float)(Rng(s) % 200000) * 0.01f - 1000.f;
+        const float z = (float)(Rng(s) % 200000) * 0.01f - 1000.f;
+        const float w = 0.25f + (float)(Rng(s) % 400) * 0.01f;
+        std::fprintf(f, "%.2f %.2f %.2f %.2f\n", x, z, x + w, z + 0.5f * w);
+    }
+    return std::fclose(f) == 0;
+}
+
+static bool BenchLevel(Suite& s, size_t maxLines, const std::string& dir){
+    if (!s.Enabled("level/loadtxt")) return true;
+    const std::string path = dir + "/madus_bench_level.txt";
+    for (size_t n = 1000; n <= maxLines; n *= 10) {
+        if (!WriteTestMap(path.c_str(), n)) { std::fprintf(stderr, "cannot write %s\n", path.c_str()); return false; }
+        // LoadTxt's own steps, minus its per-load log line.
+        Level level;
+        std::string text;
+        s.Run("level/loadtxt", "lines=" + std::to_string(n), (double)n, [&]{
+            File_ReadAll(path.c_str(), text);
+            level.ParseTxt(text.data(), text.size(), path.c_str());
+            return level.Colliders().back().maxx;
+        });
+    }
+    std::remove(path.c_str());
+    return true;
+}
+
+// ---- checker texture ---------------------------------------------------------
+
+static void BenchChecker(Suite& s){
+    if (!s.Enabled("texture/checker")) return;
+    for (int size : { 256, 1024, 2048 }) {
+        std::vector<unsigned char> rgba((size_t)size * size * 4);
+        s.Run("texture/checker", "size=" + std::to_string(size), (double)size * size, [&]{
+            GenerateCheckerPixels(rgba.data(), size, 16);
+            return (float)rgba[rgba.size() / 2];
+        });
+    }
+}
+
+// ---- output ------------------------------------------------------------------
+
+static bool WriteJson(const char* path, const Suite& s, int pinned){
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) { std::fprintf(stderr, "cannot write '%s'\n", path); return false; }
+#ifdef NDEBUG
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+    std::fprintf(f, "{\n  \"suite\": \"MadusBench\",\n  \"build\": \"%s\",\n  \"reps\": %d,\n  \"min_ms\": %.1f,\n  \"pinned_cpu\": %d,\n  \"results\": [",
+                 build, s.Reps, s.MinMs, pinned);
+    for (size_t i = 0; i < s.Results.size(); ++i) {
+        const BenchResult& r = s.Results[i];
+        std::fprintf(f, "%s\n    { \"name\": \"%s\", \"param\": \"%s\", \"iters\": %llu, \"items\": %.0f, "
+                        "\"min_ns\": %.2f, \"median_ns\": %.2f, \"mean_ns\": %.2f, \"stddev_ns\": %.2f, \"items_per_s\": %.1f }",
+                     i ? "," : "", r.Name.c_str(), r.Param.c_str(), (unsigned long long)r.Iters, r.Items,
+                     r.MinNs, r.MedianNs, r.MeanNs, r.StddevNs, r.Items / r.MedianNs * 1e9);
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+int main(int argc, char** argv){
+    Suite suite;
+    int pin = -1;
+    size_t maxLines = 1000000;
+    std::string dir = ".";
+    const char* jsonPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool more = i + 1 < argc;
+        if      (arg == "--reps" && more)      suite.Reps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--min-ms" && more)    suite.MinMs = std::strtod(argv[++i], nullptr);
+        else if (arg == "--pin" && more)       pin = std::atoi(argv[++i]);
+        else if (arg == "--filter" && more)    suite.Filter = argv[++i];
+        else if (arg == "--max-lines" && more) maxLines = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--dir" && more)       dir = argv[++i];
+        else if (arg == "--json" && more)      jsonPath = argv[++i];
+        else {
+            std::fprintf(stderr, "usage: %s [--reps N] [--min-ms ms] [--pin cpu] [--filter substr] [--max-lines N] [--dir path] [--json out.json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (pin >= 0 && !PinToCpu(pin)) {
+        std::fprintf(stderr, "cannot pin to cpu %d; running unpinned\n", pin);
+        pin = -1;
+    }
+    std::printf("MadusBench: %d reps, >= %.1f ms each%s\n", suite.Reps, suite.MinMs,
+                pin >= 0 ? (", pinned to cpu " + std::to_string(pin)).c_str() : "");
+
+    BenchMath(suite);
+    BenchCollision(suite);
+    if (!BenchSlide(suite)) return 1;
+    BenchController(suite);
+    if (!BenchLevel(suite, maxLines, dir)) return 1;
+    BenchChecker(suite);
+
+    if (jsonPath && !WriteJson(jsonPath, suite, pin)) return 1;
+    return 0;
+}
@@ -0,0 +1,398 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+// Replay benchmark: runs the engine headless through a level while a
+// recorded input path drives the hero, one fixed tick per frame, so every
+// run simulates and draws exactly the same frames. A crowd of scripted
+// agents walks the same level. Reports frame-time percentiles over the run,
+// the profiler zones (CPU and "GPU ..." timer zones) over its last frames
+// and a hash of every controller's final state, which must match between
+// runs of the same build and input.
+//
+// --out writes the results as JSON; --baseline reads such a file back and
+// fails (exit 1) if p50/p95/p99 got slower by more than --threshold percent
+// or the final state differs.
+//
+// usage: MadusBenchReplay [--input path.minp] [--level path.mlvl|.txt] [--frames N]
+//                         [--warmup N] [--agents N] [--size WxH] [--windowed]
+//                         [--out results.json] [--baseline results.json] [--threshold pct]
+//                         [--save-input path.minp]
+// Without --input the hero walks a built-in path (1800 ticks); without
+// --level the arena is a walled square with a grid of pillars.
+
+#include "Madus/App.h"
+#include "Madus/CharacterController.h"
+#include "Madus/Engine.h"
+#include "Madus/File.h"
+#include "Madus/Heightfield.h"
+#include "Madus/InputReplay.h"
+#include "Madus/Level.h"
+#include "Madus/Mesh.h"
+#include "Madus/Profiler.h"
+#include "Madus/Renderer.h"
+#include "Madus/Scene.h"
+#include "Madus/Terrain.h"
+#include "Madus/Texture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static double NowMs(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+static uint32_t Rng(uint32_t& s){ s = s * 1664525u + 1013904223u; return s >> 8; }
+static float    Rng01(uint32_t& s){ return (float)(Rng(s) & 0xFFFF) / 65535.f; }
+
+// Same script as MadusBenchCrowd: new wish direction every 30 ticks, occasional dash.
+static InputState AgentInput(size_t agent, uint64_t tick){
+    uint32_t s = (uint32_t)(agent * 7919u + (uint32_t)(tick / 30) * 104729u + 1u);
+    Rng(s);
+    InputState in{};
+    in.MoveX = Rng01(s) * 2.f - 1.f;
+    in.MoveZ = Rng01(s) * 2.f - 1.f;
+    if (Rng01(s) < 0.15f) in.MoveX = in.MoveZ = 0.f;
+    in.Dash = ((tick + agent) % 97) == 0;
+    return in;
+}
+
+// Eight headings, 1.5 s each, with a dash into every other one and a pause every fourth.
+static void BuiltInPath(InputRecording& rec, uint64_t ticks){
+    rec.Clear();
+    for (uint64_t t = 0; t < ticks; ++t) {
+        const uint64_t leg = t / 90;
+        InputState in{};
+        if (leg % 4 != 3) {
+            const float a = (float)(leg % 8) * (float)MADUS_PI * 0.25f;
+            in.MoveX = std::cos(a);
+            in.MoveZ = std::sin(a);
+            in.Dash = (leg % 2 == 0) && (t % 90 == 10);
+        }
+        rec.Record(t, in);
+    }
+}
+
+static void BuildTerrain(Heightfield& hf){
+    hf.Init(257, 257, 0.5f, -64.f, -64.f);
+    for (int z = 0; z < hf.SizeZ; ++z)
+        for (int x = 0; x < hf.SizeX; ++x) {
+            const float wx = hf.OriginX + x * hf.CellSize, wz = hf.OriginZ + z * hf.CellSize;
+            const float edge = std::max(std::fabs(wx), std::fabs(wz)) - 20.f;
+            const float t = std::clamp(edge / 12.f, 0.f, 1.f);
+            const float hills = 2.5f + 1.5f * std::sin(wx * 0.15f) * std::cos(wz * 0.11f);
+            hf.At(x, z) = t * t * (3.f - 2.f * t) * hills;
+        }
+    hf.RebuildNormals();
+}
+
+static std::vector<AABB2> BuiltInLevel(){
+    std::vector<AABB2> walls = {
+        {-31,-31, 31,-30}, {-31, 30, 31, 31}, {-31,-30,-30, 30}, { 30,-30, 31, 30},
+    };
+    for (int z = -24; z <= 24; z += 6)
+        for (int x = -24; x <= 24; x += 6)
+            if (x || z) walls.push_back({x - 0.6f, z - 0.6f, x + 0.6f, z + 0.6f});
+    return walls;
+}
+
+// FNV-1a over everything a tick writes, in entity order.
+static uint64_t HashState(EcsWorld& scene){
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](const void* p, size_t n){
+        const unsigned char* b = static_cast<const unsigned char*>(p);
+        for (size_t i = 0; i < n; ++i) { h ^= b[i]; h *= 1099511628211ull; }
+    };
+    scene.Each<CharacterController>([&](Entity, CharacterController& c){
+        mix(&c.Position, sizeof(c.Position));
+        mix(&c.Velocity, sizeof(c.Velocity));
+        mix(&c.DashTimer, sizeof(float));   mix(&c.DashCDTimer, sizeof(float));
+        mix(&c.OnGroundTime, sizeof(float)); mix(&c.OffGroundTime, sizeof(float));
+        const uint8_t flags[3] = { (uint8_t)c.Grounded, (uint8_t)c.Invulnerable, (uint8_t)c.State };
+        mix(flags, sizeof(flags));
+    });
+    return h;
+}
+
+class ReplayApp : public madus::IApp {
+public:
+    InputRecording input;
+    std::vector<AABB2> colliders;
+    size_t agents = 200;
+    std::vector<double> frameMs;   // wall time between consecutive frames
+
+    void OnStartup() override {
+        Renderer_Init(nullptr);
+        Renderer_Shadow_Init(2048);
+        BuildTerrain(field);
+        terrain.Init(field);
+        box   = CreateBoxUnit();
+        white = CreateTexture2DWhite();
+        ground = CreateCheckerTexture(1024, 16, true);
+        shInst = Renderer_GetInstancedLitShader();
+
+        for (const AABB2& b : colliders) {
+            const Entity e = scene.Create();
+            scene.Add<CCollider>(e).Box = b;
+            CTransform& t = scene.Add<CTransform>(e);
+            t.Position = { 0.5f*(b.minx + b.maxx), 1.0f, 0.5f*(b.minz + b.maxz) };
+            t.Scale    = { b.maxx - b.minx, 3.0f, b.maxz - b.minz };
+            scene.Add<CWorldMatrix>(e);
+            scene.Add<CRenderMesh>(e, CRenderMesh{ &box, white, true });
+        }
+
+        uint32_t seed = 12345;
+        for (size_t i = 0; i <= agents; ++i) {   // entity 0 is the hero
+            const Entity e = scene.Create();
+            scene.Add<CTransform>(e).Scale = {0.8f, 1.5f, 0.8f};
+            scene.Add<CWorldMatrix>(e);
+            scene.Add<CRenderMesh>(e, CRenderMesh{ &box, white, true });
+            scene.Add<CControllerInput>(e);
+            CharacterController& c = scene.Add<CharacterController>(e);
+            c.Position = i ? Vec3{ Rng01(seed) * 50.f - 25.f, 0.f, Rng01(seed) * 50.f - 25.f } : Vec3{ 0.f, 0.f, 0.f };
+            c.Ground = &field;
+            c.Colliders = colliders.data();
+            c.ColliderCount = colliders.size();
+            if (!i) hero = e;
+        }
+        last = NowMs();
+    }
+
+    void OnShutdown() override {
+        terrain.Shutdown();
+        DestroyTexture(ground);
+        DestroyTexture(white);
+        DestroyMesh(box);
+        Renderer_Shutdown();
+    }
+
+    void OnUpdate(double) override {
+        const double now = NowMs();
+        frameMs.push_back(now - last);
+        last = now;
+    }
+
+    void OnFixedUpdate(double step) override {
+        size_t agent = 0;
+        scene.Each<CControllerInput>([&](Entity e, CControllerInput& ci){
+            if (e == hero) ci.In = input.At(tick, &ci.Active);
+            else ci.In = AgentInput(agent++, tick);
+            ci.CamFwd = camFwd;
+            ci.CamRight = camRight;
+        });
+        Scene_TickControllers(scene, (float)step);
+        ++tick;
+    }
+
+    void OnRecord(FramePacket& packet, double) override {
+        const Vec3 heroPos = scene.Get<CharacterController>(hero)->Position;
+        FrameParams fp{};
+        fp.CamPos = Add(heroPos, Add(Mul(camFwd, -12.0f), Vec3{0, 8.0f, 0}));
+        fp.View = LookAt(fp.CamPos, Add(heroPos, Vec3{0, 1.0f, 0}), Vec3{0, 1, 0});
+        fp.Proj = Perspective(65.f * (float)MADUS_PI / 180.f, (float)packet.Width / (float)std::max(1, packet.Height), 0.05f, 500.f);
+        fp.Sun.dir[0] = -0.35f; fp.Sun.dir[1] = -0.90f; fp.Sun.dir[2] = -0.20f;
+        const Vec3 sunDir = Normalize(Vec3{ fp.Sun.dir[0], fp.Sun.dir[1], fp.Sun.dir[2] });
+        fp.Sun.dir[0] = sunDir.x; fp.Sun.dir[1] = sunDir.y; fp.Sun.dir[2] = sunDir.z;
+
+        const Vec3 lightPos = Add(heroPos, Mul(sunDir, -30.0f));
+        packet.Params = fp;
+        packet.HasShadow = true;
+        packet.Shadow = ShadowMapInfo{ LookAt(lightPos, heroPos, {0,1,0}), Ortho(-18, 18, -18, 18, 0.1f, 80.0f), 2048 };
+
+        packet.ShadowPass.push_back({ [](void* ctx, const FramePacket& p){
+            static_cast<ReplayApp*>(ctx)->terrain.DrawShadow(p.Shadow, p.Params.CamPos);
+        }, this });
+        packet.MainPass.push_back({ [](void* ctx, const FramePacket& p){
+            ReplayApp* app = static_cast<ReplayApp*>(ctx);
+            app->terrain.Draw(p.Params, app->ground);
+        }, this });
+
+        Scene_UpdateWorldMatrices(scene);
+        Scene_RecordDraws(scene, shInst, packet);
+    }
+
+    uint64_t StateHash(){ return HashState(scene); }
+
+private:
+    Heightfield field;
+    TerrainRenderer terrain;
+    GpuMesh box{};
+    unsigned white = 0, ground = 0;
+    ShaderHandle shInst = 0;
+    EcsWorld scene;
+    Entity hero{};
+    uint64_t tick = 0;
+    double last = 0.0;
+    const Vec3 camFwd = Normalize(Vec3{0.57f, -0.57f, -0.57f});
+    const Vec3 camRight = Normalize(Cross(camFwd, Vec3{0, 1, 0}));
+};
+
+struct Results {
+    uint64_t Frames = 0;
+    double   P50 = 0, P95 = 0, P99 = 0, Mean = 0, Max = 0;
+    uint64_t Hash = 0;
+};
+
+static double Percentile(const std::vector<double>& sorted, double p){
+    if (sorted.empty()) return 0.0;
+    const size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+static bool WriteJson(const char* path, const Results& r, const std::vector<ProfZoneStats>& zones){
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) { std::fprintf(stderr, "cannot write '%s'\n", path); return false; }
+    std::fprintf(f, "{\n  \"frames\": %llu,\n", (unsigned long long)r.Frames);
+    std::fprintf(f, "  \"p50_ms\": %.4f,\n  \"p95_ms\": %.4f,\n  \"p99_ms\": %.4f,\n", r.P50, r.P95, r.P99);
+    std::fprintf(f, "  \"mean_ms\": %.4f,\n  \"max_ms\": %.4f,\n", r.Mean, r.Max);
+    std::fprintf(f, "  \"state_hash\": \"%016llx\",\n  \"zones\": [", (unsigned long long)r.Hash);
+    for (size_t i = 0; i < zones.size(); ++i)
+        std::fprintf(f, "%s\n    { \"name\": \"%s\", \"avg_ms\": %.4f, \"max_ms\": %.4f, \"calls\": %.2f }",
+                     i ? "," : "", zones[i].Name, zones[i].AvgMs, zones[i].MaxMs, zones[i].CallsPerFrame);
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+// Our own flat output: top-level keys only, found by name.
+static bool JsonNumber(const std::string& json, const char* key, double& out){
+    const std::string k = std::string("\"") + key + "\":";
+    const size_t at = json.find(k);
+    if (at == std::string::npos) return false;
+    out = std::strtod(json.c_str() + at + k.size(), nullptr);
+    return true;
+}
+
+static bool ReadBaseline(const char* path, Results& b){
+    std::string json;
+    if (!File_ReadAll(path, json)) { std::fprintf(stderr, "cannot read baseline '%s'\n", path); return false; }
+    double frames = 0;
+    const size_t h = json.find("\"state_hash\": \"");
+    if (!JsonNumber(json, "frames", frames) || !JsonNumber(json, "p50_ms", b.P50) || !JsonNumber(json, "p95_ms", b.P95)
+        || !JsonNumber(json, "p99_ms", b.P99) || h == std::string::npos) {
+        std::fprintf(stderr, "'%s' is not a MadusBenchReplay result\n", path);
+        return false;
+    }
+    b.Frames = (uint64_t)frames;
+    b.Hash = std::strtoull(json.c_str() + h + 15, nullptr, 16);
+    return true;
+}
+
+static bool Compare(const Results& r, const Results& b, double threshold){
+    bool ok = true;
+    std::printf("\nvs baseline (threshold %.1f%%)\n", threshold);
+    const struct { const char* Name; double Cur, Base; } rows[] = {
+        { "p50", r.P50, b.P50 }, { "p95", r.P95, b.P95 }, { "p99", r.P99, b.P99 },
+    };
+    for (const auto& row : rows) {
+        const double pct = row.Base > 0.0 ? (row.Cur / row.Base - 1.0) * 100.0 : 0.0;
+        const bool bad = pct > threshold;
+        std::printf("  %-4s %9.3f ms  base %9.3f ms  %+7.1f%%  %s\n", row.Name, row.Cur, row.Base, pct, bad ? "REGRESSION" : "ok");
+        ok &= !bad;
+    }
+    if (r.Frames != b.Frames) {
+        std::printf("  state hash not compared: %llu frames, baseline %llu\n", (unsigned long long)r.Frames, (unsigned long long)b.Frames);
+    } else if (r.Hash != b.Hash) {
+        std::printf("  state hash %016llx, baseline %016llx  DIVERGED\n", (unsigned long long)r.Hash, (unsigned long long)b.Hash);
+        ok = false;
+    } else {
+        std::printf("  state hash matches\n");
+    }
+    return ok;
+}
+
+int main(int argc, char** argv){
+    const char *inputPath = nullptr, *levelPath = nullptr, *outPath = nullptr, *basePath = nullptr, *saveInput = nullptr;
+    uint64_t frames = 0, warmup = 60;
+    double threshold = 10.0;
+    madus::EngineConfig cfg;
+    cfg.width = 1280; cfg.height = 720;
+    cfg.title = "MadusBenchReplay";
+    cfg.headless = true;
+    cfg.vsync = false;
+    ReplayApp app;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool more = i + 1 < argc;
+        if      (arg == "--input" && more)      inputPath = argv[++i];
+        else if (arg == "--level" && more)      levelPath = argv[++i];
+        else if (arg == "--frames" && more)     frames = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--warmup" && more)     warmup = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--agents" && more)     app.agents = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--size" && more)       std::sscanf(argv[++i], "%dx%d", &cfg.width, &cfg.height);
+        else if (arg == "--windowed")           cfg.headless = false;
+        else if (arg == "--out" && more)        outPath = argv[++i];
+        else if (arg == "--baseline" && more)   basePath = argv[++i];
+        else if (arg == "--threshold" && more)  threshold = std::strtod(argv[++i], nullptr);
+        else if (arg == "--save-input" && more) saveInput = argv[++i];
+        else {
+            std::fprintf(stderr, "usage: %s [--input f.minp] [--level f] [--frames N] [--warmup N] [--agents N] [--size WxH]\n"
+                                 "       [--windowed] [--out f.json] [--baseline f.json] [--threshold pct] [--save-input f.minp]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (inputPath) { if (!app.input.Load(inputPath)) return 1; }
+    else BuiltInPath(app.input, 1800);
+    if (saveInput && !app.input.Save(saveInput)) return 1;
+
+    Level level;
+    if (levelPath) {
+        const size_t n = std::strlen(levelPath);
+        const bool bin = n > 5 && std::strcmp(levelPath + n - 5, ".mlvl") == 0;
+        if (!(bin ? level.LoadBin(levelPath) : level.LoadTxt(levelPath))) return 1;
+        app.colliders.assign(level.Colliders().begin(), level.Colliders().end());
+    } else {
+        app.colliders = BuiltInLevel();
+    }
+
+    cfg.tickRate = app.input.TickRate;
+    cfg.fixedFrameDt = 1.0 / app.input.TickRate;
+    cfg.maxFrames = frames ? frames : app.input.TickCount;
+    app.frameMs.reserve((size_t)cfg.maxFrames);
+
+    Results r;
+    std::vector<ProfZoneStats> zones;
+    {
+        madus::Engine engine(cfg, &app);
+        if (engine.Run() != 0) return 1;
+        r.Hash = app.StateHash();
+        Profiler_GetZoneStats(zones);
+    }
+
+    // The first frame's interval includes startup; warm-up frames fill caches and pools.
+    std::vector<double> ms(app.frameMs.begin() + (ptrdiff_t)std::min<size_t>(app.frameMs.size(), std::max<uint64_t>(warmup, 1)),
+                           app.frameMs.end());
+    r.Frames = app.frameMs.size();
+    if (!ms.empty()) {
+        for (double v : ms) r.Mean += v;
+        r.Mean /= (double)ms.size();
+        std::sort(ms.begin(), ms.end());
+        r.P50 = Percentile(ms, 50); r.P95 = Percentile(ms, 95); r.P99 = Percentile(ms, 99);
+        r.Max = ms.back();
+    }
+
+    std::printf("frames=%llu (measured %zu) agents=%zu colliders=%zu ticks/s=%.0f %dx%d%s\n",
+                (unsigned long long)r.Frames, ms.size(), app.agents, app.colliders.size(), cfg.tickRate,
+                cfg.width, cfg.height, cfg.headless ? " headless" : "");
+    std::printf("  frame p50 %8.3f ms  p95 %8.3f ms  p99 %8.3f ms  mean %8.3f ms  max %8.3f ms\n", r.P50, r.P95, r.P99, r.Mean, r.Max);
+    std::printf("  state hash %016llx\n", (unsigned long long)r.Hash);
+    std::printf("  zones over the last %d frames:\n", PROFILER_WINDOW_FRAMES);
+    for (const ProfZoneStats& z : zones)
+        std::printf("    %-32s %8.3f ms avg %8.3f ms max %8.1f calls\n", z.Name, z.AvgMs, z.MaxMs, z.CallsPerFrame);
+
+    if (outPath && !WriteJson(outPath, r, zones)) return 1;
+    if (basePath) {
+        Results b;
+        if (!ReadBaseline(basePath, b)) return 1;
+        return Compare(r, b, threshold) ? 0 : 1;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+// Transform hierarchy benchmark: N characters, each a root with a chain of
+// bones plus socket attachments. Per frame a fraction of the roots move.
+// Times TransformHierarchy::Update (dirty subtrees only) against recomputing
+// every world matrix from scratch, and checks both give the same matrices.
+//
+// usage: MadusBenchTransforms [characters=2000] [nodesPerChar=32] [moving%=10] [frames=200]
+
+#include "Madus/Transform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static double NowMs(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+static uint32_t Rng(uint32_t& s){ s = s * 1664525u + 1013904223u; return s >> 8; }
+static float    Rng01(uint32_t& s){ return (float)(Rng(s) & 0xFFFF) / 65535.f; }
+
+int main(int argc, char** argv){
+    const int chars   = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const int perChar = argc > 2 ? std::atoi(argv[2]) : 32;
+    const int moving  = argc > 3 ? std::atoi(argv[3]) : 10;
+    const int frames  = argc > 4 ? std::atoi(argv[4]) : 200;
+
+    TransformHierarchy h;
+    std::vector<uint32_t> nodes, parentIdx, roots;   // parentIdx indexes nodes, ~0u for roots
+    std::vector<Vec3> pos; std::vector<Quat> rot;
+    uint32_t seed = 1;
+    const int chain = std::max(1, perChar / 2);
+    for (int c = 0; c < chars; ++c) {
+        const uint32_t base = (uint32_t)nodes.size();
+        roots.push_back(base);
+        for (int k = 0; k < perChar; ++k) {
+            // first half a bone chain, the rest sockets hung off random bones
+            uint32_t p = ~0u;
+            if (k > 0) p = k < chain ? base + k - 1 : base + Rng(seed) % (uint32_t)chain;
+            const Vec3 lp{ Rng01(seed) - 0.5f, 0.2f, Rng01(seed) - 0.5f };
+            const Quat lr = AngleAxis(Rng01(seed) * 0.5f, {0, 1, 0});
+            const uint32_t n = h.Create(p == ~0u ? TransformHierarchy::None : nodes[p]);
+            h.SetLocal(n, lp, lr, {1, 1, 1});
+            nodes.push_back(n); parentIdx.push_back(p); pos.push_back(lp); rot.push_back(lr);
+        }
+    }
+    h.Update();
+
+    // Reference: every world matrix recomputed from scratch (parents come first).
+    std::vector<Mat4> refWorld(nodes.size());
+    auto fullRecompute = [&]{
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const Mat4 local = TRS(pos[i], rot[i], {1, 1, 1});
+            refWorld[i] = parentIdx[i] == ~0u ? local : MulM(refWorld[parentIdx[i]], local);
+        }
+    };
+
+    double tInc = 0, tFull = 0;
+    uint64_t recomputed = 0;
+    const int movers = std::max(1, chars * moving / 100);
+    for (int f = 0; f < frames; ++f) {
+        for (int m = 0; m < movers; ++m) {
+            const uint32_t r = roots[Rng(seed) % roots.size()];
+            pos[r] = { pos[r].x + 0.01f, pos[r].y, pos[r].z };
+            h.SetLocalPosition(nodes[r], pos[r]);
+        }
+        double t0 = NowMs();
+        h.Update();
+        tInc += NowMs() - t0;
+        recomputed += h.LastRecomputed;
+
+        t0 = NowMs();
+        fullRecompute();
+        tFull += NowMs() - t0;
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < nodes.size(); ++i)
+        if (std::memcmp(&refWorld[i], &h.World(nodes[i]), sizeof(Mat4)) != 0) ++mismatches;
+
+    std::printf("\nnodes %zu (%d chars x %d), %d%% roots moving, %d frames\n", nodes.size(), chars, perChar, moving, frames);
+    std::printf("  full recompute   %8.3f ms/frame\n", tFull / frames);
+    std::printf("  dirty Update     %8.3f ms/frame  (%.0f nodes/frame, %.1fx)\n", tInc / frames, (double)recomputed / frames, tFull / tInc);
+    std::printf("  world matrices %s\n", mismatches ? "MISMATCH" : "identical");
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Heap allocation checker for the frame loop, built in with the CMake option
+// MADUS_ALLOC_TRACKING (off by default; every call below is then an empty
+// inline and no allocator is replaced).
+//
+// When built in, global operator new/delete are replaced and, on glibc, so
+// are malloc/calloc/realloc/free and the aligned variants. Every allocation
+// is counted against the calling thread's current tag (AllocTag, "untagged"
+// outside any) and the current frame. Engine::Run arms the checker once
+// EngineConfig::allocWarmupFrames frames have run and keeps it armed, on
+// every thread, until the loop ends. Each allocation while armed is a
+// violation: its call stack is captured and grouped by call site, unless the
+// innermost tag was opened with allowed = true (the OS event queue), or the
+// allocation comes from outside our own modules. The GL driver allocates as
+// it pleases wherever it is called from: past libc/libstdc++, a stack whose
+// innermost frame is in a module other than the engine's and the
+// executable's is counted as a driver allocation instead
+// (AllocTracker_DriverAllocs; not classified on Windows).
+//
+// AllocTracker_Report prints the per-tag totals and every violating call
+// site; Engine::Run does so on exit and fails with a non-zero return if
+// the violations exceed EngineConfig::allocBudget. Symbols need -rdynamic,
+// which the option adds on GCC/Clang; otherwise pipe addresses to addr2line.
+
+#if MADUS_ALLOC_TRACKING
+
+struct AllocTag {
+    explicit AllocTag(const char* name, bool allowed = false);   // name must outlive the program (a literal)
+    ~AllocTag();
+    AllocTag(const AllocTag&) = delete;
+    AllocTag& operator=(const AllocTag&) = delete;
+
+private:
+    const char* m_PrevName;
+    bool        m_PrevAllowed;
+};
+
+void     AllocTracker_SetFrame(uint64_t frame, bool armed);   // called by the engine at the top of each frame
+uint64_t AllocTracker_Violations();                           // allocations flagged so far
+uint64_t AllocTracker_DriverAllocs();                         // steady-state allocations made by other modules
+void     AllocTracker_Report(FILE* out);
+void     AllocTracker_Reset();                                 // forget counts and call sites
+
+#else
+
+struct AllocTag {
+    explicit AllocTag(const char*, bool = false) {}
+};
+
+inline void     AllocTracker_SetFrame(uint64_t, bool) {}
+inline uint64_t AllocTracker_Violations() { return 0; }
+inline uint64_t AllocTracker_DriverAllocs() { return 0; }
+inline void     AllocTracker_Report(FILE*) {}
+inline void     AllocTracker_Reset() {}
+
+#endif
+
+#define MADUS_ALLOC_CONCAT2(a, b) a##b
+#define MADUS_ALLOC_CONCAT(a, b)  MADUS_ALLOC_CONCAT2(a, b)
+// Tags the rest of the scope: MADUS_ALLOC_TAG("Physics");
+#define MADUS_ALLOC_TAG(name)   AllocTag MADUS_ALLOC_CONCAT(madusAllocTag_, __LINE__)(name)
+// Same, but allocations in it are counted without being flagged.
+#define MADUS_ALLOC_ALLOW(name) AllocTag MADUS_ALLOC_CONCAT(madusAllocTag_, __LINE__)(name, true)
@@ -2,13 +2,37 @@
 
 #pragma once
 
+struct FramePacket;
+
 namespace madus {
+class Engine;
+
+// Per frame the engine calls: OnUpdate(frameDt) once, OnFixedUpdate(step)
+// zero or more times at EngineConfig::tickRate, then OnRecord(packet, alpha)
+// where alpha in [0,1) blends the previous and the current simulation tick.
+// The packet is drawn by the render thread while the next frame simulates,
+// so OnRecord must not call GL.
+//
+// OnRender(alpha) is for immediate GL on the main thread, drawn over the
+// packet. It is only called with EngineConfig::renderThread off.
+//
+// Per-frame temporaries belong in Engine::GetFrameArena() (reset after
+// OnRecord/OnRender), job-local ones in Memory_Scratch(), so a steady-state
+// frame doesn't touch the heap.
 class IApp {
 public:
     virtual ~IApp() = default;
     virtual void OnStartup() {}
     virtual void OnShutdown() {}
     virtual void OnUpdate(double) {}
-    virtual void OnRender() {}
+    virtual void OnFixedUpdate(double) {}
+    virtual void OnRecord(FramePacket&, double) {}
+    virtual void OnRender(double) {}
+
+    Engine& GetEngine() const { return *m_Engine; }
+
+private:
+    friend class Engine;
+    Engine* m_Engine = nullptr;
 };
 } 
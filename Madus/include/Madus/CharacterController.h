@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include "Madus/Math.h"
 #include "Madus/Input.h"
+#include "Madus/Heightfield.h"
 
 // Basic locomotion states
 enum class EPlayerState { Idle, Move, Jump, Fall, Dash };
@@ -41,13 +43,18 @@ struct CharacterController {
     // Capsule & ground
     float CapsuleRadius     = 0.35f;
     float CapsuleHalfHeight = 0.90f;
-    float GroundY           = 0.0f; 
+    float GroundY           = 0.0f;   // flat ground when no heightfield is set
 
     // Walking constraints
     float StepOffset   = 0.40f;     
     float MaxSlopeDeg  = 40.0f;      
     float GroundSnap   = 0.02f;      
 
+    // Level colliders (not owned). Horizontal motion is swept against them,
+    // so a dash can't skip through a wall in one tick.
+    const AABB2* Colliders     = nullptr;
+    size_t       ColliderCount = 0;
+    int          SlideIterations = 3;
 
     EPlayerState State = EPlayerState::Idle;
     float OnGroundTime = 0.f;    
@@ -73,9 +80,6 @@ struct CharacterController {
 
     void Tick(const InputState& in, float dt, const Vec3& camFwd, const Vec3& camRight);
 
-    using GroundHeightFn = float(*)(float x, float z);
-    using GroundNormalFn = Vec3 (*)(float x, float z);
-
-    GroundHeightFn GroundHeight = nullptr; 
-    GroundNormalFn GroundNormal = nullptr; 
+    // Terrain (not owned). Sampled directly; null means flat ground at GroundY.
+    const Heightfield* Ground = nullptr;
 };
@@ -0,0 +1,55 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Madus/CharacterController.h"
+
+// Structure-of-arrays version of CharacterController for crowds. Runs the
+// same locomotion model as CharacterController::Tick (bit-identical results
+// for pose, velocity, timers and state) but in phases over dense arrays, so
+// timers, gravity, acceleration and friction compile to branch-free loops.
+// Visual-only fields (VisualYaw, BobT, LastSpeed, AccelMag) are not simulated.
+// Terrain comes from Archetype.Ground and is sampled in batches per phase.
+struct CharacterPool {
+    // Tuning and colliders for every agent; its own pose/state is ignored.
+    CharacterController Archetype;
+
+    // Simulation state
+    std::vector<float>   PosX, PosY, PosZ;
+    std::vector<float>   VelX, VelY, VelZ;
+    std::vector<float>   OnGroundTime, OffGroundTime;
+    std::vector<float>   DashTimer, DashCDTimer;
+    std::vector<float>   JumpBuf, DashBuf;
+    std::vector<uint8_t> Grounded, Invulnerable, State;
+
+    // Per-tick input, already in world space (see SetInput)
+    std::vector<float>   WishX, WishZ, WishLen;
+    std::vector<float>   FwdX, FwdZ;
+    std::vector<uint8_t> DashIn, JumpIn;
+
+    size_t Size() const { return PosX.size(); }
+    void   Reserve(size_t n);
+    void   Clear();
+
+    // Appends an agent with the pose/state of 'from'. Returns its index.
+    size_t Spawn(const CharacterController& from);
+
+    // Same camera-relative wish direction the scalar Tick derives.
+    void SetInput(size_t i, const InputState& in, const Vec3& camFwd, const Vec3& camRight);
+
+    // Writes agent i's pose/state back into a scalar controller.
+    void CopyTo(size_t i, CharacterController& out) const;
+
+    // workers <= 1 ticks on the calling thread; otherwise splits into ranges.
+    void Tick(float dt, int workers = 1);
+    void TickRange(size_t begin, size_t end, float dt);
+
+private:
+    // Per-tick scratch
+    std::vector<uint8_t> Mode;     // 0 dashing, 1 dash started, 2 locomotion
+    std::vector<float>   GroundH, GroundNX, GroundNY, GroundNZ;
+    std::vector<float>   PreX, PreZ;
+};
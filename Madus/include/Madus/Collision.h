@@ -0,0 +1,31 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include "Madus/Math.h"
+
+// Level colliders are infinite-height boxes on XZ, so a vertical capsule
+// against them reduces to its circle of CapsuleRadius.
+
+// Discrete pushout of a circle out of one box. Removes the velocity component
+// into the box. Returns true if the circle was touching it.
+bool ResolveCircleAABB2(Vec3& pos, Vec3& vel, float radius, const AABB2& b);
+
+struct SweepHit {
+    float t = 1.f;        // fraction of the move in [0,1]
+    float nx = 0.f, nz = 0.f;
+    int   index = -1;     // collider index, -1 = no hit
+};
+
+// Time of impact of a circle at pos moving by (dx,dz) against one box
+// (ray vs. the box rounded by radius). Starting overlaps only count as a
+// hit at t=0 when moving further in.
+bool SweepCircleAABB2(const Vec3& pos, float dx, float dz, float radius, const AABB2& b, SweepHit& hit);
+
+// Moves pos by vel*dt on XZ, sliding along the first surface hit up to
+// 'iterations' times (at least once); whatever move is left after the last
+// slide is taken up to the next contact. Then depenetrates. Y is left to the
+// caller.
+void MoveAndSlideXZ(Vec3& pos, Vec3& vel, float dt, float radius,
+                    const AABB2* colliders, size_t count, int iterations, float skin = 1e-3f);
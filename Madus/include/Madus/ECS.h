@@ -0,0 +1,148 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#include "Madus/Memory.h"
+#include "Madus/Parallel.h"
+
+// Archetype ECS. Entities with the same component set share an archetype,
+// whose rows live in fixed-size chunks holding one contiguous array per
+// component (SoA), so a query walks dense arrays chunk by chunk. Components
+// are plain data (trivially copyable) and move between archetypes by memcpy.
+//
+// Structural changes (Create/Destroy/Add/Remove) invalidate component
+// pointers and must not happen inside Each/EachChunk/ParallelEach.
+
+using ComponentId = uint32_t;
+constexpr uint32_t ECS_MAX_COMPONENTS = 64;
+constexpr size_t   ECS_CHUNK_BYTES    = 16 * 1024;
+
+ComponentId Ecs_RegisterComponent(size_t size, size_t align, const char* name);
+size_t      Ecs_ComponentSize(ComponentId id);
+size_t      Ecs_ComponentAlign(ComponentId id);
+
+template<class T>
+ComponentId Ecs_Id(){
+    static_assert(std::is_trivially_copyable_v<T>, "ECS components must be plain data");
+    static const ComponentId id = Ecs_RegisterComponent(sizeof(T), alignof(T), typeid(T).name());
+    return id;
+}
+
+template<class... Ts>
+uint64_t Ecs_Mask(){ return (0ull | ... | (1ull << Ecs_Id<Ts>())); }
+
+struct Entity {
+    uint32_t Index = ~0u;
+    uint32_t Gen = 0;
+    bool operator==(const Entity& o) const { return Index == o.Index && Gen == o.Gen; }
+    bool operator!=(const Entity& o) const { return !(*this == o); }
+};
+
+struct EcsChunk {
+    unsigned char* Data = nullptr;   // ECS_CHUNK_BYTES (or one oversized row), 64-byte aligned
+    uint32_t Count = 0;
+};
+
+struct EcsArchetype {
+    uint64_t Mask = 0;
+    std::vector<ComponentId> Types;      // ascending
+    std::vector<uint32_t>    Offsets;    // byte offset of each type's array in a chunk
+    std::vector<uint32_t>    Sizes;      // sizeof each type
+    int8_t   ColumnOf[ECS_MAX_COMPONENTS];
+    uint32_t Capacity = 0;               // rows per chunk; Entity array sits at offset 0
+    size_t   ChunkBytes = 0;
+    std::vector<EcsChunk> Chunks;        // all full except the last
+
+    template<class T> T* Column(const EcsChunk& c) const {
+        return reinterpret_cast<T*>(c.Data + Offsets[ColumnOf[Ecs_Id<T>()]]);
+    }
+    Entity* Entities(const EcsChunk& c) const { return reinterpret_cast<Entity*>(c.Data); }
+};
+
+struct EcsWorld {
+    EcsWorld();
+    ~EcsWorld();
+    EcsWorld(const EcsWorld&) = delete;
+    EcsWorld& operator=(const EcsWorld&) = delete;
+
+    Entity Create();
+    void   Destroy(Entity e);
+    bool   IsAlive(Entity e) const { return e.Index < m_Records.size() && m_Records[e.Index].Gen == e.Gen && m_Records[e.Index].Arch; }
+    size_t Count() const { return m_Alive; }
+    void   Clear();
+
+    template<class T> T& Add(Entity e, const T& value = T{}){
+        assert(IsAlive(e));
+        const ComponentId id = Ecs_Id<T>();
+        if (!(m_Records[e.Index].Arch->Mask & (1ull << id))) MoveTo(e, m_Records[e.Index].Arch->Mask | (1ull << id));
+        T* p = static_cast<T*>(Ptr(e, id));
+        return *::new (p) T(value);
+    }
+    template<class T> void Remove(Entity e){
+        const ComponentId id = Ecs_Id<T>();
+        if (m_Records[e.Index].Arch->Mask & (1ull << id)) MoveTo(e, m_Records[e.Index].Arch->Mask & ~(1ull << id));
+    }
+    template<class T> bool Has(Entity e) const { return IsAlive(e) && (m_Records[e.Index].Arch->Mask & (1ull << Ecs_Id<T>())); }
+    template<class T> T* Get(Entity e){ return Has<T>(e) ? static_cast<T*>(Ptr(e, Ecs_Id<T>())) : nullptr; }
+
+    // fn(size_t n, const Entity* entities, Ts*... columns) once per matching chunk.
+    template<class... Ts, class Fn> void EachChunk(Fn&& fn){
+        for (EcsArchetype* a : Match(Ecs_Mask<Ts...>()))
+            for (EcsChunk& c : a->Chunks)
+                if (c.Count) fn((size_t)c.Count, (const Entity*)a->Entities(c), a->template Column<Ts>(c)...);
+    }
+    // fn(Entity, Ts&...) per matching entity.
+    template<class... Ts, class Fn> void Each(Fn&& fn){
+        EachChunk<Ts...>([&](size_t n, const Entity* es, Ts*... cols){
+            for (size_t i = 0; i < n; ++i) fn(es[i], cols[i]...);
+        });
+    }
+    // Each() with chunks spread over worker threads. fn must only touch its own row.
+    template<class... Ts, class Fn> void ParallelEach(Fn&& fn, int workers = 0){
+        ArenaScope scratch(Memory_Scratch());
+        std::pmr::vector<std::pair<EcsArchetype*, EcsChunk*>> work(scratch.Resource());
+        for (EcsArchetype* a : Match(Ecs_Mask<Ts...>()))
+            for (EcsChunk& c : a->Chunks) if (c.Count) work.push_back({ a, &c });
+        ParallelFor(work.size(), 1, [&](size_t b, size_t e){
+            for (size_t w = b; w < e; ++w) {
+                EcsArchetype* a = work[w].first; EcsChunk& c = *work[w].second;
+                const Entity* es = a->Entities(c);
+                auto run = [&](Ts*... cols){ for (uint32_t i = 0; i < c.Count; ++i) fn(es[i], cols[i]...); };
+                run(a->template Column<Ts>(c)...);
+            }
+        }, workers);
+    }
+
+    size_t ArchetypeCount() const { return m_Archetypes.size(); }
+
+private:
+    struct Record { EcsArchetype* Arch = nullptr; uint32_t Chunk = 0, Row = 0, Gen = 0; };
+    struct QueryCache { size_t Seen = 0; std::vector<EcsArchetype*> Archetypes; };
+
+    std::vector<Record> m_Records;
+    std::vector<uint32_t> m_Free;
+    size_t m_Alive = 0;
+    std::vector<std::unique_ptr<EcsArchetype>> m_Archetypes;
+    std::unordered_map<uint64_t, EcsArchetype*> m_ByMask;
+    std::unordered_map<uint64_t, QueryCache> m_Queries;
+    FixedPool m_ChunkPool;   // ECS_CHUNK_BYTES chunks, reused as archetypes fill and drain
+
+    EcsArchetype* GetArchetype(uint64_t mask);
+    const std::vector<EcsArchetype*>& Match(uint64_t required);
+    void  MoveTo(Entity e, uint64_t newMask);
+    void  AllocRow(EcsArchetype& a, uint32_t& chunk, uint32_t& row);
+    void  FreeRow(EcsArchetype& a, uint32_t chunk, uint32_t row);
+    unsigned char* AllocChunk(const EcsArchetype& a);
+    void  FreeChunk(const EcsArchetype& a, unsigned char* data);
+    void* Ptr(Entity e, ComponentId id) const;
+};
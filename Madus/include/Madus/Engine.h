@@ -3,6 +3,10 @@
 #pragma once
 
 #include <cstdint>
+#include "Madus/FixedStep.h"
+#include "Madus/FramePacer.h"
+#include "Madus/Memory.h"
+#include "Madus/RenderThread.h"
 
 struct GLFWwindow;
 namespace madus { class IApp; }
@@ -14,6 +18,52 @@ struct EngineConfig {
     int height = 720;
     const char* title = "Madus Sandbox";
     bool vsync = true;
+
+    // No window, no input: an EGL context (Headless.h) renders into a
+    // width x height framebuffer with vsync off. Set maxFrames, or Run()
+    // only returns when killed.
+    bool headless = false;
+
+    // Fixed-step simulation
+    double tickRate    = 60.0;  // OnFixedUpdate calls per second
+    int    maxSubsteps = 8;     // cap per frame; excess time is dropped
+    double maxFrameDt  = 0.25;  // clamp for hitches (breakpoints, window drags)
+    // > 0: every frame advances exactly this, whatever the wall clock took, so
+    // a run of N frames simulates the same ticks every time (replays, benchmarks).
+    double fixedFrameDt = 0.0;
+
+    // Frame pacing (FramePacer.h): at most targetFps frames per second, 0 =
+    // unpaced. justInTimeFrames starts each frame as late as its deadline
+    // allows, leaving jitSafetyMs for variance, so input is sampled just
+    // before submit instead of a whole frame earlier.
+    double targetFps        = 0.0;
+    bool   justInTimeFrames = false;
+    double jitSafetyMs      = 1.5;
+
+    // Job system (Jobs.h): background worker threads; -1 = hardware threads - 1
+    int jobWorkers = -1;
+
+    // Pipelined rendering: a GL thread draws frame N while frame N+1 simulates.
+    // maxFramesInFlight is the latency cap (1 = double buffered, 2 = triple).
+    bool renderThread      = true;
+    int  maxFramesInFlight = 1;
+
+    // Frame arena: initial size; it grows to the busiest frame's high-water mark.
+    size_t frameArenaBytes = 1 << 20;
+
+    // Stop Run() after this many frames (0 = until the window closes).
+    uint64_t maxFrames = 0;
+
+    // Builds with MADUS_ALLOC_TRACKING (AllocTracker.h): frames after the
+    // warm-up must not allocate; Run() fails if more than allocBudget do.
+    int      allocWarmupFrames = 300;
+    uint64_t allocBudget       = 0;
+
+    // Resource memory budgets in bytes (ResourceMemory.h), 0 = none. Going
+    // over one logs a warning; nothing is refused.
+    size_t gpuMemoryBudget     = 0;   // textures + buffers + render targets
+    size_t textureMemoryBudget = 0;   // textures alone, render targets excluded
+    size_t cpuAssetBudget      = 0;
 };
 
 class Engine {
@@ -21,18 +71,55 @@ public:
     explicit Engine(const EngineConfig& cfg = {}, IApp* app = nullptr);
     ~Engine();
 
-    int Run();
+    int Run();   // nonzero if platform init failed or the allocation budget was exceeded
+
+    GLFWwindow* GetWindow() const { return m->Window; }   // null when headless
+    bool IsHeadless() const { return m->Headless != nullptr; }
+    void GetFramebufferSize(int& w, int& h) const;
+    double   GetFixedStep() const { return m_Clock.Step; }
+    uint64_t GetTickCount() const { return m_Clock.TickCount; }
+    // During OnFixedUpdate: when this frame's events were pumped (Input_Now()
+    // clock), i.e. up to which the tick should see input events.
+    double   GetTickTime() const { return m_TickTime; }
+    RenderThread::Stats GetRenderStats() const { return m->Render.GetStats(); }
+    FramePacerStats GetPacerStats() const { return m_Pacer.GetStats(); }
+
+    // Main-thread bump allocator, reset after every frame's OnRecord. For
+    // temporaries of the IApp callbacks; nothing in it may be kept in the
+    // FramePacket or past the frame. GetFrameResource() for std::pmr containers.
+    LinearArena& GetFrameArena() { return m->FrameArena; }
+    std::pmr::memory_resource* GetFrameResource() { return m->FrameArena.Resource(); }
 
 private:
     bool InitPlatform(const EngineConfig& cfg);
     void ShutdownPlatform();
     void PumpEvents(bool& shouldClose);
     void Update(double dt);
-    void Render();
+    void FixedUpdate(double step);
+    void Render(double alpha);
 
     double m_LastTime = 0.0;
+    double m_MaxFrameDt = 0.25;
+    double m_FixedFrameDt = 0.0;
+    double m_TickTime = 0.0;
+    FixedStepClock m_Clock;
+    FramePacer m_Pacer;
+    uint64_t m_Frame = 0;
+    bool m_UseRenderThread = true;
+    int  m_MaxFramesInFlight = 1;
+    uint64_t m_MaxFrames = 0;
+    uint64_t m_AllocWarmup = 0, m_AllocBudget = 0;
 
-    struct Impl { GLFWwindow* Window = nullptr; };
+    struct Impl {
+        explicit Impl(size_t frameArenaBytes) : FrameArena(frameArenaBytes) {}
+        GLFWwindow*  Window = nullptr;
+        HeadlessContext* Headless = nullptr;
+        RenderThread Render;
+        FramePacket  Packet;   // recorded and drawn inline without the render thread
+        StreamBuffer Stream;   // its instance regions
+        LinearArena  FrameArena;
+        bool         InitFailed = false;   // InitPlatform failed; Run() returns 1
+    };
     Impl* m = nullptr;
 
     IApp* m_App = nullptr;
@@ -0,0 +1,36 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+// Read-only memory mapping of a whole file. The view stays valid until
+// Close() or destruction; move-only.
+struct MappedFile {
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(MappedFile&& o) noexcept { *this = std::move(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+
+    const unsigned char* Data() const { return m_Data; }
+    size_t Size() const { return m_Size; }
+    bool   IsOpen() const { return m_Data != nullptr; }
+
+private:
+    const unsigned char* m_Data = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+};
+
+// Whole-file read in one call (size query + single read, no per-line I/O).
+bool File_ReadAll(const char* path, std::string& out);
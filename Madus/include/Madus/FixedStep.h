@@ -0,0 +1,46 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace madus {
+
+// Accumulator-based fixed-step scheduler. Frame time goes in, a whole number
+// of simulation ticks comes out; the leftover fraction is the render alpha.
+struct FixedStepClock {
+    double   Step        = 1.0 / 60.0; // seconds per tick
+    int      MaxSubsteps = 8;          // spiral-of-death guard
+    double   Accumulator = 0.0;
+    uint64_t TickCount   = 0;
+    double   DroppedTime = 0.0;        // sim time discarded by the guard
+
+    void SetRate(double hz){ if (hz > 0.0) Step = 1.0 / hz; }
+
+    // Returns how many ticks of Step to run for this frame.
+    int Advance(double frameDt){
+        if (!(frameDt > 0.0)) frameDt = 0.0;
+        Accumulator += frameDt;
+
+        int steps = (int)(Accumulator / Step);
+        if (MaxSubsteps > 0 && steps > MaxSubsteps) steps = MaxSubsteps;
+        Accumulator -= steps * Step;
+
+        // Still behind after the cap: drop whole ticks instead of trying to catch up.
+        if (Accumulator >= Step){
+            const double keep = std::fmod(Accumulator, Step);
+            DroppedTime += Accumulator - keep;
+            Accumulator = keep;
+        }
+        TickCount += (uint64_t)steps;
+        return steps;
+    }
+
+    // Interpolation factor in [0,1) between the previous and the current tick.
+    double Alpha() const { return Accumulator / Step; }
+
+    void Reset(){ Accumulator = 0.0; TickCount = 0; DroppedTime = 0.0; }
+};
+
+} // namespace madus
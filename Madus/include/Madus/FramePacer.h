@@ -0,0 +1,79 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+
+namespace madus {
+
+// Frame limiter for Engine::Run (EngineConfig::targetFps). Frame k has a
+// deadline D(k) = D(k-1) + 1/targetFps, the moment its packet should be
+// submitted; the pacer holds the next frame back until its start time:
+//
+//   limiter:        start at D(k-1), so frames are spaced by the period
+//   just-in-time:   start at D(k) - predicted work - safety margin, so
+//                   events are pumped, input sampled and the simulation
+//                   run as late as still meets the deadline
+//
+// The prediction is mean + 2 sigma of recent start-to-submit times, capped
+// at the period. A frame that submits past its deadline counts as missed and
+// the schedule restarts from it instead of bunching frames to catch up.
+//
+// Waits sleep to within a margin of the target, then spin. The margin
+// follows the observed oversleep, so the pacer spins only as long as the OS
+// scheduler needs; on Windows the timer is raised to 1 ms while pacing.
+//
+// Stats cover the last FRAME_PACER_WINDOW frames. InputLatencyMs is input
+// sample to deadline: what pacing adds before the frame can be shown. GPU
+// and display time after submit come on top (RenderThread::Stats). Pair a
+// target at the display rate with vsync, or use it alone with vsync off.
+
+constexpr int FRAME_PACER_WINDOW = 120;
+
+struct FramePacerStats {
+    double   TargetMs        = 0.0;   // 0 = unpaced
+    bool     JustInTime      = false;
+    double   FrameMs         = 0.0;   // start-to-start interval: mean, stddev, max
+    double   FrameStdDevMs   = 0.0;
+    double   FrameMaxMs      = 0.0;
+    double   WorkMs          = 0.0;   // frame start to submit, mean
+    double   WaitMs          = 0.0;   // held back by the pacer, mean
+    double   InputLatencyMs  = 0.0;   // input sample to deadline (to submit when unpaced), mean
+    double   SpinMarginMs    = 0.0;
+    uint64_t Frames          = 0;
+    uint64_t Missed          = 0;     // submitted past the deadline, since Configure
+};
+
+class FramePacer {
+public:
+    FramePacer() = default;
+    ~FramePacer();
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // targetFps <= 0 turns pacing off; stats are still collected.
+    void Configure(double targetFps, bool justInTime, double safetyMs);
+    bool IsPacing() const { return m_Period > 0.0; }
+
+    // Times are seconds on the engine clock (Input_Now()).
+    void BeginFrame(double now);        // blocks until the frame may start
+    void InputSampled(double when);     // right after the event pump
+    void EndFrame(double submitted);    // after the packet is submitted
+
+    FramePacerStats GetStats() const;
+
+private:
+    void WaitUntil(double t);
+
+    double m_Period = 0.0, m_Safety = 0.0;
+    bool   m_JustInTime = false, m_TimerRaised = false;
+    double m_Deadline = 0.0;       // this frame's
+    double m_Start = 0.0, m_PrevStart = 0.0, m_Sampled = 0.0, m_Waited = 0.0;
+    double m_SpinMargin = 0.002, m_Oversleep = 0.0;
+    uint64_t m_Frames = 0, m_Missed = 0;
+
+    struct Sample { float IntervalMs, WorkMs, WaitMs, LatencyMs; };
+    Sample m_Window[FRAME_PACER_WINDOW] = {};
+};
+
+} // namespace madus
@@ -0,0 +1,131 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Madus/Math.h"
+#include "Madus/Mesh.h"
+#include "Madus/Renderer.h"
+#include "Madus/Shader.h"
+#include "Madus/StreamBuffer.h"
+
+// Everything the GL thread needs to draw one frame, recorded by the app on the
+// main thread (IApp::OnRecord) and never touched by it again once submitted.
+// Items are copied in by value, so the simulation is free to move on; meshes,
+// shaders and textures are GL objects that outlive the frame.
+struct FramePacket;
+
+struct DrawItem {
+    const GpuMesh* Mesh = nullptr;
+    ShaderHandle   Shader = 0;
+    unsigned       Albedo = 0;
+    Mat4           Model;
+};
+
+struct ShadowItem {
+    const GpuMesh* Mesh = nullptr;
+    Mat4           Model;
+};
+
+// GL work that isn't a mesh draw (terrain, debug overlays). Runs on the GL
+// thread; ctx must stay valid and its GL-side state must only be used there.
+struct PacketCallback {
+    void (*Fn)(void* ctx, const FramePacket& packet) = nullptr;
+    void* Ctx = nullptr;
+};
+
+// Instanced draws recorded by one job thread (FramePacket::ThreadList), so
+// many workers can record a frame at once without sharing anything. Close()
+// sorts the list by state, writes the model matrices in that order into a
+// range it allocates from the packet's instance region, and leaves one command
+// per run of identical state. The GL thread merges and sorts the commands of
+// every list and issues one glDrawElementsInstanced per command.
+struct DrawList {
+    enum : uint8_t { Main = 1, Shadow = 2 };   // passes an instance is drawn in
+
+    struct Command {
+        uint64_t       Key = 0;
+        const GpuMesh* Mesh = nullptr;
+        ShaderHandle   Shader = 0;   // must read the model from attributes 3-6 (Renderer_GetInstancedLitShader)
+        unsigned       Albedo = 0;
+        uint8_t        Passes = 0;
+        uint32_t       First = 0, Count = 0;   // instances, in the instance region's buffer or in Spill
+    };
+
+    void Add(const GpuMesh& mesh, ShaderHandle sh, unsigned albedo, const Mat4& model, uint8_t passes = Main | Shadow);
+    size_t Size() const { return m_Items.size(); }
+    void   Clear();
+    void   Close(FramePacket& packet);
+
+    std::vector<Command> Commands;   // valid after Close
+    bool   Spilled = false;          // instance region was full: matrices are in Spill instead
+    std::vector<Mat4> Spill;
+
+private:
+    struct Item { uint64_t Key; const GpuMesh* Mesh; ShaderHandle Shader; unsigned Albedo; uint8_t Passes; uint32_t Model; };
+    std::vector<Item> m_Items;
+    std::vector<Mat4> m_Models;
+};
+
+struct FramePacket {
+    FramePacket() = default;
+    FramePacket(const FramePacket&) = delete;
+    FramePacket& operator=(const FramePacket&) = delete;
+
+    uint64_t Frame = 0;
+    int Width = 0, Height = 0;           // framebuffer size, filled by the engine
+
+    FrameParams Params;
+    bool Sky = true;
+
+    bool HasShadow = false;
+    ShadowMapInfo Shadow;
+    std::vector<ShadowItem>     ShadowCasters;
+    std::vector<PacketCallback> ShadowPass;  // after ShadowCasters, inside the shadow pass
+
+    std::vector<DrawItem>       Draws;
+    std::vector<PacketCallback> MainPass;    // after the sky, before Draws
+
+    // One DrawList per job thread; recorders only touch their own.
+    std::vector<DrawList> Lists;
+    DrawList& ThreadList();
+
+    // Objects the recorder culled, for RenderStats (what's drawn is counted on the GL thread).
+    uint32_t MainCulled = 0, ShadowCulled = 0;
+
+    // This frame's region of the GL thread's StreamBuffer. The GL-owning
+    // thread begins it before the packet is handed out
+    // (FramePacket_BeginInstances), DrawList::Close allocates from it,
+    // FramePacket_Execute flushes and fences it.
+    StreamFrame   Instances;
+    StreamBuffer* Stream = nullptr;
+    unsigned      SpillVbo = 0;
+    size_t        SpillBytes = 0;   // SpillVbo's size; only grows
+
+    void Reset();                        // clears the lists, keeps their capacity and the instance region
+
+    void Draw(const GpuMesh& mesh, ShaderHandle sh, const Mat4& model, unsigned albedo){ Draws.push_back({ &mesh, sh, albedo, model }); }
+    void CastShadow(const GpuMesh& mesh, const Mat4& model){ ShadowCasters.push_back({ &mesh, model }); }
+};
+
+// Instance region per packet the engine asks for; a frame that needs more
+// spills once and the region grows.
+constexpr size_t PACKET_INSTANCE_BYTES = 16384 * sizeof(Mat4);
+
+// GL-owning thread: create / destroy the spill buffer; begin the packet's
+// instance region for recording, or end it for a packet that won't be executed.
+void FramePacket_InitGpu(FramePacket& p);
+void FramePacket_DestroyGpu(FramePacket& p);
+void FramePacket_BeginInstances(FramePacket& p, StreamBuffer& stream);
+void FramePacket_EndInstances(FramePacket& p);
+
+// Recording thread, after the app recorded: closes every DrawList in parallel.
+void FramePacket_CloseLists(FramePacket& p);
+
+// GL thread: flushes the instance region, then shadow pass, viewport, clear,
+// sky, lighting for every shader used, MainPass callbacks, Draws, and the
+// merged, sorted DrawList commands; fences the region last and closes the
+// frame's RenderStats.
+void FramePacket_Execute(FramePacket& p);
@@ -0,0 +1,69 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include "Madus/Profiler.h"
+
+// GPU pass timing from GL timestamp queries, on the "GPU" profiler track.
+//
+//   { MADUS_GPU_ZONE("GPU Sky"); ...draws... }
+//   MADUS_GPU_ZONE_BEGIN("GPU Shadow"); ... MADUS_GPU_ZONE_END();   // across calls
+//
+// Every zone edge is a glQueryCounter(GL_TIMESTAMP), so zones nest freely
+// (GL_TIME_ELAPSED can't). Queries come from a pool of GPU_PROFILER_FRAMES
+// frames; each frame is read back GPU_PROFILER_FRAMES - 1 frames later, once
+// its last query is available, and never waited on: if it still isn't, the
+// frame is dropped. Results are mapped onto the CPU zone clock through a
+// GL_TIMESTAMP / Profiler_Ticks pair taken every couple of seconds, so GPU
+// zones line up under the CPU ones in Chrome traces and feed
+// Profiler_GetZoneStats like any other zone (a few frames late).
+//
+// Everything here runs on the thread that owns the GL context. The engine
+// calls Init/Shutdown; FramePacket_Execute brackets each frame.
+
+constexpr int GPU_PROFILER_FRAMES     = 4;
+constexpr int GPU_PROFILER_MAX_ZONES  = 64;   // per frame; more are ignored
+constexpr int GPU_PROFILER_MAX_DEPTH  = 16;
+
+#if MADUS_PROFILER
+
+void GpuProfiler_Init();
+void GpuProfiler_Shutdown();
+void GpuProfiler_BeginFrame();   // reads back finished frames, then opens a "GPU Frame" zone
+void GpuProfiler_EndFrame();     // closes any zone left open
+void GpuProfiler_BeginZone(uint32_t zone);   // zone from Profiler_RegisterZone
+void GpuProfiler_EndZone();
+uint64_t GpuProfiler_DroppedFrames();
+
+struct GpuScope {
+    explicit GpuScope(uint32_t zone){ GpuProfiler_BeginZone(zone); }
+    ~GpuScope(){ GpuProfiler_EndZone(); }
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+};
+
+#define MADUS_GPU_ZONE_ID(name)                                                                       \
+    static const uint32_t MADUS_PROFILE_CONCAT(madusGpuZone_, __LINE__) =                             \
+        Profiler_RegisterZone(name, __FILE__, __LINE__)
+#define MADUS_GPU_ZONE(name)                                                                          \
+    MADUS_GPU_ZONE_ID(name);                                                                          \
+    GpuScope MADUS_PROFILE_CONCAT(madusGpuScope_, __LINE__)(MADUS_PROFILE_CONCAT(madusGpuZone_, __LINE__))
+#define MADUS_GPU_ZONE_BEGIN(name)                                                                    \
+    do { MADUS_GPU_ZONE_ID(name); GpuProfiler_BeginZone(MADUS_PROFILE_CONCAT(madusGpuZone_, __LINE__)); } while (0)
+#define MADUS_GPU_ZONE_END() GpuProfiler_EndZone()
+
+#else
+
+inline void     GpuProfiler_Init() {}
+inline void     GpuProfiler_Shutdown() {}
+inline void     GpuProfiler_BeginFrame() {}
+inline void     GpuProfiler_EndFrame() {}
+inline void     GpuProfiler_BeginZone(uint32_t) {}
+inline void     GpuProfiler_EndZone() {}
+inline uint64_t GpuProfiler_DroppedFrames() { return 0; }
+
+#define MADUS_GPU_ZONE(name)       ((void)0)
+#define MADUS_GPU_ZONE_BEGIN(name) ((void)0)
+#define MADUS_GPU_ZONE_END()       ((void)0)
+
+#endif
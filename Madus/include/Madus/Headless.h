@@ -0,0 +1,34 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+// Offscreen GL for benchmarks and CI: an OpenGL 3.3 core context from EGL
+// with no window, drawing into a width x height framebuffer object (sRGB
+// color, 24-bit depth) instead of a swap chain. On Mesa it asks for the
+// surfaceless platform first (EGL_MESA_platform_surfaceless), so it runs on
+// llvmpipe without a display server or a GPU; elsewhere it takes the default
+// EGL display and, without EGL_KHR_surfaceless_context, a 1x1 pbuffer.
+//
+// Built when CMake finds EGL (Linux); otherwise Headless_Create fails.
+//
+// Headless_Present stands in for a swap with vsync off: it fences the frame
+// and waits for the one HEADLESS_FRAMES_IN_FLIGHT frames back, so the CPU
+// can't queue more ahead of the GPU than a swap chain would let it.
+//
+// A context is current on one thread at a time, like a window's.
+
+constexpr int HEADLESS_FRAMES_IN_FLIGHT = 2;
+
+struct HeadlessContext;
+
+// Current on the calling thread with GL loaded and the framebuffer bound,
+// or null (the reason goes to stderr).
+HeadlessContext* Headless_Create(int width, int height);
+void Headless_Destroy(HeadlessContext* h);   // makes it current on the calling thread first
+
+void Headless_MakeCurrent(HeadlessContext* h);
+void Headless_Release(HeadlessContext* h);    // the calling thread no longer has it current
+void Headless_Present(HeadlessContext* h);
+
+unsigned Headless_Framebuffer(const HeadlessContext* h);
+void     Headless_GetSize(const HeadlessContext* h, int* width, int* height);
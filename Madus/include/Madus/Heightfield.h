@@ -0,0 +1,66 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "Madus/Math.h"
+
+// Regular grid of terrain heights on XZ with per-sample normals cached at
+// build time. Queries are plain inline reads (no callbacks); the batched
+// samplers run four points at a time with SSE2 where available.
+struct Heightfield {
+    int   SizeX = 0, SizeZ = 0;          // samples per axis (>= 2)
+    float CellSize = 1.f;
+    float OriginX = 0.f, OriginZ = 0.f;  // world XZ of sample (0,0)
+    float MinHeight = 0.f, MaxHeight = 0.f;
+
+    std::vector<float> Heights;                  // SizeX*SizeZ, row-major in z
+    std::vector<float> NormalX, NormalY, NormalZ;
+
+    void  Init(int sizeX, int sizeZ, float cellSize, float originX, float originZ, float fill = 0.f);
+    float& At(int ix, int iz)       { return Heights[(size_t)iz * SizeX + ix]; }
+    float  At(int ix, int iz) const { return Heights[(size_t)iz * SizeX + ix]; }
+    void  RebuildNormals();          // call after editing Heights
+
+    float ExtentX() const { return (SizeX - 1) * CellSize; }
+    float ExtentZ() const { return (SizeZ - 1) * CellSize; }
+
+    // Bilinear height / unit normal at world (x,z); clamped at the borders.
+    float Height(float x, float z) const;
+    Vec3  Normal(float x, float z) const;
+
+    // Batched versions of Height/Normal, bit-identical to the single queries.
+    void SampleHeights(const float* xs, const float* zs, float* outH, size_t n) const;
+    void SampleNormals(const float* xs, const float* zs, float* outX, float* outY, float* outZ, size_t n) const;
+
+    // Slope-aware step test: the ground at (x,z) is at most stepOffset above
+    // feetY and no steeper than cosMaxSlope allows. Returns the ground height.
+    bool CanStepTo(float feetY, float x, float z, float stepOffset, float cosMaxSlope, float* outGroundY = nullptr) const;
+
+private:
+    float InvCell = 1.f;
+
+    struct Cell { size_t i; float tx, tz; };
+    Cell Locate(float x, float z) const {
+        const float fx = std::clamp((x - OriginX) * InvCell, 0.f, (float)(SizeX - 1));
+        const float fz = std::clamp((z - OriginZ) * InvCell, 0.f, (float)(SizeZ - 1));
+        const int ix = std::min((int)fx, SizeX - 2);
+        const int iz = std::min((int)fz, SizeZ - 2);
+        return { (size_t)iz * SizeX + ix, fx - (float)ix, fz - (float)iz };
+    }
+    float Bilerp(const float* g, const Cell& c) const {
+        const float* r0 = g + c.i;
+        const float* r1 = r0 + SizeX;
+        const float h0 = r0[0] + (r0[1] - r0[0]) * c.tx;
+        const float h1 = r1[0] + (r1[1] - r1[0]) * c.tx;
+        return h0 + (h1 - h0) * c.tz;
+    }
+    Vec3 BilerpNormal(const Cell& c) const {
+        return Normalize(Vec3{ Bilerp(NormalX.data(), c), Bilerp(NormalY.data(), c), Bilerp(NormalZ.data(), c) });
+    }
+};
+
+inline float Heightfield::Height(float x, float z) const { return Bilerp(Heights.data(), Locate(x, z)); }
+inline Vec3  Heightfield::Normal(float x, float z) const { return BilerpNormal(Locate(x, z)); }
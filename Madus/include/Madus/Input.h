@@ -2,31 +2,55 @@
 
  #pragma once
 
+ #include <cstdint>
+
+ // Event-driven input. Input_BindWindow installs GLFW key, mouse button and
+ // cursor callbacks; each event is stamped with Input_Now() and pushed into a
+ // lock-free single-producer ring (INPUT_EVENT_RING events). Nothing is
+ // queried per frame.
+ //
+ // Input_Sample applies the events stamped up to a time and builds the
+ // InputState for that moment: axes from the keys held at that time, buttons
+ // set if held or pressed at any point since the last sample, so a tap
+ // shorter than a frame still reaches the simulation. Call it once per fixed
+ // tick with Engine::GetTickTime(): the frame's first tick takes everything
+ // pumped this frame, later ticks see the same held keys. GLFW delivers
+ // events inside glfwPollEvents, so stamps only say which pump brought them;
+ // this keeps taps, it doesn't add sub-frame timing.
+ //
+ // Events past a full ring are dropped and counted (Input_DroppedEvents).
+
+ constexpr uint32_t INPUT_EVENT_RING = 4096;   // power of two
+
  struct InputState {
     float MoveX = 0.f; // A/D
     float MoveZ = 0.f; // W/S
     float MouseDX = 0.f;
     float MouseDY = 0.f;
-    bool  AbilityQ = false;  
-    bool  AbilityE = false; 
-    bool  AbilityR = false;  
+    bool  AbilityQ = false;
+    bool  AbilityE = false;
+    bool  AbilityR = false;
     bool  Ability1 = false;
     bool  Ability2 = false;
     bool  Ability3 = false;
     bool  Ability4 = false;
-    bool  AttackLMB = false; 
+    bool  AttackLMB = false;
     bool  InputRMB = false;
     bool  Dash = false;
+    bool  Jump = false;   // Space
     void ClearFrameDeltas(){
         MouseDX = MouseDY = 0;
-        Dash = false;
+        Dash = Jump = false;
         AbilityQ = AbilityE = AbilityR = Ability1 = Ability2 = Ability3 = Ability4 = false;
         AttackLMB = false;
     }
  };
 
- void Input_BindWindow(void* glfwWindow);
- void Input_Poll(InputState& out);
- void Input_ResetMouse();
- void Input_SetActive(bool active);
- bool Input_IsActive();
+ void     Input_BindWindow(void* glfwWindow);          // null unbinds
+ double   Input_Now();                                 // seconds on the steady clock, as Engine::GetTickTime()
+ void     Input_Sample(InputState& out, double upTo);  // consumes events stamped <= upTo
+ void     Input_Poll(InputState& out);                 // Input_Sample(out, Input_Now())
+ void     Input_ResetMouse();
+ void     Input_SetActive(bool active);
+ bool     Input_IsActive();
+ uint64_t Input_DroppedEvents();
@@ -0,0 +1,61 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Madus/Input.h"
+
+// InputState streams on the fixed-step clock, for deterministic replays.
+//
+// A recording is what each simulation tick was handed: sample k holds from
+// its Tick up to the next sample's, so the recorder only stores changes.
+// Timestamps are tick numbers at TickRate, never wall time, so a replay
+// drives the same ticks with the same input whatever the frame rate was
+// while recording. With EngineConfig::fixedFrameDt the frames line up too.
+//
+//   record:  rec.TickRate = rate;  per tick: rec.Record(tick, in);  rec.Save(path);
+//   replay:  rec.Load(path);       per tick: in = rec.At(tick);
+//
+// Files are "MINP" binaries: InputRecHeader, then SampleCount InputRecSample.
+
+struct InputRecHeader {
+    char     Magic[4];        // "MINP"
+    uint32_t Version;
+    uint32_t HeaderSize;      // sizeof(InputRecHeader), for forward compatibility
+    uint32_t Flags;           // reserved, 0
+    double   TickRate;        // ticks per second
+    uint64_t TickCount;       // length of the recording in ticks
+    uint64_t SampleCount;
+};
+
+struct InputRecSample {
+    uint64_t Tick;
+    float    MoveX, MoveZ, MouseDX, MouseDY;
+    uint32_t Buttons;         // one bit per InputState button, see InputReplay.cpp
+    uint32_t Flags;           // INPUT_REC_* bits
+};
+static_assert(sizeof(InputRecSample) == 32, "recordings store samples as 32 packed bytes");
+
+constexpr uint32_t INPUT_REC_VERSION = 1;
+constexpr uint32_t INPUT_REC_INACTIVE = 1u << 0;   // the tick ran no controller (input released)
+
+struct InputRecording {
+    double   TickRate  = 60.0;
+    uint64_t TickCount = 0;
+    std::vector<InputRecSample> Samples;   // ascending Tick
+
+    void Clear();
+    // Ticks in increasing order. active = false records a tick the controller sat out.
+    void Record(uint64_t tick, const InputState& in, bool active = true);
+    // Default state (active) before the first sample.
+    InputState At(uint64_t tick, bool* active = nullptr) const;
+    double Duration() const { return TickRate > 0.0 ? (double)TickCount / TickRate : 0.0; }
+
+    bool Save(const char* path) const;
+    bool Load(const char* path);
+
+private:
+    mutable size_t m_Cursor = 0;   // last sample At() returned; replays walk forward
+};
@@ -0,0 +1,113 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Work-stealing job system. Every job thread owns a deque: it pushes and pops
+// its own jobs at the bottom (LIFO, cache-warm) while idle threads steal from
+// the top. The main thread is job thread 0 and only runs jobs while it waits;
+// Jobs_WorkerCount() background threads run them all the time and sleep when
+// there is nothing to do.
+//
+// Completion is tracked with JobCounter: submitting a job against a counter
+// increments it, finishing the job decrements it, and Jobs_Wait runs other
+// jobs until it reaches zero. TaskGraph builds dependencies on top of that.
+//
+// Work tied to the main thread (GLFW window calls, GL when the engine runs
+// without its render thread) goes to the main lane (Jobs_SubmitMain), which
+// the main thread drains in Jobs_PumpMain (once a frame from Engine::Run) and
+// while it is inside Jobs_Wait.
+
+struct JobCounter {
+    std::atomic<int> Pending{0};
+    bool Done() const { return Pending.load(std::memory_order_acquire) == 0; }
+};
+
+// A function pointer plus up to PayloadBytes of captured state, copied by
+// value into the deques. Captures must be plain data; capture pointers to
+// anything bigger.
+struct Job {
+    static constexpr size_t PayloadBytes = 48;
+    void (*Fn)(void* payload) = nullptr;
+    JobCounter* Counter = nullptr;
+    alignas(16) unsigned char Payload[PayloadBytes];
+};
+
+template<class F>
+Job Jobs_Make(F&& f, JobCounter* counter = nullptr){
+    using T = std::decay_t<F>;
+    static_assert(sizeof(T) <= Job::PayloadBytes && alignof(T) <= 16, "job capture too large; capture a pointer instead");
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "job captures must be plain data");
+    Job j;
+    ::new (static_cast<void*>(j.Payload)) T(std::forward<F>(f));
+    j.Fn = [](void* p){ (*static_cast<T*>(p))(); };
+    j.Counter = counter;
+    return j;
+}
+
+// workers < 0: hardware threads - 1. The first Jobs_* call initialises with
+// the default if nobody did; the initialising thread becomes the main thread.
+void Jobs_Init(int workers = -1);
+void Jobs_Shutdown();
+int  Jobs_WorkerCount();
+int  Jobs_ThreadIndex();            // 0 main, 1..N workers, -1 any other thread
+
+void Jobs_Submit(const Job& job);
+void Jobs_SubmitMain(const Job& job);
+void Jobs_Wait(JobCounter& counter);
+int  Jobs_PumpMain();               // main thread only; returns how many main-lane jobs ran
+
+template<class F> void Jobs_Run(JobCounter& counter, F&& f){ Jobs_Submit(Jobs_Make(std::forward<F>(f), &counter)); }
+template<class F> void Jobs_RunMain(JobCounter& counter, F&& f){ Jobs_SubmitMain(Jobs_Make(std::forward<F>(f), &counter)); }
+
+// Runs fn(ctx, begin, end) over [0,count). The range is halved recursively
+// down to 'grain' items: each job pushes one half and keeps the other, so
+// idle threads steal big pieces first and a thread only ever holds
+// O(log count) pending jobs. The caller helps and returns when all is done.
+void Jobs_ParallelFor(size_t count, size_t grain, void (*fn)(void* ctx, size_t b, size_t e), void* ctx);
+
+template<class F>
+void Jobs_ParallelFor(size_t count, size_t grain, F&& f){
+    using T = std::remove_reference_t<F>;
+    Jobs_ParallelFor(count, grain, [](void* ctx, size_t b, size_t e){ (*static_cast<T*>(ctx))(b, e); },
+                     const_cast<void*>(static_cast<const void*>(std::addressof(f))));
+}
+
+// Frame task graph: add tasks, declare edges, Run(). Tasks whose
+// dependencies are met are submitted as jobs (or to the main lane when
+// mainThread is set); Run() blocks until every task has finished, helping in
+// the meantime. Build once and Run() every frame if the shape is fixed.
+struct TaskGraph {
+    using TaskId = uint32_t;
+
+    template<class F> TaskId Add(F&& f, bool mainThread = false){
+        m_Nodes.push_back({ Jobs_Make(std::forward<F>(f)), mainThread, 0, {} });
+        return (TaskId)(m_Nodes.size() - 1);
+    }
+    void Depend(TaskId task, TaskId dependsOn);   // 'task' starts after 'dependsOn' finished
+    void Run();
+    void Clear() { m_Nodes.clear(); }
+    size_t Size() const { return m_Nodes.size(); }
+
+private:
+    struct Node {
+        Job      Work;
+        bool     Main = false;
+        uint32_t Deps = 0;
+        std::vector<TaskId> Next;
+    };
+    std::vector<Node> m_Nodes;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_Remaining;
+    size_t m_RemainingSize = 0;
+    JobCounter m_Counter;
+
+    void Launch(TaskId id);
+};
@@ -2,11 +2,48 @@
 
 #pragma once
 
+#include <cstdint>
+#include <span>
 #include <vector>
+#include "Madus/File.h"
 #include "Madus/Math.h" // for AABB2
 
-struct Level {
-    std::vector<AABB2> Colliders;
+// Cooked level file (.mlvl), little-endian:
+//   LevelBinHeader, then ColliderCount AABB2s at ColliderOffset (16-byte aligned).
+// The runtime maps the file and uses the collider block in place.
+struct LevelBinHeader {
+    char     Magic[4];        // "MLVL"
+    uint32_t Version;
+    uint32_t HeaderSize;      // sizeof(LevelBinHeader), for forward compatibility
+    uint32_t Flags;           // reserved, 0
+    uint64_t ColliderOffset;  // bytes from file start
+    uint64_t ColliderCount;
+    AABB2    Bounds;          // union of all colliders
+};
+static_assert(sizeof(AABB2) == 16, "cooked levels store AABB2 as 4 packed floats");
+
+constexpr uint32_t LEVEL_BIN_VERSION = 1;
 
+struct Level {
+    // Text format: each non-empty line is "minx minz maxx maxz";
+    // '#' or '//' start a comment.
     bool LoadTxt(const char* path);
-};
\ No newline at end of file
+    bool ParseTxt(const char* text, size_t len, const char* nameForErrors = "<memory>");
+
+    // Binary format: maps the file; Colliders() then points into the mapping.
+    bool LoadBin(const char* path);
+    bool SaveBin(const char* path) const;
+
+    // Replaces the colliders with an owned copy (drops any mapping).
+    void SetColliders(std::vector<AABB2> colliders);
+    void Clear();
+
+    std::span<const AABB2> Colliders() const { return { m_Colliders, m_Count }; }
+    bool IsMapped() const { return m_File.IsOpen(); }
+
+private:
+    std::vector<AABB2> m_Owned;
+    MappedFile         m_File;
+    const AABB2*       m_Colliders = nullptr;
+    size_t             m_Count = 0;
+};
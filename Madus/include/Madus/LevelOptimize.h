@@ -0,0 +1,50 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "Madus/Math.h" // for AABB2
+
+// Offline simplification of level colliders. Every step keeps the union of
+// the boxes exactly (no epsilon). Surviving boxes keep their source order; a
+// merged box takes the place of its first part, split pieces that of their
+// box. Sequential pushout still depends on order and seams, so each drop,
+// merge and split is kept only if Level_VerifyPushout with Radius and
+// VerifySamples would still pass against the source.
+struct LevelOptimizeOptions {
+    bool   DropContained = true;   // remove boxes fully inside another box
+    bool   MergeAdjacent = true;   // greedy-merge boxes sharing an edge span (touching or overlapping)
+    float  SplitLength   = 0.f;    // > 0: split boxes longer than this along their long axis, for culling
+    float  Radius        = 0.35f;  // circle the result must resolve identically for (CharacterController::CapsuleRadius)
+    size_t VerifySamples = 65536;
+};
+
+struct LevelOptimizeStats {
+    size_t Before = 0, After = 0;
+    size_t Dropped = 0;   // contained boxes removed
+    size_t Merged = 0;    // boxes absorbed by merges
+    size_t Split = 0;     // pieces added by splitting
+    size_t Rejected = 0;  // edits taken back because the pushout changed
+    int    Passes = 0;
+};
+
+std::vector<AABB2> Level_Optimize(std::span<const AABB2> in, const LevelOptimizeOptions& opt = {},
+                                  LevelOptimizeStats* stats = nullptr);
+
+struct LevelVerifyResult {
+    size_t Samples = 0;
+    size_t Mismatches = 0;          // nearest-box distance differs
+    size_t ResolveMismatches = 0;   // resolved position or velocity differs
+    float  MaxResolveError = 0.f;   // largest position difference among those
+    bool Ok() const { return Mismatches == 0 && ResolveMismatches == 0; }
+};
+
+// Samples circle positions over both sets (a jittered grid plus points
+// around every source corner), each with a velocity. Ok() requires the
+// squared distance to the nearest box, clamped to radius^2, and the real
+// pushout (ResolveCircleAABB2 over each set in order, as MoveAndSlideXZ
+// ends) to give bit-identical position and velocity.
+LevelVerifyResult Level_VerifyPushout(std::span<const AABB2> original, std::span<const AABB2> optimized,
+                                      float radius, size_t gridSamples = 65536);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
 
@@ -13,6 +14,7 @@
 struct Vec3 { float x=0, y=0, z=0; };
 struct Quat { float x=0, y=0, z=0, w=1; }; // (x,y,z) imaginary, w real
 struct Mat4 { float m[16]; };              // column-major (OpenGL-style)
+struct AABB2 { float minx, minz, maxx, maxz; }; // axis-aligned box on the XZ plane
 
 inline Mat4 Identity() { Mat4 M{}; for(int i=0;i<16;++i) M.m[i]=(i%5==0)?1.f:0.f; return M; }
 
@@ -20,6 +22,9 @@ Mat4 Perspective(float fovYRadians, float aspect, float zNear, float zFar);
 Mat4 Ortho(float l,float r,float b,float t,float n,float f);
 Mat4 LookAt(const Vec3& eye, const Vec3& at, const Vec3& up);
 Mat4 TRS(const Vec3& t, const Quat& r, const Vec3& s);
+Mat4 MulM(const Mat4& A, const Mat4& B);   // A * B
+// out[i] = A[i] * B[i]. SSE when available, bit-identical to MulM.
+void MulMBatch(const Mat4* A, const Mat4* B, Mat4* out, size_t n);
 
 inline Vec3  Add(Vec3 a, Vec3 b){ return {a.x+b.x,a.y+b.y,a.z+b.z}; }
 inline Vec3  Sub(Vec3 a, Vec3 b){ return {a.x-b.x,a.y-b.y,a.z-b.z}; }
@@ -31,3 +36,8 @@ inline Vec3  Normalize(Vec3 v){ float L = Length(v); return (L>1e-6f)?Mul(v,1.f/
 
 Quat AngleAxis(float radians, const Vec3& axis);
 Mat4 QuatToMat4(const Quat& q);
+
+// View frustum as 6 planes (a,b,c,d), inside when a*x+b*y+c*z+d >= 0.
+struct Frustum { float p[6][4]; };
+Frustum FrustumFromMatrix(const Mat4& viewProj);
+bool    FrustumTestAABB(const Frustum& f, const Vec3& mn, const Vec3& mx);
@@ -0,0 +1,136 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Allocators for hot paths, so steady-state frames don't touch the global heap.
+//
+//   LinearArena  bump allocator; everything goes at once on Reset / Rewind.
+//                The engine resets one per frame (Engine::GetFrameArena) and
+//                every thread has a scratch one for temporaries (Memory_Scratch).
+//   FixedPool    fixed-size blocks on a free list, O(1) alloc / free.
+//   Pool<T>      typed FixedPool.
+//
+// Each has a std::pmr::memory_resource, so std::pmr containers can use them.
+// None of them is thread-safe: one per thread, or one owner.
+
+// One block, bumped. When it runs out, allocations fall through to the heap
+// (each its own block, freed on Reset/Rewind) and the next Reset regrows the
+// block to the high-water mark, so a steady workload stops allocating after
+// the first frame or two. Only for trivially destructible data: nothing is
+// destroyed, memory is just reused.
+struct LinearArena {
+    explicit LinearArena(size_t bytes = 0);
+    ~LinearArena();
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void* Alloc(size_t bytes, size_t align = alignof(std::max_align_t));
+    template<class T> T* AllocArray(size_t n){ return static_cast<T*>(Alloc(n * sizeof(T), alignof(T))); }
+
+    struct Marker { size_t Used = 0; size_t Overflow = 0; };
+    Marker Mark() const { return { m_Used, m_Overflow.size() }; }
+    void   Rewind(const Marker& m);   // frees everything allocated after Mark()
+    void   Reset();                   // frees everything; grows the block if it overflowed
+
+    size_t Used() const { return m_Used + m_OverflowBytes; }
+    size_t Capacity() const { return m_Size; }
+    size_t HighWater() const { return m_HighWater; }
+
+    std::pmr::memory_resource* Resource(){ return &m_Resource; }
+
+private:
+    struct ArenaResource : std::pmr::memory_resource {
+        LinearArena* Arena = nullptr;
+        void* do_allocate(size_t bytes, size_t align) override { return Arena->Alloc(bytes, align); }
+        void  do_deallocate(void*, size_t, size_t) override {}   // freed by Reset / Rewind
+        bool  do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+    };
+    struct Overflow { void* Ptr; size_t Bytes, Align; };
+
+    unsigned char* m_Block = nullptr;
+    size_t m_Size = 0, m_Used = 0;
+    std::vector<Overflow> m_Overflow;
+    size_t m_OverflowBytes = 0;
+    size_t m_HighWater = 0;
+    ArenaResource m_Resource;
+
+    void FreeOverflow(size_t keep);
+};
+
+// Rewinds the arena to where it was when the scope opened.
+struct ArenaScope {
+    explicit ArenaScope(LinearArena& a) : m_Arena(a), m_Mark(a.Mark()) {}
+    ~ArenaScope(){ m_Arena.Rewind(m_Mark); }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    std::pmr::memory_resource* Resource(){ return m_Arena.Resource(); }
+    LinearArena& Arena(){ return m_Arena; }
+
+private:
+    LinearArena& m_Arena;
+    LinearArena::Marker m_Mark;
+};
+
+// The calling thread's scratch arena. Take it inside an ArenaScope so
+// nested users each give back what they took.
+LinearArena& Memory_Scratch();
+
+// Blocks of one size, carved from pages of blocksPerPage and kept on an
+// intrusive free list. Pages are only returned to the heap on Clear or
+// destruction, after which no block may still be in use.
+struct FixedPool {
+    FixedPool(size_t blockSize, size_t blockAlign = alignof(std::max_align_t), size_t blocksPerPage = 64);
+    ~FixedPool();
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+
+    void* Alloc();
+    void  Free(void* p);
+    void  Clear();
+
+    size_t BlockSize() const { return m_BlockSize; }
+    size_t Live() const { return m_Live; }
+    size_t Capacity() const { return m_Pages.size() * m_PerPage; }
+
+    // Requests that fit a block come from the pool, the rest from upstream.
+    std::pmr::memory_resource* Resource(){ return &m_Resource; }
+
+private:
+    struct PoolResource : std::pmr::memory_resource {
+        FixedPool* Pool = nullptr;
+        void* do_allocate(size_t bytes, size_t align) override;
+        void  do_deallocate(void* p, size_t bytes, size_t align) override;
+        bool  do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+    };
+    struct FreeBlock { FreeBlock* Next; };
+
+    size_t m_BlockSize, m_BlockAlign, m_PerPage;
+    std::vector<void*> m_Pages;
+    FreeBlock* m_Free = nullptr;
+    size_t m_Live = 0;
+    PoolResource m_Resource;
+
+    void AddPage();
+};
+
+template<class T>
+struct Pool {
+    explicit Pool(size_t perPage = 64) : m_Pool(sizeof(T), alignof(T), perPage) {}
+
+    template<class... Args> T* New(Args&&... args){ return ::new (m_Pool.Alloc()) T(std::forward<Args>(args)...); }
+    void Delete(T* p){ if (p) { p->~T(); m_Pool.Free(p); } }
+
+    size_t Live() const { return m_Pool.Live(); }
+    FixedPool& Blocks(){ return m_Pool; }
+
+private:
+    FixedPool m_Pool;
+};
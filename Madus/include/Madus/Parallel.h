@@ -0,0 +1,14 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Splits [0,count) into contiguous ranges of at least 'grain' items and runs
+// fn(begin, end) on them across up to 'workers' threads (the caller is one of
+// them). Runs on the job system (Jobs.h); workers <= 0 uses all of its
+// threads. Blocks until done, running other jobs meanwhile.
+void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn, int workers = 0);
+
+int  Parallel_HardwareThreads();
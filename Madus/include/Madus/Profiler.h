@@ -0,0 +1,99 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Scoped CPU profiler, built in unless the CMake option MADUS_PROFILER is off
+// (every call below is then an empty inline and the macros expand to nothing).
+//
+//   void Terrain::Draw(...){
+//       MADUS_PROFILE_FUNCTION();
+//       ...
+//       { MADUS_PROFILE_ZONE("Upload"); ... }
+//   }
+//
+// A zone is a static site (name, file, line) registered on first use; a pass
+// through it costs two timestamp reads and a few stores into the calling
+// thread's ring, with no locks and no atomics read-modify-writes. Each thread
+// owns its ring (PROFILER_RING_EVENTS completed zones; older ones are
+// overwritten) and its per-zone totals; readers on other threads copy them
+// and discard anything the owner overwrote while they were copying.
+//
+// Profiler_EndFrame, called by Engine::Run once per frame, folds every
+// thread's totals into a window of the last PROFILER_WINDOW_FRAMES frames
+// for Profiler_GetZoneStats. Profiler_WriteChromeTrace dumps what the rings
+// still hold as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+// A track is a timeline that isn't a thread: zones measured elsewhere (GPU
+// queries, see GpuProfiler.h) are pushed onto it afterwards with explicit
+// timestamps on the zone clock, and show up beside the threads in traces
+// and in the zone stats.
+
+constexpr size_t PROFILER_RING_EVENTS   = 1u << 16;   // per thread
+constexpr int    PROFILER_MAX_ZONES     = 1024;
+constexpr int    PROFILER_WINDOW_FRAMES = 120;
+
+struct ProfTrack;
+
+struct ProfZoneStats {
+    const char* Name = nullptr;
+    const char* File = nullptr;
+    int         Line = 0;
+    double      AvgMs = 0.0;          // per frame, summed over every thread and call
+    double      MaxMs = 0.0;          // worst frame in the window
+    double      CallsPerFrame = 0.0;
+};
+
+#if MADUS_PROFILER
+
+uint32_t Profiler_RegisterZone(const char* name, const char* file, int line);   // name must outlive the program
+
+struct ProfScope {
+    explicit ProfScope(uint32_t zone);
+    ~ProfScope();
+    ProfScope(const ProfScope&) = delete;
+    ProfScope& operator=(const ProfScope&) = delete;
+
+private:
+    uint64_t m_Start;
+    uint32_t m_Zone;
+};
+
+void     Profiler_SetThreadName(const char* name);   // shown in traces; call once at the top of a thread
+void     Profiler_EndFrame();                        // the engine calls this; one thread only
+size_t   Profiler_GetZoneStats(std::vector<ProfZoneStats>& out);   // zones seen in the window, slowest first
+bool     Profiler_WriteChromeTrace(const char* path);
+void     Profiler_Reset();                           // drops the window and every ring
+
+uint64_t   Profiler_Ticks();                         // the zone clock
+double     Profiler_NsPerTick();
+ProfTrack* Profiler_CreateTrack(const char* name);   // lives as long as the program
+void       Profiler_RecordZone(ProfTrack* track, uint32_t zone, uint64_t startTicks, uint64_t endTicks);   // one writer at a time
+
+#define MADUS_PROFILE_CONCAT2(a, b) a##b
+#define MADUS_PROFILE_CONCAT(a, b)  MADUS_PROFILE_CONCAT2(a, b)
+#define MADUS_PROFILE_ZONE(name)                                                                      \
+    static const uint32_t MADUS_PROFILE_CONCAT(madusZone_, __LINE__) =                                \
+        Profiler_RegisterZone(name, __FILE__, __LINE__);                                              \
+    ProfScope MADUS_PROFILE_CONCAT(madusScope_, __LINE__)(MADUS_PROFILE_CONCAT(madusZone_, __LINE__))
+#define MADUS_PROFILE_FUNCTION() MADUS_PROFILE_ZONE(__func__)
+
+#else
+
+inline void       Profiler_SetThreadName(const char*) {}
+inline void       Profiler_EndFrame() {}
+inline size_t     Profiler_GetZoneStats(std::vector<ProfZoneStats>& out) { out.clear(); return 0; }
+inline bool       Profiler_WriteChromeTrace(const char*) { return false; }
+inline void       Profiler_Reset() {}
+inline uint64_t   Profiler_Ticks() { return 0; }
+inline double     Profiler_NsPerTick() { return 1.0; }
+inline ProfTrack* Profiler_CreateTrack(const char*) { return nullptr; }
+inline void       Profiler_RecordZone(ProfTrack*, uint32_t, uint64_t, uint64_t) {}
+
+#define MADUS_PROFILE_ZONE(name) ((void)0)
+#define MADUS_PROFILE_FUNCTION() ((void)0)
+
+#endif
@@ -0,0 +1,73 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+
+// Per-frame renderer counters. The Renderer_* calls, the terrain and
+// FramePacket_Execute add to the GL thread's current frame
+// (RenderStats_Frame); FramePacket_Execute closes it with RenderStats_EndFrame,
+// which keeps the last RENDER_STATS_WINDOW_FRAMES frames for the summary and
+// appends a row to the CSV stream if one is open.
+//
+// Counts are of calls made, not of state that actually changed: a program
+// bound twice in a row is two ProgramBinds. Binds of 0 (unbinding) aren't
+// counted. Submitted / Culled are objects that passed / failed CPU culling
+// in each pass; the renderer counts what it draws, whoever culls adds what
+// it rejected (FramePacket::MainCulled / ShadowCulled on the recording side).
+//
+// The accumulator belongs to the GL thread; everything else may be called
+// from any thread.
+
+#define MADUS_RENDER_STATS_FIELDS(X) \
+    X(DrawCalls)                     \
+    X(Triangles)                     \
+    X(Instances)                     \
+    X(ProgramBinds)                  \
+    X(TextureBinds)                  \
+    X(VaoBinds)                      \
+    X(UniformUploads)                \
+    X(BufferBytes)                   \
+    X(FboSwitches)                   \
+    X(ShadowSubmitted)               \
+    X(ShadowCulled)                  \
+    X(MainSubmitted)                 \
+    X(MainCulled)
+
+constexpr int RENDER_STATS_WINDOW_FRAMES = 120;
+
+struct RenderStats {
+#define MADUS_RENDER_STATS_MEMBER(name) uint64_t name = 0;
+    MADUS_RENDER_STATS_FIELDS(MADUS_RENDER_STATS_MEMBER)
+#undef MADUS_RENDER_STATS_MEMBER
+};
+
+struct RenderStatsAvg {
+#define MADUS_RENDER_STATS_MEMBER(name) double name = 0.0;
+    MADUS_RENDER_STATS_FIELDS(MADUS_RENDER_STATS_MEMBER)
+#undef MADUS_RENDER_STATS_MEMBER
+};
+
+struct RenderStatsSummary {
+    RenderStats    Min, Max;
+    RenderStatsAvg Avg;
+    int            Frames = 0;   // in the window
+};
+
+RenderStats& RenderStats_Frame();              // GL thread: the frame being counted
+void RenderStats_EndFrame(uint64_t frame);     // GL thread: publish it and start the next
+
+RenderStats RenderStats_Last();                // the last finished frame
+bool RenderStats_GetSummary(RenderStatsSummary& out);   // false until a frame has finished
+
+// One header row, then one row per finished frame until closed.
+bool RenderStats_OpenCsv(const char* path);
+void RenderStats_CloseCsv();
+bool RenderStats_CsvOpen();
+
+inline void RenderStats_CountDraw(uint64_t indexCount, uint64_t instances = 1){
+    RenderStats& s = RenderStats_Frame();
+    ++s.DrawCalls;
+    s.Triangles += indexCount / 3 * instances;
+    s.Instances += instances;
+}
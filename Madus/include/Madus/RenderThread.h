@@ -0,0 +1,64 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Madus/FramePacket.h"
+#include "Madus/StreamBuffer.h"
+
+struct GLFWwindow;
+struct HeadlessContext;
+
+// Dedicated GL thread. It owns the window's context (or the headless one)
+// while running and turns submitted FramePackets into GL calls and a swap, in
+// order, while the main thread simulates and records the next frame.
+//
+// maxInFlight caps how many submitted packets may wait for or be in GL at
+// once; the main thread records into one more. 1 is double buffering (one
+// frame of added latency), 2 triple buffering. Acquire() blocks when the cap
+// is reached, which is how a GPU-bound frame throttles the simulation.
+struct RenderThread {
+    RenderThread() = default;
+    ~RenderThread() { Stop(); }
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // The calling thread releases the context; the GL thread makes it current.
+    // Pass the window, or null and the headless context.
+    void Start(GLFWwindow* window, HeadlessContext* headless, int maxInFlight);
+    // Draws what was submitted, releases the context and joins. The caller
+    // makes the context current again if it still needs GL.
+    void Stop();
+    bool IsRunning() const { return m_Thread.joinable(); }
+
+    FramePacket& Acquire();   // main thread: the packet to record next, reset
+    void Submit();            // main thread: hand the acquired packet over
+    void Flush();             // main thread: wait until everything submitted was presented
+
+    struct Stats {
+        uint64_t Presented = 0;
+        double   LastGLMs = 0;        // GL thread: execute + swap of the last packet
+        double   LastAcquireWaitMs = 0;  // main thread blocked on the latency cap
+    };
+    Stats GetStats() const;
+
+private:
+    GLFWwindow* m_Window = nullptr;
+    HeadlessContext* m_Headless = nullptr;
+    std::vector<std::unique_ptr<FramePacket>> m_Packets;   // ring, maxInFlight + 1
+    StreamBuffer m_Stream;                                  // packets' instance regions, GL thread only
+    std::thread m_Thread;
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    uint64_t m_Submitted = 0, m_Presented = 0;
+    bool   m_Quit = false;
+    double m_LastGLMs = 0, m_LastAcquireWaitMs = 0;
+
+    void Loop();
+};
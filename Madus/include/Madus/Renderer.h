@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include "Madus/Math.h"
 #include "Madus/Mesh.h"
 #include "Madus/Shader.h"
@@ -10,6 +12,7 @@ struct DirectionalLight { float dir[3]={-0.3f,-1.f,-0.2f}; float color[3]={1,1,1
 
 struct FrameParams {
     Mat4 View, Proj;
+    Vec3 CamPos;
     DirectionalLight Sun;
     float Clear[3] = {0.06f, 0.07f, 0.09f};
 };
@@ -17,11 +20,26 @@ struct FrameParams {
 void Renderer_Init(void* glfwWindow);
 void Renderer_Shutdown();
 void Renderer_Resize(int w,int h);
+// Framebuffer the main pass draws into, rebound after the shadow pass
+// (0, the window, unless headless; see Headless.h).
+void Renderer_SetTargetFramebuffer(unsigned fbo);
 void Renderer_Begin(const FrameParams& fp);
 void Renderer_DrawMesh(const GpuMesh& mesh, ShaderHandle sh, const Mat4& model, unsigned albedoTex);
 void Renderer_End();
 ShaderHandle Renderer_GetBasicLitShader();
 
+// Basic lit shader with the model matrix as a per-instance attribute (locations 3-6).
+ShaderHandle Renderer_GetInstancedLitShader();
+// 'count' instances of mesh; their model matrices are consecutive Mat4s at byteOffset in instanceVbo.
+void Renderer_DrawMeshInstanced(const GpuMesh& mesh, ShaderHandle sh, unsigned albedoTex, unsigned instanceVbo, size_t byteOffset, uint32_t count);
+
+// Links a custom vertex shader against the basic lit fragment shader. The VS
+// must output vNrm, vWS and vUV like the built-in one.
+ShaderHandle Renderer_CreateLitProgram(const char* vsSrc);
+// Uploads camera, sun, hemisphere and shadow-map uniforms for a lit program.
+// Call after Renderer_Shadow_Begin/End so the light matrix is current.
+void Renderer_ApplyLighting(ShaderHandle sh, const FrameParams& fp);
+
 // --- Shadow map API ---
 struct ShadowMapInfo {
     Mat4 LightView;
@@ -32,6 +50,7 @@ struct ShadowMapInfo {
 void Renderer_Shadow_Init(int size = 2048);
 void Renderer_Shadow_Begin(const ShadowMapInfo& sm);
 void Renderer_Shadow_DrawDepth(const GpuMesh& mesh, const Mat4& model);
+void Renderer_Shadow_DrawDepthInstanced(const GpuMesh& mesh, unsigned instanceVbo, size_t byteOffset, uint32_t count);
 void Renderer_Shadow_End();
 unsigned Renderer_Shadow_GetTexture();
 Mat4     Renderer_Shadow_GetLightVP();
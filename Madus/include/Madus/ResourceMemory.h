@@ -0,0 +1,53 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Bytes held by engine resources, per category: GL textures (mip chains
+// included), GL buffers, render targets (textures an FBO draws into) and
+// CPU-side asset data (terrain fields, streamed world chunks). Whoever
+// creates a resource records it with ResourceMemory_Track and drops it with
+// ResourceMemory_Untrack when it's freed; tracking an id again replaces its
+// size (a buffer re-specified with glBufferData).
+//
+// Sizes are what the data needs at the requested format, not what the
+// driver actually allocates (padding, alignment, compression, RGB stored
+// as RGBA), so treat the GPU numbers as a floor. GL ids are per kind;
+// CPU assets are keyed by their address.
+//
+// Budgets are optional, per kind and for the GPU total (textures, buffers
+// and render targets). Going over one logs a warning to stderr once; it
+// warns again only after dropping back under. Nothing is refused.
+//
+// Every call may be made from any thread.
+
+enum class ResourceKind : uint8_t { Texture, Buffer, RenderTarget, CpuAsset, Count };
+
+constexpr int RESOURCE_KIND_COUNT = (int)ResourceKind::Count;
+
+struct ResourceMemoryKindStats {
+    size_t Current = 0, Peak = 0;   // bytes
+    size_t Count = 0;               // live resources
+    size_t Budget = 0;              // 0 = none
+};
+
+struct ResourceMemoryStats {
+    ResourceMemoryKindStats Kinds[RESOURCE_KIND_COUNT];
+    size_t GpuCurrent = 0, GpuPeak = 0, GpuBudget = 0;
+};
+
+void ResourceMemory_Track(ResourceKind kind, uintptr_t id, size_t bytes);
+void ResourceMemory_Untrack(ResourceKind kind, uintptr_t id);
+inline void ResourceMemory_Track(ResourceKind kind, const void* p, size_t bytes){ ResourceMemory_Track(kind, (uintptr_t)p, bytes); }
+inline void ResourceMemory_Untrack(ResourceKind kind, const void* p){ ResourceMemory_Untrack(kind, (uintptr_t)p); }
+
+void ResourceMemory_SetBudget(ResourceKind kind, size_t bytes);   // 0 removes it
+void ResourceMemory_SetGpuBudget(size_t bytes);
+ResourceMemoryStats ResourceMemory_GetStats();
+void ResourceMemory_ResetPeaks();   // peaks restart from the current sizes
+const char* ResourceMemory_KindName(ResourceKind kind);
+
+// A w x h 2D texture at bytesPerTexel; with mips, the whole chain down to 1x1.
+size_t ResourceMemory_TextureBytes(int w, int h, size_t bytesPerTexel, bool mips);
@@ -0,0 +1,48 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <vector>
+#include "Madus/ECS.h"
+#include "Madus/FramePacket.h"
+#include "Madus/Math.h"
+#include "Madus/Mesh.h"
+#include "Madus/Shader.h"
+#include "Madus/Input.h"
+#include "Madus/CharacterController.h"
+
+// Scene components. CharacterController is used as a component as-is.
+struct CTransform {
+    Vec3 Position{};
+    Quat Rotation{};
+    Vec3 Scale{1, 1, 1};
+};
+
+struct CWorldMatrix { Mat4 M = Identity(); };   // written by Scene_UpdateWorldMatrices
+
+struct CRenderMesh {
+    const GpuMesh* Mesh = nullptr;
+    unsigned Albedo = 0;
+    bool CastShadow = true;
+};
+
+struct CCollider { AABB2 Box{}; };              // static level box on XZ
+
+// Per-tick controller input; the app fills it before Scene_TickControllers.
+struct CControllerInput {
+    InputState In{};
+    Vec3 CamFwd{0, 0, -1}, CamRight{1, 0, 0};
+    bool Active = true;
+};
+
+// Systems. Parallel ones split by chunk across workers (<= 0: hardware threads).
+
+// CharacterController + CControllerInput (+ CTransform, which gets the new position).
+void Scene_TickControllers(EcsWorld& w, float dt, int workers = 0);
+// CTransform -> CWorldMatrix.
+void Scene_UpdateWorldMatrices(EcsWorld& w, int workers = 0);
+// Dense copy of every CCollider box, for the controllers' collider array.
+void Scene_GatherColliders(EcsWorld& w, std::vector<AABB2>& out);
+// CWorldMatrix + CRenderMesh into the packet's per-thread draw lists, chunks
+// recorded in parallel. sh must be an instanced shader (Renderer_GetInstancedLitShader).
+void Scene_RecordDraws(EcsWorld& w, ShaderHandle sh, FramePacket& packet, int workers = 0);
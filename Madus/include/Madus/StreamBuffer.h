@@ -0,0 +1,75 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Ring of per-frame regions for data the CPU writes once and the GPU reads
+// once (instance transforms, debug lines, particles, light lists), so none of
+// it goes through glBufferData / glBufferSubData.
+//
+// With ARB_buffer_storage (core in 4.4) each region is mapped persistent and
+// coherent once for its whole life. Without it a region is mapped with
+// UNSYNCHRONIZED | INVALIDATE_BUFFER at BeginFrame and unmapped at Flush.
+// Either way a region is only handed out again once the fence placed after
+// the last frame that read it has signalled, so 'frames' regions let that
+// many frames be written, queued or drawn at once.
+//
+// Regions are separate buffer objects: the fallback can't map two ranges of
+// one buffer at a time, and a region that overflowed grows on its own the
+// next time it comes around.
+
+struct StreamAlloc {
+    void*    Ptr = nullptr;   // null: the frame is out of room
+    unsigned Buffer = 0;
+    size_t   Offset = 0;      // bytes into Buffer
+};
+
+// One frame's region, filled in by StreamBuffer::BeginFrame.
+struct StreamFrame {
+    StreamFrame() = default;
+    StreamFrame(const StreamFrame&) = delete;
+    StreamFrame& operator=(const StreamFrame&) = delete;
+
+    unsigned       Buffer = 0;
+    unsigned char* Base = nullptr;     // null outside BeginFrame..Flush
+    size_t         Size = 0;
+    int            Slot = -1;
+    std::atomic<size_t> Used{0};       // bytes asked for; past Size means it overflowed
+
+    // Any thread, between BeginFrame and Flush. align must be a power of two.
+    StreamAlloc Alloc(size_t bytes, size_t align = 16);
+};
+
+struct StreamBuffer {
+    StreamBuffer() = default;
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // GL thread, context current for all of these. allowPersistent = false
+    // forces the map/unmap fallback.
+    void Init(size_t frameBytes, int frames = 3, bool allowPersistent = true);
+    void Shutdown();
+    bool IsPersistent() const { return m_Persistent; }
+
+    void BeginFrame(StreamFrame& f);   // next region: waits on its fence, grows it if a frame overflowed, maps it
+    void Flush(StreamFrame& f);        // before GL reads the region (unmaps it in the fallback)
+    void EndFrame(StreamFrame& f);     // after the last command reading it: fences the region
+
+private:
+    struct Region {
+        unsigned       Buffer = 0;
+        unsigned char* Mapped = nullptr;
+        size_t         Size = 0;
+        void*          Fence = nullptr;   // GLsync
+    };
+    std::vector<Region> m_Regions;
+    size_t m_Wanted = 0;   // region size asked for by overflowing frames
+    int    m_Next = 0;
+    bool   m_Persistent = false;
+
+    void Create(Region& r, size_t bytes);
+    void Destroy(Region& r);
+};
@@ -0,0 +1,60 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Madus/Math.h"
+#include "Madus/Heightfield.h"
+#include "Madus/Renderer.h"
+#include "Madus/StreamBuffer.h"
+
+// CDLOD terrain renderer. One fixed GridRes x GridRes patch is instanced over
+// the nodes of a quadtree picked by camera distance; heights and normals come
+// from textures uploaded from the collision Heightfield, so what you see is
+// what the controller walks on. Odd grid vertices morph onto their even
+// neighbours near each LOD range end, so there are no cracks or pops.
+struct TerrainRenderer {
+    int   GridRes    = 32;     // quads per patch side (power of two)
+    int   LodLevels  = 6;
+    float Lod0Range  = 24.f;   // range of the finest level; each level doubles it
+    float MorphStart = 0.7f;   // morph begins at this fraction of a level's band
+    float UVScale    = 0.25f;  // albedo tiling per metre
+
+    bool Init(const Heightfield& hf);
+    void Shutdown();
+    void UploadHeights();      // after editing the heightfield
+
+    // Camera pass: LOD from camPos, culled against the camera frustum.
+    void Draw(const FrameParams& fp, unsigned albedoTex);
+    // Shadow pass (between Renderer_Shadow_Begin/End). LOD still follows the
+    // camera so the caster matches the receiver; culled against the light.
+    void DrawShadow(const ShadowMapInfo& sm, const Vec3& camPos);
+
+    struct Stats { int Selected = 0, Culled = 0; };
+    Stats LastMain, LastShadow;
+
+private:
+    struct Node { float x, z, size, lod; };   // one instance, matches the VS layout
+    struct MinMax { float lo, hi; };
+
+    const Heightfield* m_Field = nullptr;
+    unsigned m_VAO = 0, m_GridVBO = 0, m_IBO = 0;
+    StreamBuffer m_Instances;   // one region per pass draw; Node instances
+    unsigned m_HeightTex = 0, m_NormalTex = 0;
+    unsigned m_Shader = 0, m_DepthShader = 0;
+    uint32_t m_IndexCount = 0;
+
+    float m_RootSize = 0.f;
+    int   m_RootsX = 0, m_RootsZ = 0;
+    std::vector<std::vector<MinMax>> m_MinMax;   // per level, row-major
+    std::vector<float> m_Ranges;
+    std::vector<Node>  m_Selection;
+
+    void BuildMinMax();
+    MinMax NodeMinMax(int lod, int nx, int nz) const;
+    bool  SelectNode(int lod, int nx, int nz, const Vec3& cam, const Frustum& fr, Stats& st);
+    void  Select(const Vec3& camPos, const Mat4& cullVP, Stats& st);
+    void  SetCommonUniforms(unsigned sh, const Vec3& camPos);
+    void  DrawSelection();
+};
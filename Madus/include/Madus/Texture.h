@@ -6,4 +6,5 @@ unsigned CreateTexture2DFromFile(const char* path, bool srgb=true);
 unsigned CreateTexture2DWhite(); // 1x1 white fallback
 void     DestroyTexture(unsigned& tex);
 unsigned CreateCheckerTexture(int size = 1024, int checks = 16, bool srgb = true);
-
+void     GenerateCheckerPixels(unsigned char* rgba, int size, int checks); // size*size*4 bytes, no GL
+void     GenerateCheckerRows(unsigned char* rgba, int size, int checks, int y0, int rows); // rows y0.., size*rows*4 bytes
@@ -0,0 +1,62 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Madus/Math.h"
+
+// Parent/child transforms (character roots, sockets, attachments). Nodes are
+// kept in breadth-first order in flat arrays, so every parent precedes its
+// children and each depth is one contiguous range. Update() only recomputes
+// nodes whose local TRS changed and their descendants, one depth level at a
+// time with MulMBatch.
+//
+// Handles are stable across re-sorts and removals. World() reflects the last
+// Update(); structural changes are applied there too.
+struct TransformHierarchy {
+    static constexpr uint32_t None = ~0u;
+
+    uint32_t Create(uint32_t parent = None);
+    void     Destroy(uint32_t node);            // node and its whole subtree
+    void     SetParent(uint32_t node, uint32_t parent);
+    uint32_t Parent(uint32_t node) const { return m_HandleParent[node]; }
+    bool     IsValid(uint32_t node) const { return node < m_HandleToDense.size() && m_HandleToDense[node] != None; }
+
+    void SetLocal(uint32_t node, const Vec3& pos, const Quat& rot, const Vec3& scale);
+    void SetLocalPosition(uint32_t node, const Vec3& pos);
+    void SetLocalRotation(uint32_t node, const Quat& rot);
+    void SetLocalScale(uint32_t node, const Vec3& scale);
+
+    const Mat4& World(uint32_t node) const { return m_World[m_HandleToDense[node]]; }
+    const Mat4& Local(uint32_t node) const { return m_Local[m_HandleToDense[node]]; }
+
+    void Update();
+
+    size_t Count() const { return m_World.size(); }
+    uint32_t LastRecomputed = 0;                // world matrices rebuilt by the last Update
+
+private:
+    // Dense, breadth-first
+    std::vector<uint32_t> m_Parent;             // dense index of the parent, or None
+    std::vector<Vec3>     m_Pos, m_Scale;
+    std::vector<Quat>     m_Rot;
+    std::vector<Mat4>     m_Local, m_World;
+    std::vector<uint8_t>  m_Dirty;              // local TRS changed since the last Update
+    std::vector<uint32_t> m_DenseToHandle;
+    std::vector<uint32_t> m_LevelStart;         // depth d is [m_LevelStart[d], m_LevelStart[d+1])
+
+    // Handle table
+    std::vector<uint32_t> m_HandleToDense;
+    std::vector<uint32_t> m_HandleParent;
+    std::vector<uint32_t> m_FreeHandles;
+    bool m_StructureDirty = false;
+
+    // Update scratch
+    std::vector<uint8_t>  m_Changed;
+    std::vector<uint32_t> m_Batch;
+    std::vector<Mat4>     m_ParentW, m_LocalW, m_OutW;
+
+    uint32_t Dense(uint32_t node) const { return m_HandleToDense[node]; }
+    void Resort();
+};
@@ -0,0 +1,99 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Madus/Level.h"
+#include "Madus/Math.h"
+
+// Chunked world on XZ. A directory holds world.mwld (tile size + list of
+// non-empty tiles) and one cooked level per tile, tile_<x>_<z>.mlvl, as
+// written by MadusLevelCook --tiles. Tile (x,z) covers
+// [x*TileSize, (x+1)*TileSize) on each axis; boxes crossing a border are
+// clipped into every tile they touch.
+struct WorldStreamConfig {
+    std::string Dir;
+    int   LoadRadius      = 2;     // tiles kept resident around the focus (square ring)
+    int   UnloadRadius    = 3;     // evict beyond this; > LoadRadius to avoid thrashing at borders
+    float PrefetchSeconds = 1.5f;  // also request the ring around focus + velocity * this
+    float WallHeight      = 3.f;   // render proxy for colliders
+    float WallCenterY     = 1.f;
+};
+
+// Everything derived from one tile. Built on the I/O thread when it loads,
+// freed on the I/O thread when it is evicted; never rebuilt.
+struct WorldChunk {
+    int   TileX = 0, TileZ = 0;
+    AABB2 Bounds{};                  // union of the colliders
+    Level Colliders;                 // mapped tile file
+    std::vector<Mat4> WallModels;    // one box per collider: main-pass batch and shadow casters
+
+    WorldChunk() = default;
+    ~WorldChunk();                   // drops it from the CpuAsset total
+    WorldChunk(const WorldChunk&) = delete;
+    WorldChunk& operator=(const WorldChunk&) = delete;
+};
+
+struct WorldStreamer {
+    WorldStreamer() = default;
+    ~WorldStreamer() { Close(); }
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    bool Open(const WorldStreamConfig& cfg);   // reads the manifest, starts the I/O thread
+    void Close();
+    bool IsOpen() const { return m_Thread.joinable(); }
+
+    // Main thread, once per frame: adopts finished chunks, evicts far ones and
+    // queues the wanted set nearest first. Never blocks on I/O.
+    void Update(const Vec3& focus, const Vec3& velocity);
+    // Blocks until every queued load has finished, then adopts them (startup, teleports).
+    void Flush();
+
+    // Appends resident colliders overlapping 'area'. Returns how many were added.
+    size_t QueryColliders(const AABB2& area, std::vector<AABB2>& out) const;
+
+    const std::vector<const WorldChunk*>& Resident() const { return m_ResidentList; }
+    float TileSize() const { return m_TileSize; }
+
+    struct Stats { size_t Resident = 0, Queued = 0, Loaded = 0, Evicted = 0, Failed = 0; };
+    Stats GetStats() const;
+
+private:
+    struct Request { int x, z, priority; };
+
+    WorldStreamConfig m_Cfg;
+    float m_TileSize = 16.f;
+    std::unordered_set<uint64_t> m_Existing;   // tiles listed in the manifest
+
+    // Main thread only
+    std::unordered_map<uint64_t, std::unique_ptr<WorldChunk>> m_Resident;
+    std::unordered_set<uint64_t> m_InFlight;   // requested, not adopted yet
+    std::vector<const WorldChunk*> m_ResidentList;
+    size_t m_Loaded = 0, m_Evicted = 0, m_Failed = 0;
+
+    // Shared with the I/O thread, guarded by m_Mutex
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Wake, m_Idle;
+    std::vector<Request> m_Queue;              // sorted, most urgent last
+    std::vector<std::unique_ptr<WorldChunk>> m_Done;
+    std::vector<uint64_t> m_DoneFailed;
+    std::vector<std::unique_ptr<WorldChunk>> m_Retire;
+    int  m_Busy = 0;
+    bool m_Quit = false;
+    std::thread m_Thread;
+
+    bool ReadManifest(const std::string& path);
+    void IoThread();
+    std::unique_ptr<WorldChunk> LoadChunk(int x, int z) const;
+    void Adopt();
+    int  TileOf(float v) const;
+};
@@ -0,0 +1,335 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/AllocTracker.h"
+
+#if MADUS_ALLOC_TRACKING
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
+// Everything here is constant-initialized: the hooks run before (and after)
+// any dynamic initializer.
+namespace {
+constexpr int kMaxTags  = 64;
+constexpr int kMaxSites = 1024;
+constexpr int kDepth    = 16;
+constexpr int kSkip     = 3;   // Capture, Record, the hook itself
+
+// kSkip counts real frames: inlined, it would skip the caller's too.
+#if defined(_MSC_VER)
+  #define MADUS_NOINLINE __declspec(noinline)
+#else
+  #define MADUS_NOINLINE __attribute__((noinline))
+#endif
+
+struct TagStats {
+    const char* Name;
+    std::atomic<uint64_t> Allocs, Bytes, Steady;
+};
+TagStats         gTags[kMaxTags];
+std::atomic<int> gTagCount{0};
+
+struct Site {
+    uint64_t    Hash;
+    void*       Frames[kDepth];
+    int         Depth;
+    const char* Tag;
+    uint64_t    Count, Bytes, FirstFrame, LastFrame;
+};
+Site     gSites[kMaxSites];
+int      gSiteCount = 0;
+uint64_t gDroppedSites = 0;
+
+std::atomic_flag      gLock = ATOMIC_FLAG_INIT;   // tag registration and the site table
+std::atomic<bool>     gArmed{false};
+std::atomic<uint64_t> gFrame{0}, gViolations{0}, gFrees{0}, gDriver{0};
+
+// Load addresses of the modules engine and game code live in, and of the
+// C/C++ runtime that sits between them and the hooks. Set once at warm-up.
+constexpr int kMaxModules = 8;
+const void* gOwnModules[kMaxModules];
+const void* gRuntimeModules[kMaxModules];
+int         gOwnCount = 0, gRuntimeCount = 0;
+
+thread_local const char* tTag = nullptr;
+thread_local bool        tAllowed = false;
+thread_local bool        tInHook = false;   // the tracker's own allocations aren't counted
+
+struct SpinLock {
+    SpinLock(){ while (gLock.test_and_set(std::memory_order_acquire)) {} }
+    ~SpinLock(){ gLock.clear(std::memory_order_release); }
+};
+
+TagStats& TagFor(const char* name){
+    const int n = gTagCount.load(std::memory_order_acquire);
+    for (int i = 0; i < n; ++i)
+        if (gTags[i].Name == name || std::strcmp(gTags[i].Name, name) == 0) return gTags[i];
+    SpinLock lock;
+    const int m = gTagCount.load(std::memory_order_relaxed);
+    for (int i = n; i < m; ++i)
+        if (std::strcmp(gTags[i].Name, name) == 0) return gTags[i];
+    if (m == kMaxTags) return gTags[kMaxTags - 1];   // lumped into the last one
+    gTags[m].Name = name;
+    gTagCount.store(m + 1, std::memory_order_release);
+    return gTags[m];
+}
+
+MADUS_NOINLINE int Capture(void** frames){
+#if defined(_WIN32)
+    return (int)CaptureStackBackTrace(kSkip, kDepth, frames, nullptr);
+#else
+    void* raw[kDepth + kSkip];
+    const int n = backtrace(raw, kDepth + kSkip);
+    const int d = std::max(0, n - kSkip);
+    std::memcpy(frames, raw + kSkip, sizeof(void*) * (size_t)d);
+    return d;
+#endif
+}
+
+#if defined(_WIN32)
+bool FromDriver(void* const*, int){ return false; }
+void FindModules(){}
+#else
+const void* ModuleOf(const void* addr){
+    Dl_info info{};
+    return dladdr(addr, &info) ? info.dli_fbase : nullptr;
+}
+bool Listed(const void* const* list, int n, const void* m){ return std::find(list, list + n, m) != list + n; }
+
+// The innermost frame outside libc/libstdc++ decides: if it isn't in one of
+// our own modules, the allocation was made by a library we called into.
+bool FromDriver(void* const* frames, int depth){
+    for (int i = 0; i < depth; ++i) {
+        const void* m = ModuleOf(frames[i]);
+        if (m && Listed(gRuntimeModules, gRuntimeCount, m)) continue;
+        return m && gOwnCount && !Listed(gOwnModules, gOwnCount, m);
+    }
+    return false;
+}
+
+// Called from the engine's frame loop: every module on that stack that
+// isn't the runtime is ours (the tracker, the engine, the executable).
+void FindModules(){
+    gRuntimeModules[gRuntimeCount++] = ModuleOf((const void*)&std::abort);             // libc
+    gRuntimeModules[gRuntimeCount++] = ModuleOf((const void*)&std::set_new_handler);   // libstdc++
+    void* frames[kDepth];
+    const int n = backtrace(frames, kDepth);
+    for (int i = 0; i < n && gOwnCount < kMaxModules; ++i) {
+        const void* m = ModuleOf(frames[i]);
+        if (m && !Listed(gRuntimeModules, gRuntimeCount, m) && !Listed(gOwnModules, gOwnCount, m)) gOwnModules[gOwnCount++] = m;
+    }
+}
+#endif
+
+void AddSite(void** frames, int depth, const char* tag, size_t bytes){
+    uint64_t h = 1469598103934665603ull;   // FNV-1a over the return addresses
+    for (int i = 0; i < depth; ++i) { h ^= (uint64_t)(uintptr_t)frames[i]; h *= 1099511628211ull; }
+    const uint64_t frame = gFrame.load(std::memory_order_relaxed);
+
+    SpinLock lock;
+    for (int i = 0; i < gSiteCount; ++i) {
+        Site& s = gSites[i];
+        if (s.Hash == h && s.Depth == depth && std::memcmp(s.Frames, frames, sizeof(void*) * (size_t)depth) == 0) {
+            ++s.Count; s.Bytes += bytes; s.LastFrame = frame;
+            return;
+        }
+    }
+    if (gSiteCount == kMaxSites) { ++gDroppedSites; return; }
+    Site& s = gSites[gSiteCount++];
+    s.Hash = h;
+    std::memcpy(s.Frames, frames, sizeof(void*) * (size_t)depth);
+    s.Depth = depth;
+    s.Tag = tag;
+    s.Count = 1; s.Bytes = bytes;
+    s.FirstFrame = s.LastFrame = frame;
+}
+
+MADUS_NOINLINE void Record(size_t bytes){
+    if (tInHook) return;
+    tInHook = true;
+    const char* tag = tTag ? tTag : "untagged";
+    TagStats& t = TagFor(tag);
+    t.Allocs.fetch_add(1, std::memory_order_relaxed);
+    t.Bytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (gArmed.load(std::memory_order_relaxed)) {
+        t.Steady.fetch_add(1, std::memory_order_relaxed);
+        if (!tAllowed) {
+            void* frames[kDepth];
+            const int depth = Capture(frames);
+            if (FromDriver(frames, depth)) {
+                gDriver.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                gViolations.fetch_add(1, std::memory_order_relaxed);
+                AddSite(frames, depth, tag, bytes);
+            }
+        }
+    }
+    tInHook = false;
+}
+
+void Freed(void* p){ if (p) gFrees.fetch_add(1, std::memory_order_relaxed); }
+}
+
+// ---- allocator hooks ----
+
+#if defined(__GLIBC__)
+// glibc's own entry points, so the replacements below can forward to them.
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void  __libc_free(void*);
+
+void* malloc(size_t n) noexcept { Record(n); return __libc_malloc(n); }
+void* calloc(size_t c, size_t n) noexcept { Record(c * n); return __libc_calloc(c, n); }
+void* realloc(void* p, size_t n) noexcept { Record(n); return __libc_realloc(p, n); }
+void  free(void* p) noexcept { Freed(p); __libc_free(p); }
+void* memalign(size_t a, size_t n) noexcept { Record(n); return __libc_memalign(a, n); }
+void* aligned_alloc(size_t a, size_t n) noexcept { Record(n); return __libc_memalign(a, n); }
+int   posix_memalign(void** out, size_t a, size_t n) noexcept {
+    Record(n);
+    void* p = __libc_memalign(a, n);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+}
+static void* RawAlloc(size_t n){ return __libc_malloc(n); }
+static void* RawAlignedAlloc(size_t n, size_t a){ return __libc_memalign(a, n); }
+static void  RawFree(void* p){ __libc_free(p); }
+static void  RawAlignedFree(void* p){ __libc_free(p); }
+#elif defined(_WIN32)
+// The CRT's malloc can't be replaced; only operator new/delete are tracked.
+static void* RawAlloc(size_t n){ return std::malloc(n); }
+static void* RawAlignedAlloc(size_t n, size_t a){ return _aligned_malloc(n, a); }
+static void  RawFree(void* p){ std::free(p); }
+static void  RawAlignedFree(void* p){ _aligned_free(p); }
+#else
+static void* RawAlloc(size_t n){ return std::malloc(n); }
+static void* RawAlignedAlloc(size_t n, size_t a){ return std::aligned_alloc(a, (n + a - 1) / a * a); }
+static void  RawFree(void* p){ std::free(p); }
+static void  RawAlignedFree(void* p){ std::free(p); }
+#endif
+
+// The remaining forms (arrays, nothrow) forward to these.
+void* operator new(size_t n){
+    Record(n);
+    if (void* p = RawAlloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t n, std::align_val_t a){
+    Record(n);
+    if (void* p = RawAlignedAlloc(n ? n : 1, (size_t)a)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { Freed(p); RawFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { Freed(p); RawAlignedFree(p); }
+void operator delete(void* p, size_t) noexcept { Freed(p); RawFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { Freed(p); RawAlignedFree(p); }
+
+// ---- API ----
+
+AllocTag::AllocTag(const char* name, bool allowed) : m_PrevName(tTag), m_PrevAllowed(tAllowed){
+    tTag = name;
+    tAllowed = allowed;
+}
+AllocTag::~AllocTag(){
+    tTag = m_PrevName;
+    tAllowed = m_PrevAllowed;
+}
+
+void AllocTracker_SetFrame(uint64_t frame, bool armed){
+    static bool warmed = false;
+    if (!warmed) {
+        // backtrace() loads its unwinder on first use; do that before arming.
+        tInHook = true;
+        void* frames[kDepth];
+        Capture(frames);
+        FindModules();
+        tInHook = false;
+        warmed = true;
+    }
+    gFrame.store(frame, std::memory_order_relaxed);
+    gArmed.store(armed, std::memory_order_relaxed);
+}
+
+uint64_t AllocTracker_Violations(){ return gViolations.load(std::memory_order_relaxed); }
+uint64_t AllocTracker_DriverAllocs(){ return gDriver.load(std::memory_order_relaxed); }
+
+void AllocTracker_Reset(){
+    SpinLock lock;
+    for (int i = 0; i < gTagCount.load(std::memory_order_relaxed); ++i) {
+        gTags[i].Allocs.store(0, std::memory_order_relaxed);
+        gTags[i].Bytes.store(0, std::memory_order_relaxed);
+        gTags[i].Steady.store(0, std::memory_order_relaxed);
+    }
+    gSiteCount = 0;
+    gDroppedSites = 0;
+    gViolations.store(0, std::memory_order_relaxed);
+    gDriver.store(0, std::memory_order_relaxed);
+    gFrees.store(0, std::memory_order_relaxed);
+}
+
+static void PrintFrame(FILE* out, int i, void* addr){
+#if defined(_WIN32)
+    std::fprintf(out, "      #%-2d %p\n", i, addr);
+#else
+    Dl_info info{};
+    if (dladdr(addr, &info) && info.dli_sname) {
+        int status = 0;
+        char* name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::fprintf(out, "      #%-2d %s+0x%zx (%s)\n", i, status == 0 ? name : info.dli_sname,
+                     (size_t)((char*)addr - (char*)info.dli_saddr), info.dli_fname ? info.dli_fname : "?");
+        std::free(name);
+    } else {
+        std::fprintf(out, "      #%-2d %p (%s)\n", i, addr, info.dli_fname ? info.dli_fname : "?");
+    }
+#endif
+}
+
+void AllocTracker_Report(FILE* out){
+    const bool wasInHook = tInHook;
+    tInHook = true;   // symbolizing allocates
+
+    std::fprintf(out, "\n[AllocTracker] %llu steady-state allocation(s) flagged, %llu in the driver, %llu frees, through frame %llu\n",
+                 (unsigned long long)gViolations.load(), (unsigned long long)gDriver.load(),
+                 (unsigned long long)gFrees.load(), (unsigned long long)gFrame.load());
+    std::fprintf(out, "  %-16s %12s %14s %10s\n", "tag", "allocs", "bytes", "steady");
+    const int tags = gTagCount.load(std::memory_order_acquire);
+    for (int i = 0; i < tags; ++i)
+        std::fprintf(out, "  %-16s %12llu %14llu %10llu\n", gTags[i].Name,
+                     (unsigned long long)gTags[i].Allocs.load(), (unsigned long long)gTags[i].Bytes.load(),
+                     (unsigned long long)gTags[i].Steady.load());
+
+    SpinLock lock;
+    static int order[kMaxSites];
+    for (int i = 0; i < gSiteCount; ++i) order[i] = i;
+    std::sort(order, order + gSiteCount, [](int a, int b){ return gSites[a].Count > gSites[b].Count; });
+    for (int k = 0; k < gSiteCount; ++k) {
+        const Site& s = gSites[order[k]];
+        std::fprintf(out, "  site %d: %llu alloc(s), %llu bytes, tag %s, frames %llu..%llu\n", k,
+                     (unsigned long long)s.Count, (unsigned long long)s.Bytes, s.Tag,
+                     (unsigned long long)s.FirstFrame, (unsigned long long)s.LastFrame);
+        for (int f = 0; f < s.Depth; ++f) PrintFrame(out, f, s.Frames[f]);
+    }
+    if (gDroppedSites) std::fprintf(out, "  (%llu more call sites not recorded)\n", (unsigned long long)gDroppedSites);
+    std::fflush(out);
+    tInHook = wasInHook;
+}
+
+#endif
@@ -1,6 +1,8 @@
 // Copyright Lukas Licon 2025, All Rights Reserved.
 
 #include "Madus/CharacterController.h"
+#include "Madus/Collision.h"
+#include "Madus/Profiler.h"
 #include <algorithm>
 #include <cmath>
 
@@ -9,8 +11,8 @@ static inline float Dot2D(const Vec3& a, const Vec3& b){ return a.x*b.x + a.z*b.
 static inline float Clamp(float x, float a, float b){ return std::max(a, std::min(b, x)); }
 static inline Vec3 ProjectAlongPlane(const Vec3& v, const Vec3& n){return Add(v, Mul(n, - (v.x*n.x + v.y*n.y + v.z*n.z)));}
 static inline float CosDeg(float d){ return std::cos(d * (float)MADUS_PI / 180.f); }
-inline float GetGroundY(const CharacterController& cc, float x, float z){ return cc.GroundHeight ? cc.GroundHeight(x,z) : cc.GroundY;}
-inline Vec3 GetGroundN(const CharacterController& cc, float x, float z){return cc.GroundNormal ? Normalize(cc.GroundNormal(x,z)) : Vec3{0,1,0};}
+static inline float GetGroundY(const CharacterController& cc, float x, float z){ return cc.Ground ? cc.Ground->Height(x,z) : cc.GroundY; }
+static inline Vec3  GetGroundN(const CharacterController& cc, float x, float z){ return cc.Ground ? cc.Ground->Normal(x,z) : Vec3{0,1,0}; }
 
 
 
@@ -54,7 +56,8 @@ static inline float Len2D(const Vec3& v){
 
 void CharacterController::Tick(const InputState& in, float dt, const Vec3& camFwd, const Vec3& camRight)
 {
-    //if (in.Jump) JumpBuf = BufferWindow;
+    MADUS_PROFILE_ZONE("CharacterController::Tick");
+    if (in.Jump) JumpBuf = BufferWindow;
     if (in.Dash) DashBuf = BufferWindow;
 
     Vec3 f = camFwd; f.y = 0; if (Length(f) > 0.0001f) f = Normalize(f);
@@ -156,24 +159,38 @@ void CharacterController::Tick(const InputState& in, float dt, const Vec3& camFw
         }
     }
 
-    Vec3 prevVel = Velocity;
-    Position = Add(Position, Mul(Velocity, dt));  
+    const float preX = Position.x, preZ = Position.z;
+    Position.y += Velocity.y * dt;
+    {
+        MADUS_PROFILE_ZONE("Collision::MoveAndSlideXZ");
+        MoveAndSlideXZ(Position, Velocity, dt, CapsuleRadius, Colliders, ColliderCount, SlideIterations);
+    }
 
     float horizSpeed = Len2D(Velocity);
     if (horizSpeed > 0.01f) {
         float newGy = GroundY;
-        Vec3  newGn = Vec3{0,1,0};
+        bool  canStep = Ground ? Ground->CanStepTo(Position.y - CapsuleHalfHeight, Position.x, Position.z, StepOffset, cosMax, &newGy)
+                               : (1.f >= cosMax);
         float desiredY = newGy + CapsuleHalfHeight;
         float rise = desiredY - Position.y;
-        auto CosDeg = [](float d){ return std::cos(d * (float)MADUS_PI / 180.f); };
-        if (rise > 0.f && rise <= StepOffset && newGn.y >= CosDeg(MaxSlopeDeg)) {
+        if (rise > 0.f && rise <= StepOffset && canStep) {
             Position.y = desiredY;
             if (Velocity.y < 0.f) Velocity.y = 0.f; 
             Grounded = true;
             OffGroundTime = 0.f;
+        } else if (Ground && rise > 0.f) {
+            // Too high or too steep to step onto: stay put and drop the uphill velocity.
+            Vec3 newGn = Ground->Normal(Position.x, Position.z);
+            Position.x = preX; Position.z = preZ;
+            float hl = std::sqrt(newGn.x*newGn.x + newGn.z*newGn.z);
+            if (hl > 1e-6f) {
+                float hx = newGn.x / hl, hz = newGn.z / hl;
+                float vn = Velocity.x*hx + Velocity.z*hz;
+                if (vn < 0.f) { Velocity.x -= vn*hx; Velocity.z -= vn*hz; }
+            }
         }
     }
-    float floorY = GroundY + CapsuleHalfHeight;
+    float floorY = GetGroundY(*this, Position.x, Position.z) + CapsuleHalfHeight;
     if (Position.y < floorY){
         Position.y = floorY;
         if (Velocity.y < 0.f) Velocity.y = 0.f;
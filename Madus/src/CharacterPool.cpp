@@ -0,0 +1,314 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/CharacterPool.h"
+#include "Madus/Collision.h"
+#include "Madus/Parallel.h"
+#include "Madus/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+// Every expression below mirrors CharacterController::Tick operation for
+// operation; keep them in sync or the pool stops matching the scalar path.
+
+enum : uint8_t { kModeDashing = 0, kModeDashStart = 1, kModeLocomotion = 2 };
+
+void CharacterPool::Reserve(size_t n){
+    for (auto* v : { &PosX, &PosY, &PosZ, &VelX, &VelY, &VelZ, &OnGroundTime, &OffGroundTime,
+                     &DashTimer, &DashCDTimer, &JumpBuf, &DashBuf, &WishX, &WishZ, &WishLen, &FwdX, &FwdZ,
+                     &GroundH, &GroundNX, &GroundNY, &GroundNZ, &PreX, &PreZ })
+        v->reserve(n);
+    for (auto* v : { &Grounded, &Invulnerable, &State, &DashIn, &JumpIn, &Mode }) v->reserve(n);
+}
+
+void CharacterPool::Clear(){
+    for (auto* v : { &PosX, &PosY, &PosZ, &VelX, &VelY, &VelZ, &OnGroundTime, &OffGroundTime,
+                     &DashTimer, &DashCDTimer, &JumpBuf, &DashBuf, &WishX, &WishZ, &WishLen, &FwdX, &FwdZ,
+                     &GroundH, &GroundNX, &GroundNY, &GroundNZ, &PreX, &PreZ })
+        v->clear();
+    for (auto* v : { &Grounded, &Invulnerable, &State, &DashIn, &JumpIn, &Mode }) v->clear();
+}
+
+size_t CharacterPool::Spawn(const CharacterController& c){
+    PosX.push_back(c.Position.x); PosY.push_back(c.Position.y); PosZ.push_back(c.Position.z);
+    VelX.push_back(c.Velocity.x); VelY.push_back(c.Velocity.y); VelZ.push_back(c.Velocity.z);
+    OnGroundTime.push_back(c.OnGroundTime); OffGroundTime.push_back(c.OffGroundTime);
+    DashTimer.push_back(c.DashTimer); DashCDTimer.push_back(c.DashCDTimer);
+    JumpBuf.push_back(c.JumpBuf); DashBuf.push_back(c.DashBuf);
+    Grounded.push_back(c.Grounded); Invulnerable.push_back(c.Invulnerable);
+    State.push_back((uint8_t)c.State);
+    WishX.push_back(0.f); WishZ.push_back(0.f); WishLen.push_back(0.f);
+    FwdX.push_back(0.f); FwdZ.push_back(0.f); DashIn.push_back(0); JumpIn.push_back(0);
+    Mode.push_back(kModeLocomotion);
+    for (auto* v : { &GroundH, &GroundNX, &GroundNY, &GroundNZ, &PreX, &PreZ }) v->push_back(0.f);
+    return PosX.size() - 1;
+}
+
+void CharacterPool::SetInput(size_t i, const InputState& in, const Vec3& camFwd, const Vec3& camRight){
+    Vec3 f = camFwd; f.y = 0; if (Length(f) > 0.0001f) f = Normalize(f);
+    Vec3 r = camRight; r.y = 0; if (Length(r) > 0.0001f) r = Normalize(r);
+    Vec3 wish = Add(Mul(f, in.MoveZ), Mul(r, in.MoveX));
+    float s = wish.x * wish.x + wish.z * wish.z;
+    float wishLen = (s > 0.f) ? std::sqrt(s) : 0.f;
+    if (wishLen > 1.f) wish = Mul(wish, 1.f / wishLen);
+
+    WishX[i] = wish.x; WishZ[i] = wish.z; WishLen[i] = wishLen;
+    FwdX[i] = f.x; FwdZ[i] = f.z;
+    DashIn[i] = in.Dash ? 1 : 0;
+    JumpIn[i] = in.Jump ? 1 : 0;
+}
+
+void CharacterPool::CopyTo(size_t i, CharacterController& c) const {
+    c.Position = {PosX[i], PosY[i], PosZ[i]};
+    c.Velocity = {VelX[i], VelY[i], VelZ[i]};
+    c.OnGroundTime = OnGroundTime[i]; c.OffGroundTime = OffGroundTime[i];
+    c.DashTimer = DashTimer[i]; c.DashCDTimer = DashCDTimer[i];
+    c.JumpBuf = JumpBuf[i]; c.DashBuf = DashBuf[i];
+    c.Grounded = Grounded[i] != 0; c.Invulnerable = Invulnerable[i] != 0;
+    c.State = (EPlayerState)State[i];
+}
+
+void CharacterPool::Tick(float dt, int workers){
+    MADUS_PROFILE_ZONE("CharacterPool::Tick");
+    if (workers <= 1) { TickRange(0, Size(), dt); return; }
+    ParallelFor(Size(), 1024, [this, dt](size_t b, size_t e){ TickRange(b, e, dt); }, workers);
+}
+
+void CharacterPool::TickRange(size_t begin, size_t end, float dt){
+    const CharacterController& P = Archetype;
+    const Heightfield* hf = P.Ground;
+    const size_t n = end - begin;
+    const float cosMax = std::cos(P.MaxSlopeDeg * (float)MADUS_PI / 180.f);
+
+    float* __restrict px = PosX.data() + begin;
+    float* __restrict py = PosY.data() + begin;
+    float* __restrict pz = PosZ.data() + begin;
+    float* __restrict vx = VelX.data() + begin;
+    float* __restrict vy = VelY.data() + begin;
+    float* __restrict vz = VelZ.data() + begin;
+    float* __restrict onT  = OnGroundTime.data() + begin;
+    float* __restrict offT = OffGroundTime.data() + begin;
+    float* __restrict dashT  = DashTimer.data() + begin;
+    float* __restrict dashCD = DashCDTimer.data() + begin;
+    float* __restrict jumpB  = JumpBuf.data() + begin;
+    float* __restrict dashB  = DashBuf.data() + begin;
+    uint8_t* __restrict grounded = Grounded.data() + begin;
+    uint8_t* __restrict invul    = Invulnerable.data() + begin;
+    uint8_t* __restrict state    = State.data() + begin;
+    uint8_t* __restrict mode     = Mode.data() + begin;
+    const float* __restrict wx = WishX.data() + begin;
+    const float* __restrict wz = WishZ.data() + begin;
+    const float* __restrict wl = WishLen.data() + begin;
+    const uint8_t* __restrict dashIn = DashIn.data() + begin;
+    const uint8_t* __restrict jumpIn = JumpIn.data() + begin;
+    float* __restrict gh  = GroundH.data() + begin;
+    float* __restrict gnx = GroundNX.data() + begin;
+    float* __restrict gny = GroundNY.data() + begin;
+    float* __restrict gnz = GroundNZ.data() + begin;
+    float* __restrict preX = PreX.data() + begin;
+    float* __restrict preZ = PreZ.data() + begin;
+
+    // --- Phase 1: input buffers and cooldowns ---
+    for (size_t i = 0; i < n; ++i) {
+        const float db = dashIn[i] ? P.BufferWindow : dashB[i];
+        const float jb = jumpIn[i] ? P.BufferWindow : jumpB[i];
+        dashCD[i] = std::max(0.f, dashCD[i] - dt);
+        jumpB[i]  = std::max(0.f, jb        - dt);
+        dashB[i]  = std::max(0.f, db        - dt);
+    }
+
+    // --- Phase 2: ground contact ---
+    if (hf) {
+        hf->SampleHeights(px, pz, gh, n);
+        hf->SampleNormals(px, pz, gnx, gny, gnz, n);
+    } else {
+        std::fill(gh, gh + n, P.GroundY);
+        std::fill(gnx, gnx + n, 0.f); std::fill(gny, gny + n, 1.f); std::fill(gnz, gnz + n, 0.f);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const bool walkable = (gny[i] >= cosMax);
+        const float desiredY = gh[i] + P.CapsuleHalfHeight;
+        const bool g = (py[i] - P.CapsuleHalfHeight <= gh[i] + P.GroundSnap) && (vy[i] <= 0.f) && walkable;
+        grounded[i] = g;
+        const bool snap = g && (py[i] != desiredY);
+        const float y  = snap ? desiredY : py[i];
+        const float v  = (snap && vy[i] < 0.f) ? 0.f : vy[i];
+        const float d  = vx[i]*gnx[i] + v*gny[i] + vz[i]*gnz[i];
+        vx[i]   = g ? vx[i] + gnx[i] * (-d) : vx[i];
+        vz[i]   = g ? vz[i] + gnz[i] * (-d) : vz[i];
+        vy[i]   = g ? 0.f : v;
+        py[i]   = y;
+        onT[i]  = g ? onT[i] + dt : 0.f;
+        offT[i] = g ? 0.f : offT[i] + dt;
+    }
+
+    // --- Phase 3: gravity (quarter strength while dashing, none on the dash start tick) ---
+    {
+        const float gdt = P.Gravity * dt;
+        const float gdtDash = gdt * 0.25f;
+        for (size_t i = 0; i < n; ++i) {
+            const bool dashing  = dashT[i] > 0.f;
+            const bool starting = !dashing && dashB[i] > 0.f && dashCD[i] <= 0.f;
+            const float g = dashing ? gdtDash : (starting ? 0.f : gdt);
+            vy[i] = (dashing || !starting) ? vy[i] - g : vy[i];
+            mode[i] = dashing ? kModeDashing : (starting ? kModeDashStart : kModeLocomotion);
+        }
+    }
+
+    // --- Phase 4: dash / jump state machine (branchy, scalar) ---
+    for (size_t i = 0; i < n; ++i) {
+        const size_t a = begin + i;
+        if (mode[i] == kModeDashing) {
+            dashT[i] -= dt;
+            float frac = 1.f - (dashT[i] / P.DashTime);
+            invul[i] = (frac >= P.DashIFrameBeg && frac <= P.DashIFrameEnd);
+            if (dashT[i] <= 0.f) {
+                invul[i] = false;
+                const float damp = 0.35f;
+                vx[i] *= damp;
+                vz[i] *= damp;
+                state[i] = (uint8_t)(grounded[i] ? EPlayerState::Idle : EPlayerState::Fall);
+            } else {
+                state[i] = (uint8_t)EPlayerState::Dash;
+            }
+        } else if (mode[i] == kModeDashStart) {
+            Vec3 dir = (wl[i] > 0.1f) ? Vec3{wx[i], 0.f, wz[i]} : Vec3{FwdX[a], 0.f, FwdZ[a]};
+            if (Length(dir) < 1e-4f) dir = Vec3{1,0,0};
+            dir = Normalize(dir);
+            vx[i] = dir.x * P.DashSpeed;
+            vz[i] = dir.z * P.DashSpeed;
+            dashT[i]  = P.DashTime;
+            dashCD[i] = P.DashCooldown + P.DashTime;
+            invul[i] = true;
+            state[i] = (uint8_t)EPlayerState::Dash;
+            dashB[i] = 0.f;
+        } else {
+            const bool canJump = (grounded[i] || offT[i] <= P.CoyoteTime);
+            if (jumpB[i] > 0.f && canJump) {
+                vy[i] = P.JumpSpeed;
+                grounded[i] = false;
+                offT[i] = 0.f;
+                jumpB[i] = 0.f;
+            }
+            const bool moving = wl[i] > 0.001f;
+            const EPlayerState air = (vy[i] > 0.f) ? EPlayerState::Jump : EPlayerState::Fall;
+            state[i] = (uint8_t)(grounded[i] ? (moving ? EPlayerState::Move : EPlayerState::Idle) : air);
+        }
+    }
+
+    // --- Phase 5: accelerate toward the wish direction, clamp to max speed ---
+    {
+        const float accG = P.AccelGround * dt, accA = P.AccelAir * dt;
+        for (size_t i = 0; i < n; ++i) {
+            const bool  m      = (mode[i] == kModeLocomotion) && (wl[i] > 0.001f);
+            const bool  g      = grounded[i] != 0;
+            const float target = g ? P.MaxSpeedGround : P.MaxSpeedAir;
+            const float step0  = g ? accG : accA;
+            const float cur    = vx[i]*wx[i] + vz[i]*wz[i];
+            const float add    = target - cur;
+            const float step   = std::min(step0, add);
+            const bool  doAdd  = m && (add > 0.f);
+            float x = doAdd ? vx[i] + wx[i] * step : vx[i];
+            float z = doAdd ? vz[i] + wz[i] * step : vz[i];
+            const float sp = std::sqrt(x*x + z*z);
+            const float s  = target / sp;
+            const bool  clamp = m && (sp > target);
+            vx[i] = clamp ? x * s : x;
+            vz[i] = clamp ? z * s : z;
+        }
+    }
+
+    // --- Phase 6: braking on the ground, light drag in the air ---
+    {
+        const float brake = P.BrakeDecel * dt;
+        const float drop  = (P.Friction * 0.2f) * dt;
+        const float eps   = P.StopSpeedEpsilon;
+        for (size_t i = 0; i < n; ++i) {
+            const bool  m     = (mode[i] == kModeLocomotion) && !(wl[i] > 0.001f);
+            const float speed = std::sqrt(vx[i]*vx[i] + vz[i]*vz[i]);
+
+            const float bn = std::max(0.f, speed - brake);
+            const float bs = (speed > 0.f) ? (bn / speed) : 0.f;
+            const bool  bz = (speed <= eps) || (bn <= eps);
+
+            const float fn = std::max(0.f, speed - drop);
+            const bool  fz = speed <= 1e-4f;
+            const bool  fs = fn != speed;
+            const float fsc = fn / speed;
+
+            const bool g = grounded[i] != 0;
+            const float bx = bz ? 0.f : vx[i] * bs, bzz = bz ? 0.f : vz[i] * bs;
+            const float fx = fz ? 0.f : (fs ? vx[i] * fsc : vx[i]);
+            const float fzz = fz ? 0.f : (fs ? vz[i] * fsc : vz[i]);
+            vx[i] = m ? (g ? bx  : fx)  : vx[i];
+            vz[i] = m ? (g ? bzz : fzz) : vz[i];
+        }
+    }
+
+    // --- Phase 7: integrate ---
+    std::copy(px, px + n, preX);
+    std::copy(pz, pz + n, preZ);
+    for (size_t i = 0; i < n; ++i) py[i] += vy[i] * dt;
+    if (P.ColliderCount == 0) {
+        for (size_t i = 0; i < n; ++i) { px[i] += vx[i] * dt; pz[i] += vz[i] * dt; }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            Vec3 pos{px[i], py[i], pz[i]}, vel{vx[i], vy[i], vz[i]};
+            MoveAndSlideXZ(pos, vel, dt, P.CapsuleRadius, P.Colliders, P.ColliderCount, P.SlideIterations);
+            px[i] = pos.x; pz[i] = pos.z;
+            vx[i] = vel.x; vz[i] = vel.z;
+        }
+    }
+
+    // --- Phase 8: step-up and floor clamp ---
+    if (!hf) {
+        const float floorY = P.GroundY + P.CapsuleHalfHeight;
+        const bool  stepWalkable = (1.f >= cosMax);
+        for (size_t i = 0; i < n; ++i) {
+            const float s2 = vx[i]*vx[i] + vz[i]*vz[i];
+            const float horiz = (s2 > 0.f) ? std::sqrt(s2) : 0.f;
+            const float rise = floorY - py[i];
+            const bool  step = (horiz > 0.01f) && (rise > 0.f) && (rise <= P.StepOffset) && stepWalkable;
+            const bool  below = step || (py[i] < floorY);
+            py[i]   = below ? floorY : py[i];
+            vy[i]   = (below && vy[i] < 0.f) ? 0.f : vy[i];
+            grounded[i] = below ? 1 : grounded[i];
+            offT[i] = below ? 0.f : offT[i];
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        const float s2 = vx[i]*vx[i] + vz[i]*vz[i];
+        const float horiz = (s2 > 0.f) ? std::sqrt(s2) : 0.f;
+        if (horiz > 0.01f) {
+            float newGy = P.GroundY;
+            const bool canStep = hf->CanStepTo(py[i] - P.CapsuleHalfHeight, px[i], pz[i], P.StepOffset, cosMax, &newGy);
+            const float desiredY = newGy + P.CapsuleHalfHeight;
+            const float rise = desiredY - py[i];
+            if (rise > 0.f && rise <= P.StepOffset && canStep) {
+                py[i] = desiredY;
+                if (vy[i] < 0.f) vy[i] = 0.f;
+                grounded[i] = 1;
+                offT[i] = 0.f;
+            } else if (rise > 0.f) {
+                const Vec3 nrm = hf->Normal(px[i], pz[i]);
+                px[i] = preX[i]; pz[i] = preZ[i];
+                const float hl = std::sqrt(nrm.x*nrm.x + nrm.z*nrm.z);
+                if (hl > 1e-6f) {
+                    const float hx = nrm.x / hl, hz = nrm.z / hl;
+                    const float vn = vx[i]*hx + vz[i]*hz;
+                    if (vn < 0.f) { vx[i] -= vn*hx; vz[i] -= vn*hz; }
+                }
+            }
+        }
+    }
+    hf->SampleHeights(px, pz, gh, n);
+    for (size_t i = 0; i < n; ++i) {
+        const float floorY = gh[i] + P.CapsuleHalfHeight;
+        const bool  below = py[i] < floorY;
+        py[i]   = below ? floorY : py[i];
+        vy[i]   = (below && vy[i] < 0.f) ? 0.f : vy[i];
+        grounded[i] = below ? 1 : grounded[i];
+        offT[i] = below ? 0.f : offT[i];
+    }
+}
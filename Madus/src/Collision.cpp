@@ -0,0 +1,177 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Collision.h"
+#include <algorithm>
+#include <cmath>
+
+bool ResolveCircleAABB2(Vec3& pos, Vec3& vel, float radius, const AABB2& b)
+{
+    float qx = std::min(std::max(pos.x, b.minx), b.maxx);
+    float qz = std::min(std::max(pos.z, b.minz), b.maxz);
+    float dx = pos.x - qx;
+    float dz = pos.z - qz;
+    float d2 = dx*dx + dz*dz;
+
+    if (d2 > 0.0f) {
+        float r = radius;
+        if (d2 < r*r) {
+            float d = std::sqrt(d2);
+            float nx = dx / d, nz = dz / d;
+            float push = (r - d);
+            pos.x += nx * push; pos.z += nz * push;
+            float vn = vel.x*nx + vel.z*nz;
+            if (vn < 0.f) { vel.x -= vn*nx; vel.z -= vn*nz; }
+            return true;
+        }
+        return false;
+    } else {
+        float left   = pos.x - b.minx;
+        float right  = b.maxx - pos.x;
+        float down   = pos.z - b.minz;
+        float up     = b.maxz - pos.z;
+        float minX = std::min(left, right);
+        float minZ = std::min(down, up);
+        if (minX < minZ) {
+            float nx = (left < right) ? -1.f : 1.f;
+            float push = minX + radius;
+            pos.x += nx * push;
+            float vn = vel.x*nx;
+            if (vn < 0.f) vel.x -= vn*nx;
+        } else {
+            float nz = (down < up) ? -1.f : 1.f;
+            float push = minZ + radius;
+            pos.z += nz * push;
+            float vn = vel.z*nz;
+            if (vn < 0.f) vel.z -= vn*nz;
+        }
+        return true;
+    }
+}
+
+// Ray (origin o, direction d, t in [0,1]) vs circle; earliest entry.
+static bool RayCircle(float ox, float oz, float dx, float dz, float cx, float cz, float r, float& t)
+{
+    const float mx = ox - cx, mz = oz - cz;
+    const float a = dx*dx + dz*dz;
+    const float b = mx*dx + mz*dz;
+    const float c = mx*mx + mz*mz - r*r;
+    if (a <= 1e-12f) return false;
+    const float disc = b*b - a*c;
+    if (disc < 0.f) return false;
+    t = (-b - std::sqrt(disc)) / a;
+    return t >= 0.f && t <= 1.f;
+}
+
+bool SweepCircleAABB2(const Vec3& pos, float dx, float dz, float radius, const AABB2& b, SweepHit& hit)
+{
+    // Already touching: block only motion that goes deeper.
+    const float qx = std::clamp(pos.x, b.minx, b.maxx);
+    const float qz = std::clamp(pos.z, b.minz, b.maxz);
+    const float ox = pos.x - qx, oz = pos.z - qz;
+    const float o2 = ox*ox + oz*oz;
+    if (o2 < radius*radius) {
+        float nx, nz;
+        if (o2 > 1e-12f) {
+            const float d = std::sqrt(o2);
+            nx = ox / d; nz = oz / d;
+        } else {
+            const float left = pos.x - b.minx, right = b.maxx - pos.x;
+            const float down = pos.z - b.minz, up    = b.maxz - pos.z;
+            if (std::min(left, right) < std::min(down, up)) { nx = (left < right) ? -1.f : 1.f; nz = 0.f; }
+            else                                            { nz = (down < up)    ? -1.f : 1.f; nx = 0.f; }
+        }
+        if (dx*nx + dz*nz >= 0.f) return false;
+        hit.t = 0.f; hit.nx = nx; hit.nz = nz;
+        return true;
+    }
+
+    // Slab test against the box grown by radius.
+    const float ex0 = b.minx - radius, ex1 = b.maxx + radius;
+    const float ez0 = b.minz - radius, ez1 = b.maxz + radius;
+    float tMin = 0.f, tMax = 1.f;
+    float nx = 0.f, nz = 0.f;
+
+    if (std::fabs(dx) < 1e-12f) {
+        if (pos.x < ex0 || pos.x > ex1) return false;
+    } else {
+        const float inv = 1.f / dx;
+        float t0 = (ex0 - pos.x) * inv, t1 = (ex1 - pos.x) * inv;
+        float n = -1.f;
+        if (t0 > t1) { std::swap(t0, t1); n = 1.f; }
+        if (t0 > tMin) { tMin = t0; nx = n; nz = 0.f; }
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return false;
+    }
+    if (std::fabs(dz) < 1e-12f) {
+        if (pos.z < ez0 || pos.z > ez1) return false;
+    } else {
+        const float inv = 1.f / dz;
+        float t0 = (ez0 - pos.z) * inv, t1 = (ez1 - pos.z) * inv;
+        float n = -1.f;
+        if (t0 > t1) { std::swap(t0, t1); n = 1.f; }
+        if (t0 > tMin) { tMin = t0; nz = n; nx = 0.f; }
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return false;
+    }
+
+    // Entry point in a corner region of the grown box: the real shape there
+    // is the rounded corner, so retest against that circle.
+    const float hx = pos.x + dx * tMin, hz = pos.z + dz * tMin;
+    const bool outX = (hx < b.minx) || (hx > b.maxx);
+    const bool outZ = (hz < b.minz) || (hz > b.maxz);
+    if (outX && outZ) {
+        const float cx = (hx < b.minx) ? b.minx : b.maxx;
+        const float cz = (hz < b.minz) ? b.minz : b.maxz;
+        float t;
+        if (!RayCircle(pos.x, pos.z, dx, dz, cx, cz, radius, t)) return false;
+        tMin = t;
+        nx = (pos.x + dx * t - cx) / radius;
+        nz = (pos.z + dz * t - cz) / radius;
+    }
+
+    hit.t = tMin; hit.nx = nx; hit.nz = nz;
+    return true;
+}
+
+static SweepHit FirstHit(const Vec3& pos, float dx, float dz, float radius, const AABB2* colliders, size_t count){
+    SweepHit best;
+    for (size_t i = 0; i < count; ++i) {
+        SweepHit h;
+        if (SweepCircleAABB2(pos, dx, dz, radius, colliders[i], h) && h.t < best.t) {
+            best = h; best.index = (int)i;
+        }
+    }
+    return best;
+}
+
+void MoveAndSlideXZ(Vec3& pos, Vec3& vel, float dt, float radius,
+                    const AABB2* colliders, size_t count, int iterations, float skin)
+{
+    float dx = vel.x * dt, dz = vel.z * dt;
+
+    for (int it = 0; it < std::max(iterations, 1) && (dx != 0.f || dz != 0.f); ++it) {
+        const SweepHit best = FirstHit(pos, dx, dz, radius, colliders, count);
+        if (best.index < 0) { pos.x += dx; pos.z += dz; dx = dz = 0.f; break; }
+
+        // Advance to the contact, backed off by the skin so we stay outside.
+        const float len = std::sqrt(dx*dx + dz*dz);
+        const float t = std::max(0.f, best.t - skin / len);
+        pos.x += dx * t; pos.z += dz * t;
+
+        // Slide: drop the normal component of the remaining move and of the velocity.
+        dx *= (1.f - t); dz *= (1.f - t);
+        const float dn = dx*best.nx + dz*best.nz;
+        if (dn < 0.f) { dx -= dn*best.nx; dz -= dn*best.nz; }
+        const float vn = vel.x*best.nx + vel.z*best.nz;
+        if (vn < 0.f) { vel.x -= vn*best.nx; vel.z -= vn*best.nz; }
+    }
+
+    // Out of slides: take what's left of the move up to the next contact and stop there.
+    if (dx != 0.f || dz != 0.f) {
+        const SweepHit best = FirstHit(pos, dx, dz, radius, colliders, count);
+        const float t = best.index < 0 ? 1.f : std::max(0.f, best.t - skin / std::sqrt(dx*dx + dz*dz));
+        pos.x += dx * t; pos.z += dz * t;
+    }
+
+    for (size_t i = 0; i < count; ++i) ResolveCircleAABB2(pos, vel, radius, colliders[i]);
+}
@@ -0,0 +1,189 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/ECS.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace {
+struct ComponentInfo { size_t size, align; const char* name; };
+std::mutex                 gComponentMutex;
+std::vector<ComponentInfo> gComponents;
+
+constexpr size_t kChunkAlign = 64;
+
+size_t AlignUp(size_t v, size_t a){ return (v + a - 1) & ~(a - 1); }
+}
+
+ComponentId Ecs_RegisterComponent(size_t size, size_t align, const char* name){
+    std::lock_guard<std::mutex> lock(gComponentMutex);
+    if (gComponents.size() >= ECS_MAX_COMPONENTS) {
+        std::fprintf(stderr, "[ECS] More than %u component types (registering %s)\n", ECS_MAX_COMPONENTS, name);
+        std::abort();
+    }
+    gComponents.push_back({ size, align, name });
+    return (ComponentId)(gComponents.size() - 1);
+}
+
+size_t Ecs_ComponentSize(ComponentId id){ std::lock_guard<std::mutex> lock(gComponentMutex); return gComponents[id].size; }
+size_t Ecs_ComponentAlign(ComponentId id){ std::lock_guard<std::mutex> lock(gComponentMutex); return gComponents[id].align; }
+
+EcsWorld::EcsWorld() : m_ChunkPool(ECS_CHUNK_BYTES, kChunkAlign, 8) { GetArchetype(0); }
+
+EcsWorld::~EcsWorld(){
+    for (auto& a : m_Archetypes)
+        for (EcsChunk& c : a->Chunks) FreeChunk(*a, c.Data);
+}
+
+void EcsWorld::Clear(){
+    for (auto& a : m_Archetypes) {
+        for (EcsChunk& c : a->Chunks) FreeChunk(*a, c.Data);
+        a->Chunks.clear();
+    }
+    for (uint32_t i = 0; i < m_Records.size(); ++i)
+        if (m_Records[i].Arch) { m_Records[i].Arch = nullptr; ++m_Records[i].Gen; m_Free.push_back(i); }
+    m_Alive = 0;
+}
+
+// Lays the chunk out as [Entity x cap][T0 x cap][T1 x cap]..., each array
+// aligned for its type, with cap as large as fits in ECS_CHUNK_BYTES.
+EcsArchetype* EcsWorld::GetArchetype(uint64_t mask){
+    auto it = m_ByMask.find(mask);
+    if (it != m_ByMask.end()) return it->second;
+
+    auto a = std::make_unique<EcsArchetype>();
+    a->Mask = mask;
+    std::memset(a->ColumnOf, -1, sizeof(a->ColumnOf));
+    size_t rowBytes = sizeof(Entity), slack = 16;   // worst-case padding between arrays
+    for (ComponentId id = 0; id < ECS_MAX_COMPONENTS; ++id)
+        if (mask & (1ull << id)) {
+            a->ColumnOf[id] = (int8_t)a->Types.size();
+            a->Types.push_back(id);
+            a->Sizes.push_back((uint32_t)Ecs_ComponentSize(id));
+            rowBytes += Ecs_ComponentSize(id);
+            slack += Ecs_ComponentAlign(id);
+        }
+    a->Capacity = (uint32_t)std::max<size_t>(1, (ECS_CHUNK_BYTES - slack) / rowBytes);
+
+    size_t off = AlignUp(sizeof(Entity) * a->Capacity, 16);
+    for (size_t t = 0; t < a->Types.size(); ++t) {
+        off = AlignUp(off, Ecs_ComponentAlign(a->Types[t]));
+        a->Offsets.push_back((uint32_t)off);
+        off += (size_t)a->Sizes[t] * a->Capacity;
+    }
+    a->ChunkBytes = std::max(AlignUp(off, kChunkAlign), ECS_CHUNK_BYTES);
+
+    EcsArchetype* raw = a.get();
+    m_Archetypes.push_back(std::move(a));
+    m_ByMask[mask] = raw;
+    return raw;
+}
+
+// New archetypes are appended, so a cached query only scans the ones it hasn't seen.
+const std::vector<EcsArchetype*>& EcsWorld::Match(uint64_t required){
+    QueryCache& q = m_Queries[required];
+    for (; q.Seen < m_Archetypes.size(); ++q.Seen)
+        if ((m_Archetypes[q.Seen]->Mask & required) == required) q.Archetypes.push_back(m_Archetypes[q.Seen].get());
+    return q.Archetypes;
+}
+
+void EcsWorld::AllocRow(EcsArchetype& a, uint32_t& chunk, uint32_t& row){
+    if (a.Chunks.empty() || a.Chunks.back().Count == a.Capacity) {
+        EcsChunk c;
+        c.Data = AllocChunk(a);
+        a.Chunks.push_back(c);
+    }
+    chunk = (uint32_t)a.Chunks.size() - 1;
+    row = a.Chunks.back().Count++;
+}
+
+// Standard chunks come from the pool; only archetypes whose single row
+// exceeds ECS_CHUNK_BYTES go to the heap.
+unsigned char* EcsWorld::AllocChunk(const EcsArchetype& a){
+    if (a.ChunkBytes == ECS_CHUNK_BYTES) return static_cast<unsigned char*>(m_ChunkPool.Alloc());
+    return static_cast<unsigned char*>(::operator new(a.ChunkBytes, std::align_val_t(kChunkAlign)));
+}
+
+void EcsWorld::FreeChunk(const EcsArchetype& a, unsigned char* data){
+    if (a.ChunkBytes == ECS_CHUNK_BYTES) m_ChunkPool.Free(data);
+    else ::operator delete(data, std::align_val_t(kChunkAlign));
+}
+
+// Fills the hole with the archetype's last row so chunks stay packed.
+void EcsWorld::FreeRow(EcsArchetype& a, uint32_t chunk, uint32_t row){
+    const uint32_t lastChunk = (uint32_t)a.Chunks.size() - 1;
+    EcsChunk& last = a.Chunks[lastChunk];
+    const uint32_t lastRow = last.Count - 1;
+    if (chunk != lastChunk || row != lastRow) {
+        EcsChunk& dst = a.Chunks[chunk];
+        const Entity moved = a.Entities(last)[lastRow];
+        a.Entities(dst)[row] = moved;
+        for (size_t t = 0; t < a.Types.size(); ++t) {
+            const size_t sz = a.Sizes[t];
+            std::memcpy(dst.Data + a.Offsets[t] + sz * row, last.Data + a.Offsets[t] + sz * lastRow, sz);
+        }
+        m_Records[moved.Index].Chunk = chunk;
+        m_Records[moved.Index].Row = row;
+    }
+    if (--last.Count == 0) {
+        FreeChunk(a, last.Data);
+        a.Chunks.pop_back();
+    }
+}
+
+Entity EcsWorld::Create(){
+    uint32_t index;
+    if (!m_Free.empty()) { index = m_Free.back(); m_Free.pop_back(); }
+    else { index = (uint32_t)m_Records.size(); m_Records.emplace_back(); }
+    Record& r = m_Records[index];
+    r.Arch = m_Archetypes[0].get();
+    AllocRow(*r.Arch, r.Chunk, r.Row);
+    const Entity e{ index, r.Gen };
+    r.Arch->Entities(r.Arch->Chunks[r.Chunk])[r.Row] = e;
+    ++m_Alive;
+    return e;
+}
+
+void EcsWorld::Destroy(Entity e){
+    if (!IsAlive(e)) return;
+    Record& r = m_Records[e.Index];
+    EcsArchetype* a = r.Arch;
+    const uint32_t chunk = r.Chunk, row = r.Row;
+    r.Arch = nullptr;
+    ++r.Gen;
+    m_Free.push_back(e.Index);
+    --m_Alive;
+    FreeRow(*a, chunk, row);
+}
+
+// Copies the components both archetypes share; new ones are left for Add to construct.
+void EcsWorld::MoveTo(Entity e, uint64_t newMask){
+    assert(IsAlive(e));
+    Record& r = m_Records[e.Index];
+    EcsArchetype* from = r.Arch;
+    EcsArchetype* to = GetArchetype(newMask);
+    uint32_t chunk, row;
+    AllocRow(*to, chunk, row);
+    EcsChunk& src = from->Chunks[r.Chunk];
+    EcsChunk& dst = to->Chunks[chunk];
+    to->Entities(dst)[row] = e;
+    for (size_t t = 0; t < to->Types.size(); ++t) {
+        const int sc = from->ColumnOf[to->Types[t]];
+        if (sc < 0) continue;
+        const size_t sz = to->Sizes[t];
+        std::memcpy(dst.Data + to->Offsets[t] + sz * row, src.Data + from->Offsets[sc] + sz * r.Row, sz);
+    }
+    const uint32_t oldChunk = r.Chunk, oldRow = r.Row;
+    r.Arch = to; r.Chunk = chunk; r.Row = row;
+    FreeRow(*from, oldChunk, oldRow);
+}
+
+void* EcsWorld::Ptr(Entity e, ComponentId id) const {
+    const Record& r = m_Records[e.Index];
+    const EcsArchetype& a = *r.Arch;
+    const int col = a.ColumnOf[id];
+    return a.Chunks[r.Chunk].Data + a.Offsets[col] + (size_t)a.Sizes[col] * r.Row;
+}
@@ -1,36 +1,78 @@
 // Copyright Lukas Licon 2025, All Rights Reserved.
 
 #include "Madus/Engine.h"
+#include "Madus/AllocTracker.h"
 #include "Madus/App.h"
+#include "Madus/Headless.h"
+#include "Madus/Jobs.h"
+#include "Madus/GpuProfiler.h"
+#include "Madus/Renderer.h"
+#include "Madus/ResourceMemory.h"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
-#include <cassert>
 
 namespace madus {
 
+// Steady, and the clock Input_Now() stamps events with.
 static double NowSeconds() {
-    using clock = std::chrono::high_resolution_clock;
+    using clock = std::chrono::steady_clock;
     return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
 }
 
-Engine::Engine(const EngineConfig& cfg, IApp* app) : m(new Impl), m_App(app) {
-    const bool ok = InitPlatform(cfg);
-    assert(ok && "Madus: platform init failed");
-    m_LastTime = NowSeconds();
-    if (m_App) m_App->OnStartup();
+Engine::Engine(const EngineConfig& cfg, IApp* app) : m(new Impl(cfg.frameArenaBytes)), m_App(app) {
+    ResourceMemory_SetGpuBudget(cfg.gpuMemoryBudget);
+    ResourceMemory_SetBudget(ResourceKind::Texture, cfg.textureMemoryBudget);
+    ResourceMemory_SetBudget(ResourceKind::CpuAsset, cfg.cpuAssetBudget);
+    if (!InitPlatform(cfg)) {
+        // Nothing else is brought up; Run() reports it and returns at once.
+        m->InitFailed = true;
+        return;
+    }
+    Profiler_SetThreadName("Main");
+    GpuProfiler_Init();
+    Jobs_Init(cfg.jobWorkers);
+    m->Stream.Init(PACKET_INSTANCE_BYTES);
+    FramePacket_InitGpu(m->Packet);
+
+    m_Clock.SetRate(cfg.tickRate);
+    m_Clock.MaxSubsteps = cfg.maxSubsteps;
+    m_MaxFrameDt = cfg.maxFrameDt;
+    m_FixedFrameDt = cfg.fixedFrameDt;
+    m_Pacer.Configure(cfg.targetFps, cfg.justInTimeFrames, cfg.jitSafetyMs);
+    m_UseRenderThread = cfg.renderThread;
+    m_MaxFramesInFlight = cfg.maxFramesInFlight;
+    m_MaxFrames = cfg.maxFrames;
+    m_AllocWarmup = (uint64_t)std::max(0, cfg.allocWarmupFrames);
+    m_AllocBudget = cfg.allocBudget;
+
+    m_LastTime = m_TickTime = NowSeconds();
+    if (m_App) { m_App->m_Engine = this; m_App->OnStartup(); }
 }
 
 Engine::~Engine() {
+    if (m->InitFailed) { delete m; m = nullptr; return; }
     if (m_App) m_App->OnShutdown();
+    Jobs_Shutdown();
+    FramePacket_DestroyGpu(m->Packet);
+    m->Stream.Shutdown();
+    GpuProfiler_Shutdown();
     ShutdownPlatform();
     delete m; m = nullptr;
 }
 
 bool Engine::InitPlatform(const EngineConfig& cfg) {
+    if (cfg.headless) {
+        m->Headless = Headless_Create(cfg.width, cfg.height);
+        if (!m->Headless) return false;
+        Renderer_SetTargetFramebuffer(Headless_Framebuffer(m->Headless));
+        return true;
+    }
+
     if (!glfwInit()) { std::fprintf(stderr, "Madus: glfwInit failed\n"); return false; }
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -49,6 +91,8 @@ bool Engine::InitPlatform(const EngineConfig& cfg) {
     // Load OpenGL functions
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::fprintf(stderr, "Madus: gladLoadGLLoader failed\n");
+        glfwDestroyWindow(m->Window); m->Window = nullptr;
+        glfwTerminate();
         return false;
     }
 
@@ -59,39 +103,124 @@ bool Engine::InitPlatform(const EngineConfig& cfg) {
 }
 
 void Engine::ShutdownPlatform() {
+    if (m->Headless) { Headless_Destroy(m->Headless); m->Headless = nullptr; return; }
     if (m->Window) { glfwDestroyWindow(m->Window); m->Window = nullptr; }
     glfwTerminate();
 }
 
+void Engine::GetFramebufferSize(int& w, int& h) const {
+    if (m->Headless) Headless_GetSize(m->Headless, &w, &h);
+    else glfwGetFramebufferSize(m->Window, &w, &h);
+}
+
 void Engine::PumpEvents(bool& shouldClose) {
+    MADUS_PROFILE_ZONE("Engine::PumpEvents");
+    MADUS_ALLOC_ALLOW("Platform");
+    if (m->Headless) { shouldClose = false; return; }
     glfwPollEvents();
     shouldClose = glfwWindowShouldClose(m->Window);
 }
 
 void Engine::Update(double dt) {
+    MADUS_PROFILE_ZONE("Engine::Update");
+    MADUS_ALLOC_TAG("Update");
     if (m_App) m_App->OnUpdate(dt);
 }
 
-void Engine::Render() {
-    glClearColor(0.12f, 0.12f, 0.14f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+void Engine::FixedUpdate(double step) {
+    MADUS_PROFILE_ZONE("Engine::FixedUpdate");
+    MADUS_ALLOC_TAG("FixedUpdate");
+    if (m_App) m_App->OnFixedUpdate(step);
+}
 
-    if (m_App) m_App->OnRender();
+void Engine::Render(double alpha) {
+    MADUS_PROFILE_ZONE("Engine::Render");
+    MADUS_ALLOC_TAG("Record");
+    const bool threaded = m->Render.IsRunning();
+    FramePacket& p = threaded ? m->Render.Acquire() : m->Packet;
+    if (!threaded) { p.Reset(); FramePacket_BeginInstances(p, m->Stream); }
+    p.Frame = m_Frame++;
+    GetFramebufferSize(p.Width, p.Height);
+    if (m_App) m_App->OnRecord(p, alpha);
+    FramePacket_CloseLists(p);
+
+    if (threaded) { m->Render.Submit(); return; }
+
+    bool recorded = !p.Draws.empty() || !p.MainPass.empty() || p.HasShadow;
+    for (const DrawList& l : p.Lists) recorded |= !l.Commands.empty();
+    if (recorded) {
+        FramePacket_Execute(p);
+    } else {
+        // Only OnRender draws; the next BeginInstances ends the unused region.
+        glClearColor(0.12f, 0.12f, 0.14f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    if (m_App) m_App->OnRender(alpha);
 
-    glfwSwapBuffers(m->Window);
+    MADUS_PROFILE_ZONE("SwapBuffers");
+    MADUS_ALLOC_ALLOW("Platform");
+    if (m->Headless) Headless_Present(m->Headless);
+    else glfwSwapBuffers(m->Window);
 }
 
 int Engine::Run() {
+    MADUS_PROFILE_ZONE("Engine::Run");
+    if (m->InitFailed) { std::fprintf(stderr, "Madus: platform init failed, not running\n"); return 1; }
+    // The GL thread takes the context from here on; OnStartup already made its GL objects.
+    if (m_UseRenderThread) m->Render.Start(m->Window, m->Headless, m_MaxFramesInFlight);
+
     bool shouldClose = false;
     while (!shouldClose) {
-        const double t  = NowSeconds();
-        const double dt = t - m_LastTime;
-        m_LastTime = t;
+        m_Pacer.BeginFrame(NowSeconds());   // returns at once when unpaced
+        AllocTracker_SetFrame(m_Frame, m_Frame >= m_AllocWarmup);
+        {
+            MADUS_PROFILE_ZONE("Frame");
+            const double t  = NowSeconds();
+            double dt = t - m_LastTime;
+            m_LastTime = t;
+            if (dt > m_MaxFrameDt) dt = m_MaxFrameDt;
+            if (m_FixedFrameDt > 0.0) dt = m_FixedFrameDt;
+
+            PumpEvents(shouldClose);
+            const double pumped = NowSeconds();
+            m_Pacer.InputSampled(pumped);
+            {
+                MADUS_PROFILE_ZONE("Jobs_PumpMain");
+                MADUS_ALLOC_TAG("MainLane");
+                Jobs_PumpMain();   // main-thread work handed to the main lane since last frame
+            }
+            Update(dt);
+
+            // Every tick of this frame sees the events of this pump; GLFW stamps
+            // them all at about the same moment, so there's nothing finer to split.
+            m_TickTime = pumped;
+            const int steps = m_Clock.Advance(dt);
+            for (int i = 0; i < steps; ++i) FixedUpdate(m_Clock.Step);
+
+            Render(m_Clock.Alpha());
+            m_Pacer.EndFrame(NowSeconds());
+            m->FrameArena.Reset();
+        }
+        Profiler_EndFrame();   // after "Frame" closes, so the window includes it
+        if (m_MaxFrames && m_Frame >= m_MaxFrames) break;
+    }
+    AllocTracker_SetFrame(m_Frame, false);
 
-        PumpEvents(shouldClose);
-        Update(dt);
-        Render();
+    if (m->Render.IsRunning()) {
+        m->Render.Stop();
+        // OnShutdown frees GL objects
+        if (m->Headless) Headless_MakeCurrent(m->Headless);
+        else glfwMakeContextCurrent(m->Window);
     }
+
+#if MADUS_ALLOC_TRACKING
+    AllocTracker_Report(stderr);
+    if (AllocTracker_Violations() > m_AllocBudget) {
+        std::fprintf(stderr, "Madus: %llu steady-state allocations, budget %llu\n",
+                     (unsigned long long)AllocTracker_Violations(), (unsigned long long)m_AllocBudget);
+        return 1;
+    }
+#endif
     return 0;
 }
 
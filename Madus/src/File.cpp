@@ -0,0 +1,98 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/File.h"
+#include <cstdio>
+
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept {
+    if (this == &o) return *this;
+    Close();
+    m_Data = o.m_Data; m_Size = o.m_Size;
+    o.m_Data = nullptr; o.m_Size = 0;
+#ifdef _WIN32
+    m_File = o.m_File; m_Mapping = o.m_Mapping;
+    o.m_File = o.m_Mapping = nullptr;
+#endif
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char* path){
+    Close();
+    HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER sz{};
+    if (!GetFileSizeEx(f, &sz) || sz.QuadPart == 0) { CloseHandle(f); return false; }
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m) { CloseHandle(f); return false; }
+    const void* p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (!p) { CloseHandle(m); CloseHandle(f); return false; }
+    m_File = f; m_Mapping = m;
+    m_Data = (const unsigned char*)p;
+    m_Size = (size_t)sz.QuadPart;
+    return true;
+}
+
+void MappedFile::Close(){
+    if (m_Data)    UnmapViewOfFile(m_Data);
+    if (m_Mapping) CloseHandle((HANDLE)m_Mapping);
+    if (m_File)    CloseHandle((HANDLE)m_File);
+    m_Data = nullptr; m_Size = 0;
+    m_File = m_Mapping = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const char* path){
+    Close();
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+    void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps its own reference
+    if (p == MAP_FAILED) return false;
+    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+    m_Data = (const unsigned char*)p;
+    m_Size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close(){
+    if (m_Data) munmap((void*)m_Data, m_Size);
+    m_Data = nullptr; m_Size = 0;
+}
+
+#endif
+
+bool File_ReadAll(const char* path, std::string& out){
+    out.clear();
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) return false;
+    bool ok = std::fseek(f, 0, SEEK_END) == 0;
+    const long len = ok ? std::ftell(f) : -1;
+    ok = ok && len >= 0 && std::fseek(f, 0, SEEK_SET) == 0;
+    if (ok) {
+        out.resize((size_t)len);
+        ok = std::fread(out.data(), 1, out.size(), f) == out.size();
+    }
+    std::fclose(f);
+    if (!ok) out.clear();
+    return ok;
+}
@@ -0,0 +1,141 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/FramePacer.h"
+#include "Madus/Input.h"
+#include "Madus/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+  #include <timeapi.h>
+#endif
+
+namespace madus {
+
+namespace {
+constexpr double kMinSpin = 0.0005, kMaxSpin = 0.004;   // seconds
+
+// Mean and standard deviation of one field over the filled part of the window.
+template<class F>
+void MeanStdDev(size_t n, F&& get, double& mean, double& sd){
+    mean = sd = 0.0;
+    if (!n) return;
+    for (size_t i = 0; i < n; ++i) mean += get(i);
+    mean /= (double)n;
+    for (size_t i = 0; i < n; ++i) sd += (get(i) - mean) * (get(i) - mean);
+    sd = n > 1 ? std::sqrt(sd / (double)(n - 1)) : 0.0;
+}
+}
+
+FramePacer::~FramePacer(){ Configure(0.0, false, 0.0); }
+
+void FramePacer::Configure(double targetFps, bool justInTime, double safetyMs){
+    m_Period = targetFps > 0.0 ? 1.0 / targetFps : 0.0;
+    m_JustInTime = justInTime && m_Period > 0.0;
+    m_Safety = std::max(0.0, safetyMs) * 1e-3;
+    m_Deadline = 0.0;
+    m_Frames = m_Missed = 0;
+#ifdef _WIN32
+    // The default 15.6 ms timer tick would turn every sleep into a miss.
+    if (IsPacing() != m_TimerRaised) {
+        if (IsPacing()) timeBeginPeriod(1); else timeEndPeriod(1);
+        m_TimerRaised = IsPacing();
+    }
+#endif
+}
+
+void FramePacer::WaitUntil(double t){
+    for (;;) {
+        const double now = Input_Now();
+        const double left = t - now;
+        if (left <= 0.0) return;
+        if (left > m_SpinMargin) {
+            const double ask = left - m_SpinMargin;
+            std::this_thread::sleep_for(std::chrono::duration<double>(ask));
+            // Late wakeups widen the margin at once; it narrows slowly when they stop.
+            const double over = std::max(0.0, Input_Now() - now - ask);
+            m_Oversleep = std::max(over, m_Oversleep * 0.95);
+            m_SpinMargin = std::clamp(m_Oversleep * 1.25 + kMinSpin, kMinSpin, kMaxSpin);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void FramePacer::BeginFrame(double now){
+    MADUS_PROFILE_ZONE("FramePacer::Wait");
+    double start = now;
+    if (IsPacing()) {
+        if (m_Deadline <= 0.0) m_Deadline = now;   // first frame: start now
+        m_Deadline += m_Period;
+        double target = m_Deadline - m_Period;
+        if (m_JustInTime) {
+            const size_t n = (size_t)std::min<uint64_t>(m_Frames, FRAME_PACER_WINDOW);
+            double mean, sd;
+            MeanStdDev(n, [this](size_t i){ return (double)m_Window[i].WorkMs; }, mean, sd);
+            const double predicted = std::min((mean + 2.0 * sd) * 1e-3, m_Period);
+            target = std::max(target, m_Deadline - predicted - m_Safety);
+        }
+        if (target > now) {
+            WaitUntil(target);
+            start = Input_Now();
+        }
+    }
+    m_Waited = start - now;
+    m_PrevStart = m_Start;
+    m_Start = m_Sampled = start;
+}
+
+void FramePacer::InputSampled(double when){ m_Sampled = when; }
+
+void FramePacer::EndFrame(double submitted){
+    double deadline = submitted;
+    if (IsPacing()) {
+        deadline = m_Deadline;
+        if (submitted > m_Deadline) {
+            ++m_Missed;
+            m_Deadline = submitted;   // restart the schedule here
+        }
+    }
+    Sample& s = m_Window[m_Frames % FRAME_PACER_WINDOW];
+    s.IntervalMs = m_Frames ? (float)((m_Start - m_PrevStart) * 1e3) : 0.f;
+    s.WorkMs     = (float)((submitted - m_Start) * 1e3);
+    s.WaitMs     = (float)(m_Waited * 1e3);
+    s.LatencyMs  = (float)((std::max(deadline, submitted) - m_Sampled) * 1e3);
+    ++m_Frames;
+}
+
+FramePacerStats FramePacer::GetStats() const {
+    FramePacerStats st;
+    st.TargetMs = m_Period * 1e3;
+    st.JustInTime = m_JustInTime;
+    st.SpinMarginMs = m_SpinMargin * 1e3;
+    st.Frames = m_Frames;
+    st.Missed = m_Missed;
+    const size_t n = (size_t)std::min<uint64_t>(m_Frames, FRAME_PACER_WINDOW);
+    double sd;
+    MeanStdDev(n, [this](size_t i){ return (double)m_Window[i].WorkMs; }, st.WorkMs, sd);
+    MeanStdDev(n, [this](size_t i){ return (double)m_Window[i].WaitMs; }, st.WaitMs, sd);
+    MeanStdDev(n, [this](size_t i){ return (double)m_Window[i].LatencyMs; }, st.InputLatencyMs, sd);
+
+    // The first frame has no interval; skip it while it's still in the window.
+    const size_t first = m_Frames <= FRAME_PACER_WINDOW ? 1 : 0;
+    if (n > first) {
+        MeanStdDev(n - first, [this, first](size_t i){ return (double)m_Window[i + first].IntervalMs; },
+                   st.FrameMs, st.FrameStdDevMs);
+        for (size_t i = first; i < n; ++i) st.FrameMaxMs = std::max(st.FrameMaxMs, (double)m_Window[i].IntervalMs);
+    }
+    return st;
+}
+
+} // namespace madus
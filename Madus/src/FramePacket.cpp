@@ -0,0 +1,224 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/FramePacket.h"
+#include "Madus/Jobs.h"
+#include "Madus/Memory.h"
+#include "Madus/GpuProfiler.h"
+#include "Madus/RenderStats.h"
+#include "Madus/ResourceMemory.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cassert>
+
+// shader | texture | mesh | passes: sorting by it groups state changes from
+// the most to the least expensive. Ids are truncated to 16 bits; a collision
+// only costs an extra draw because runs compare the full state.
+static uint64_t SortKey(ShaderHandle sh, unsigned albedo, const GpuMesh& mesh, uint8_t passes){
+    return ((uint64_t)(sh & 0xFFFF) << 48) | ((uint64_t)(albedo & 0xFFFF) << 32) | ((uint64_t)(mesh.vao & 0xFFFF) << 16) | passes;
+}
+
+void DrawList::Add(const GpuMesh& mesh, ShaderHandle sh, unsigned albedo, const Mat4& model, uint8_t passes){
+    m_Items.push_back({ SortKey(sh, albedo, mesh, passes), &mesh, sh, albedo, passes, (uint32_t)m_Models.size() });
+    m_Models.push_back(model);
+}
+
+void DrawList::Clear(){
+    m_Items.clear();
+    m_Models.clear();
+    Commands.clear();
+    Spill.clear();
+    Spilled = false;
+}
+
+void DrawList::Close(FramePacket& packet){
+    Commands.clear();
+    Spilled = false;
+    const size_t n = m_Items.size();
+    if (n == 0) return;
+
+    // Recording order breaks ties, so the result doesn't depend on the sort.
+    std::sort(m_Items.begin(), m_Items.end(), [](const Item& a, const Item& b){
+        return a.Key != b.Key ? a.Key < b.Key : a.Model < b.Model;
+    });
+
+    // Matrix-aligned, so the offset is a whole number of instances; also a
+    // cache line, so workers never write the same one.
+    const StreamAlloc a = packet.Instances.Alloc(n * sizeof(Mat4), sizeof(Mat4));
+    Mat4* dst;
+    size_t base;
+    if (a.Ptr) {
+        dst = static_cast<Mat4*>(a.Ptr);
+        base = a.Offset / sizeof(Mat4);
+    } else {
+        // Out of room this frame; the region grows before it comes around again.
+        Spilled = true;
+        Spill.resize(n);
+        dst = Spill.data();
+        base = 0;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        const Item& it = m_Items[i];
+        dst[i] = m_Models[it.Model];
+        if (Commands.empty() || Commands.back().Mesh != it.Mesh || Commands.back().Shader != it.Shader
+            || Commands.back().Albedo != it.Albedo || Commands.back().Passes != it.Passes)
+            Commands.push_back({ it.Key, it.Mesh, it.Shader, it.Albedo, it.Passes, (uint32_t)(base + i), 0 });
+        ++Commands.back().Count;
+    }
+}
+
+DrawList& FramePacket::ThreadList(){
+    const int t = Jobs_ThreadIndex();
+    assert(t >= 0 && (size_t)t < Lists.size() && "record draw lists from the main thread or a job");
+    return Lists[(size_t)t];
+}
+
+void FramePacket::Reset(){
+    Frame = 0;
+    Width = Height = 0;
+    Params = FrameParams{};
+    Sky = true;
+    HasShadow = false;
+    Shadow = ShadowMapInfo{};
+    ShadowCasters.clear();
+    ShadowPass.clear();
+    Draws.clear();
+    MainPass.clear();
+    Lists.resize((size_t)Jobs_WorkerCount() + 1);
+    for (DrawList& l : Lists) l.Clear();
+    MainCulled = ShadowCulled = 0;
+}
+
+void FramePacket_InitGpu(FramePacket& p){
+    glGenBuffers(1, &p.SpillVbo);
+    ResourceMemory_Track(ResourceKind::Buffer, p.SpillVbo, 0);
+}
+
+void FramePacket_DestroyGpu(FramePacket& p){
+    if (p.SpillVbo) {
+        ResourceMemory_Untrack(ResourceKind::Buffer, p.SpillVbo);
+        glDeleteBuffers(1, &p.SpillVbo);
+    }
+    p.SpillVbo = 0;
+    p.SpillBytes = 0;
+    p.Stream = nullptr;   // the StreamBuffer owns the instance region
+}
+
+void FramePacket_BeginInstances(FramePacket& p, StreamBuffer& stream){
+    FramePacket_EndInstances(p);
+    p.Stream = &stream;
+    stream.BeginFrame(p.Instances);
+}
+
+void FramePacket_EndInstances(FramePacket& p){
+    if (p.Stream) p.Stream->EndFrame(p.Instances);
+}
+
+void FramePacket_CloseLists(FramePacket& p){
+    Jobs_ParallelFor(p.Lists.size(), 1, [&p](size_t b, size_t e){
+        for (size_t i = b; i < e; ++i) p.Lists[i].Close(p);
+    });
+}
+
+namespace {
+struct CommandRef {
+    const DrawList::Command* C;
+    unsigned Vbo;
+    uint64_t Order;   // list index << 32 | command index: breaks key ties
+};
+}
+
+void FramePacket_Execute(FramePacket& p){
+    MADUS_PROFILE_FUNCTION();
+    GpuProfiler_BeginFrame();
+    RenderStats& stats = RenderStats_Frame();
+    stats.BufferBytes += std::min(p.Instances.Used.load(std::memory_order_relaxed), p.Instances.Size);
+    stats.MainCulled += p.MainCulled;
+    stats.ShadowCulled += p.ShadowCulled;
+    if (p.Stream) p.Stream->Flush(p.Instances);
+
+    // Lists that didn't fit go up in one buffer; rebase their commands onto it.
+    ArenaScope scratch(Memory_Scratch());
+    std::pmr::vector<DrawList::Command> spilled(scratch.Resource());
+    std::pmr::vector<CommandRef> cmds(scratch.Resource());
+    size_t spillTotal = 0;
+    for (const DrawList& l : p.Lists) if (l.Spilled) spillTotal += l.Spill.size();
+    if (spillTotal) {
+        // Orphan at the same size each frame; resize (and re-track) only to grow.
+        const size_t bytes = spillTotal * sizeof(Mat4);
+        const bool grow = bytes > p.SpillBytes;
+        if (grow) p.SpillBytes = std::max(bytes, p.SpillBytes + p.SpillBytes / 2);
+        glBindBuffer(GL_ARRAY_BUFFER, p.SpillVbo);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)p.SpillBytes, nullptr, GL_STREAM_DRAW);
+        stats.BufferBytes += bytes;
+        if (grow) ResourceMemory_Track(ResourceKind::Buffer, p.SpillVbo, p.SpillBytes);
+    }
+    size_t spilledCmds = 0;
+    for (const DrawList& l : p.Lists) if (l.Spilled) spilledCmds += l.Commands.size();
+    spilled.reserve(spilledCmds);   // cmds point into it
+    size_t spillAt = 0;
+    for (size_t li = 0; li < p.Lists.size(); ++li) {
+        const DrawList& l = p.Lists[li];
+        const uint64_t list = (uint64_t)li << 32;
+        if (!l.Spilled) {
+            for (size_t ci = 0; ci < l.Commands.size(); ++ci) cmds.push_back({ &l.Commands[ci], p.Instances.Buffer, list | ci });
+            continue;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(spillAt * sizeof(Mat4)), (GLsizeiptr)(l.Spill.size() * sizeof(Mat4)), l.Spill.data());
+        for (size_t ci = 0; ci < l.Commands.size(); ++ci) {
+            DrawList::Command c = l.Commands[ci];
+            c.First += (uint32_t)spillAt;
+            spilled.push_back(c);
+            cmds.push_back({ &spilled.back(), p.SpillVbo, list | ci });
+        }
+        spillAt += l.Spill.size();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Merge: every list is sorted already; one sort of the commands interleaves
+    // them. Unlike stable_sort, std::sort takes no temporary buffer, so the
+    // tie-break keeps the order instead.
+    std::sort(cmds.begin(), cmds.end(), [](const CommandRef& a, const CommandRef& b){
+        return a.C->Key != b.C->Key ? a.C->Key < b.C->Key : a.Order < b.Order;
+    });
+
+    for (const CommandRef& r : cmds) {
+        if (r.C->Passes & DrawList::Shadow) stats.ShadowSubmitted += r.C->Count;
+        if (r.C->Passes & DrawList::Main)   stats.MainSubmitted += r.C->Count;
+    }
+    stats.MainSubmitted += p.Draws.size();
+    if (p.HasShadow) {
+        stats.ShadowSubmitted += p.ShadowCasters.size();
+        Renderer_Shadow_Begin(p.Shadow);
+        for (const ShadowItem& s : p.ShadowCasters) Renderer_Shadow_DrawDepth(*s.Mesh, s.Model);
+        for (const CommandRef& r : cmds)
+            if (r.C->Passes & DrawList::Shadow)
+                Renderer_Shadow_DrawDepthInstanced(*r.C->Mesh, r.Vbo, (size_t)r.C->First * sizeof(Mat4), r.C->Count);
+        for (const PacketCallback& cb : p.ShadowPass) cb.Fn(cb.Ctx, p);
+        Renderer_Shadow_End();
+    }
+
+    glViewport(0, 0, p.Width, p.Height);
+    Renderer_Begin(p.Params);
+    if (p.Sky) Renderer_DrawSky(p.Params.View, p.Params.Proj, p.Params.Sun);
+
+    // Camera/sun/shadow uniforms once per program, not per draw.
+    std::pmr::vector<ShaderHandle> lit(scratch.Resource());
+    auto light = [&](ShaderHandle sh){
+        if (std::find(lit.begin(), lit.end(), sh) != lit.end()) return;
+        Renderer_ApplyLighting(sh, p.Params);
+        lit.push_back(sh);
+    };
+    for (const DrawItem& d : p.Draws) light(d.Shader);
+    for (const CommandRef& r : cmds) if (r.C->Passes & DrawList::Main) light(r.C->Shader);
+
+    for (const PacketCallback& cb : p.MainPass) cb.Fn(cb.Ctx, p);
+    for (const DrawItem& d : p.Draws) Renderer_DrawMesh(*d.Mesh, d.Shader, d.Model, d.Albedo);
+    for (const CommandRef& r : cmds)
+        if (r.C->Passes & DrawList::Main)
+            Renderer_DrawMeshInstanced(*r.C->Mesh, r.C->Shader, r.C->Albedo, r.Vbo, (size_t)r.C->First * sizeof(Mat4), r.C->Count);
+    Renderer_End();
+    FramePacket_EndInstances(p);
+    GpuProfiler_EndFrame();
+    RenderStats_EndFrame(p.Frame);
+}
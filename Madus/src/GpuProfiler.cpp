@@ -0,0 +1,145 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/GpuProfiler.h"
+
+#if MADUS_PROFILER
+
+#include <glad/glad.h>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+constexpr uint64_t kCalibrateFrames = 120;
+
+struct Frame {
+    GLuint   Queries[GPU_PROFILER_MAX_ZONES * 2];   // begin, end per zone
+    uint32_t Zones[GPU_PROFILER_MAX_ZONES];
+    int      Count = 0;
+    GLuint   Last = 0;        // the last query issued; once it's available, all are
+    bool     Pending = false;
+};
+
+Frame      gFrames[GPU_PROFILER_FRAMES];
+int        gCur = 0;
+bool       gReady = false, gOpen = false;
+int        gStack[GPU_PROFILER_MAX_DEPTH];   // open zones, -1 past GPU_PROFILER_MAX_ZONES
+int        gDepth = 0, gOverflow = 0;
+ProfTrack* gTrack = nullptr;
+uint32_t   gFrameZone = 0;
+uint64_t   gFrameCount = 0, gDropped = 0;
+
+// GPU time gGpu0 (ns) was zone-clock tick gCpu0.
+uint64_t gCpu0 = 0;
+GLint64  gGpu0 = 0;
+double   gTicksPerNs = 1.0;
+
+void Calibrate(){
+    glGetInteger64v(GL_TIMESTAMP, &gGpu0);
+    gCpu0 = Profiler_Ticks();
+    gTicksPerNs = 1.0 / Profiler_NsPerTick();
+}
+
+uint64_t ToTicks(GLuint64 gpuNs){
+    const double dt = double((int64_t)(gpuNs - (GLuint64)gGpu0)) * gTicksPerNs;
+    return (uint64_t)((int64_t)gCpu0 + (int64_t)std::llround(dt));
+}
+
+bool Collect(Frame& f){
+    GLint available = 0;
+    glGetQueryObjectiv(f.Last, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+    for (int i = 0; i < f.Count; ++i) {
+        GLuint64 b = 0, e = 0;
+        glGetQueryObjectui64v(f.Queries[2 * i],     GL_QUERY_RESULT, &b);
+        glGetQueryObjectui64v(f.Queries[2 * i + 1], GL_QUERY_RESULT, &e);
+        Profiler_RecordZone(gTrack, f.Zones[i], ToTicks(b), ToTicks(e));
+    }
+    f.Pending = false;
+    return true;
+}
+}
+
+void GpuProfiler_Init(){
+    if (gReady) return;
+    if (!glQueryCounter) {   // core since 3.3, but the loader may not have resolved it
+        std::fprintf(stderr, "[GpuProfiler] no timer queries; GPU zones disabled\n");
+        return;
+    }
+    for (Frame& f : gFrames) {
+        glGenQueries(GPU_PROFILER_MAX_ZONES * 2, f.Queries);
+        f.Count = 0;
+        f.Pending = false;
+    }
+    if (!gTrack) {
+        gTrack = Profiler_CreateTrack("GPU");
+        gFrameZone = Profiler_RegisterZone("GPU Frame", __FILE__, __LINE__);
+    }
+    gCur = 0;
+    gOpen = false;
+    gFrameCount = 0;
+    gReady = true;
+}
+
+void GpuProfiler_Shutdown(){
+    if (!gReady) return;
+    for (Frame& f : gFrames) glDeleteQueries(GPU_PROFILER_MAX_ZONES * 2, f.Queries);
+    gReady = gOpen = false;
+}
+
+void GpuProfiler_BeginFrame(){
+    if (!gReady) return;
+    if (gOpen) GpuProfiler_EndFrame();
+
+    // Oldest first; queries complete in order, so stop at the first that hasn't.
+    for (int k = 1; k <= GPU_PROFILER_FRAMES; ++k) {
+        Frame& f = gFrames[(gCur + k) % GPU_PROFILER_FRAMES];
+        if (f.Pending && !Collect(f)) break;
+    }
+
+    gCur = (gCur + 1) % GPU_PROFILER_FRAMES;
+    Frame& f = gFrames[gCur];
+    if (f.Pending) { ++gDropped; f.Pending = false; }   // the GPU is that far behind; don't wait
+    f.Count = 0;
+    gDepth = gOverflow = 0;
+    gOpen = true;
+
+    if (gFrameCount++ % kCalibrateFrames == 0) Calibrate();
+    GpuProfiler_BeginZone(gFrameZone);
+}
+
+void GpuProfiler_EndFrame(){
+    if (!gOpen) return;
+    while (gDepth || gOverflow) GpuProfiler_EndZone();
+    Frame& f = gFrames[gCur];
+    f.Pending = f.Count > 0;
+    gOpen = false;
+}
+
+void GpuProfiler_BeginZone(uint32_t zone){
+    if (!gOpen) return;
+    if (gDepth == GPU_PROFILER_MAX_DEPTH) { ++gOverflow; return; }
+    Frame& f = gFrames[gCur];
+    int i = -1;
+    if (f.Count < GPU_PROFILER_MAX_ZONES) {
+        i = f.Count++;
+        f.Zones[i] = zone;
+        glQueryCounter(f.Queries[2 * i], GL_TIMESTAMP);
+        f.Last = f.Queries[2 * i];
+    }
+    gStack[gDepth++] = i;
+}
+
+void GpuProfiler_EndZone(){
+    if (!gOpen) return;
+    if (gOverflow) { --gOverflow; return; }
+    if (!gDepth) return;
+    const int i = gStack[--gDepth];
+    if (i < 0) return;
+    Frame& f = gFrames[gCur];
+    glQueryCounter(f.Queries[2 * i + 1], GL_TIMESTAMP);
+    f.Last = f.Queries[2 * i + 1];
+}
+
+uint64_t GpuProfiler_DroppedFrames(){ return gDropped; }
+
+#endif
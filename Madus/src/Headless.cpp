@@ -0,0 +1,189 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Headless.h"
+#include <cstdio>
+
+#if MADUS_HEADLESS_EGL
+
+#include "Madus/ResourceMemory.h"
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+
+struct HeadlessContext {
+    EGLDisplay Display = EGL_NO_DISPLAY;
+    EGLContext Context = EGL_NO_CONTEXT;
+    EGLSurface Surface = EGL_NO_SURFACE;   // stays EGL_NO_SURFACE with EGL_KHR_surfaceless_context
+    GLuint     Fbo = 0, Color = 0, Depth = 0;
+    int        Width = 0, Height = 0;
+    GLsync     Fences[HEADLESS_FRAMES_IN_FLIGHT] = {};
+    unsigned   Frame = 0;
+};
+
+namespace {
+bool HasExtension(const char* list, const char* name){
+    if (!list) return false;
+    const size_t n = std::strlen(name);
+    for (const char* p = list; (p = std::strstr(p, name)); p += n)
+        if ((p == list || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return true;
+    return false;
+}
+
+EGLDisplay OpenDisplay(){
+    // Client extensions; null before EGL 1.5 without EGL_EXT_client_extensions.
+    const char* client = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (HasExtension(client, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) {
+            EGLDisplay d = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (d != EGL_NO_DISPLAY) return d;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool CreateContext(HeadlessContext& h){
+    h.Display = OpenDisplay();
+    EGLint major = 0, minor = 0;
+    if (h.Display == EGL_NO_DISPLAY || !eglInitialize(h.Display, &major, &minor)) {
+        std::fprintf(stderr, "[Headless] no EGL display (0x%x)\n", eglGetError());
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::fprintf(stderr, "[Headless] EGL %d.%d has no desktop OpenGL\n", major, minor);
+        return false;
+    }
+
+    const bool surfaceless = HasExtension(eglQueryString(h.Display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE,    surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configs = 0;
+    if (!eglChooseConfig(h.Display, configAttribs, &config, 1, &configs) || !configs) {
+        std::fprintf(stderr, "[Headless] no EGL config for OpenGL\n");
+        return false;
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION,       3,
+        EGL_CONTEXT_MINOR_VERSION,       3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    h.Context = eglCreateContext(h.Display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (h.Context == EGL_NO_CONTEXT) {
+        std::fprintf(stderr, "[Headless] eglCreateContext failed (0x%x)\n", eglGetError());
+        return false;
+    }
+    if (!surfaceless) {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };   // never drawn to
+        h.Surface = eglCreatePbufferSurface(h.Display, config, pbufferAttribs);
+        if (h.Surface == EGL_NO_SURFACE) {
+            std::fprintf(stderr, "[Headless] eglCreatePbufferSurface failed (0x%x)\n", eglGetError());
+            return false;
+        }
+    }
+    if (!eglMakeCurrent(h.Display, h.Surface, h.Surface, h.Context)) {
+        std::fprintf(stderr, "[Headless] eglMakeCurrent failed (0x%x)\n", eglGetError());
+        return false;
+    }
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        std::fprintf(stderr, "[Headless] gladLoadGLLoader failed\n");
+        return false;
+    }
+    return true;
+}
+
+bool CreateFramebuffer(HeadlessContext& h){
+    glGenRenderbuffers(1, &h.Color);
+    glBindRenderbuffer(GL_RENDERBUFFER, h.Color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_SRGB8_ALPHA8, h.Width, h.Height);
+    glGenRenderbuffers(1, &h.Depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, h.Depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, h.Width, h.Height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &h.Fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, h.Fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, h.Color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, h.Depth);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::fprintf(stderr, "[Headless] framebuffer incomplete (0x%x)\n", status);
+        return false;
+    }
+    glViewport(0, 0, h.Width, h.Height);
+    ResourceMemory_Track(ResourceKind::RenderTarget, &h, (size_t)h.Width * h.Height * 8);   // color + depth
+    return true;
+}
+}
+
+HeadlessContext* Headless_Create(int width, int height){
+    HeadlessContext* h = new HeadlessContext;
+    h->Width = width > 0 ? width : 1;
+    h->Height = height > 0 ? height : 1;
+    if (!CreateContext(*h) || !CreateFramebuffer(*h)) { Headless_Destroy(h); return nullptr; }
+    return h;
+}
+
+void Headless_Destroy(HeadlessContext* h){
+    if (!h) return;
+    if (h->Context != EGL_NO_CONTEXT && eglMakeCurrent(h->Display, h->Surface, h->Surface, h->Context)) {
+        for (GLsync& f : h->Fences) if (f) { glDeleteSync(f); f = nullptr; }
+        if (h->Fbo)   glDeleteFramebuffers(1, &h->Fbo);
+        if (h->Color) glDeleteRenderbuffers(1, &h->Color);
+        if (h->Depth) glDeleteRenderbuffers(1, &h->Depth);
+        eglMakeCurrent(h->Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+    ResourceMemory_Untrack(ResourceKind::RenderTarget, h);
+    if (h->Surface != EGL_NO_SURFACE) eglDestroySurface(h->Display, h->Surface);
+    if (h->Context != EGL_NO_CONTEXT) eglDestroyContext(h->Display, h->Context);
+    if (h->Display != EGL_NO_DISPLAY) eglTerminate(h->Display);
+    delete h;
+}
+
+void Headless_MakeCurrent(HeadlessContext* h){
+    eglMakeCurrent(h->Display, h->Surface, h->Surface, h->Context);
+}
+
+void Headless_Release(HeadlessContext* h){
+    eglMakeCurrent(h->Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+void Headless_Present(HeadlessContext* h){
+    GLsync& f = h->Fences[h->Frame++ % HEADLESS_FRAMES_IN_FLIGHT];
+    if (f) {
+        while (glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED) {}
+        glDeleteSync(f);
+    }
+    f = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+}
+
+unsigned Headless_Framebuffer(const HeadlessContext* h){ return h->Fbo; }
+
+void Headless_GetSize(const HeadlessContext* h, int* width, int* height){
+    *width = h->Width;
+    *height = h->Height;
+}
+
+#else
+
+struct HeadlessContext {};
+
+HeadlessContext* Headless_Create(int, int){
+    std::fprintf(stderr, "[Headless] built without EGL; headless mode is unavailable\n");
+    return nullptr;
+}
+void Headless_Destroy(HeadlessContext*) {}
+void Headless_MakeCurrent(HeadlessContext*) {}
+void Headless_Release(HeadlessContext*) {}
+void Headless_Present(HeadlessContext*) {}
+unsigned Headless_Framebuffer(const HeadlessContext*) { return 0; }
+void Headless_GetSize(const HeadlessContext*, int* width, int* height){ *width = *height = 0; }
+
+#endif
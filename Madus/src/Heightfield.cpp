@@ -0,0 +1,142 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Heightfield.h"
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define MADUS_HF_SSE 1
+#else
+  #define MADUS_HF_SSE 0
+#endif
+
+void Heightfield::Init(int sizeX, int sizeZ, float cellSize, float originX, float originZ, float fill){
+    SizeX = std::max(2, sizeX);
+    SizeZ = std::max(2, sizeZ);
+    CellSize = (cellSize > 0.f) ? cellSize : 1.f;
+    InvCell = 1.f / CellSize;
+    OriginX = originX; OriginZ = originZ;
+    Heights.assign((size_t)SizeX * SizeZ, fill);
+    RebuildNormals();
+}
+
+void Heightfield::RebuildNormals(){
+    const size_t n = (size_t)SizeX * SizeZ;
+    NormalX.resize(n); NormalY.resize(n); NormalZ.resize(n);
+    MinHeight = MaxHeight = n ? Heights[0] : 0.f;
+
+    for (int z = 0; z < SizeZ; ++z) {
+        const int z0 = std::max(0, z - 1), z1 = std::min(SizeZ - 1, z + 1);
+        for (int x = 0; x < SizeX; ++x) {
+            const int x0 = std::max(0, x - 1), x1 = std::min(SizeX - 1, x + 1);
+            // Central differences (one-sided at the borders, scaled by the actual span).
+            const float dhdx = (At(x1, z) - At(x0, z)) / ((float)(x1 - x0) * CellSize);
+            const float dhdz = (At(x, z1) - At(x, z0)) / ((float)(z1 - z0) * CellSize);
+            const Vec3 nrm = Normalize(Vec3{ -dhdx, 1.f, -dhdz });
+            const size_t i = (size_t)z * SizeX + x;
+            NormalX[i] = nrm.x; NormalY[i] = nrm.y; NormalZ[i] = nrm.z;
+            MinHeight = std::min(MinHeight, Heights[i]);
+            MaxHeight = std::max(MaxHeight, Heights[i]);
+        }
+    }
+}
+
+#if MADUS_HF_SSE
+// Four lanes of Locate/Bilerp/BilerpNormal. Every step is the scalar one in
+// the same order: clamp as std::clamp does (max/min operand order keeps -0
+// and NaN the same), truncate, separate mul and add (never FMA), IEEE sqrt
+// and divide. Only the corner loads are per lane; SSE2 has no gather.
+namespace {
+struct Cells4 { size_t i[4]; __m128 tx, tz; };
+
+inline __m128 Lerp4(__m128 a, __m128 b, __m128 t){ return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)); }
+
+inline __m128i Min4(__m128i a, __m128i b){
+    const __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+inline __m128 Bilerp4(const float* g, const Cells4& c, int sizeX){
+    const float* r[4] = { g + c.i[0], g + c.i[1], g + c.i[2], g + c.i[3] };
+    const __m128 a = _mm_setr_ps(r[0][0], r[1][0], r[2][0], r[3][0]);
+    const __m128 b = _mm_setr_ps(r[0][1], r[1][1], r[2][1], r[3][1]);
+    const __m128 d = _mm_setr_ps(r[0][sizeX], r[1][sizeX], r[2][sizeX], r[3][sizeX]);
+    const __m128 e = _mm_setr_ps(r[0][sizeX + 1], r[1][sizeX + 1], r[2][sizeX + 1], r[3][sizeX + 1]);
+    return Lerp4(Lerp4(a, b, c.tx), Lerp4(d, e, c.tx), c.tz);
+}
+
+struct Locate4 {
+    __m128  Zero = _mm_setzero_ps(), Inv, Ox, Oz, HiX, HiZ;
+    __m128i LimX, LimZ;
+    int     SizeX;
+
+    Locate4(float originX, float originZ, float invCell, int sizeX, int sizeZ)
+        : Inv(_mm_set1_ps(invCell)), Ox(_mm_set1_ps(originX)), Oz(_mm_set1_ps(originZ)),
+          HiX(_mm_set1_ps((float)(sizeX - 1))), HiZ(_mm_set1_ps((float)(sizeZ - 1))),
+          LimX(_mm_set1_epi32(sizeX - 2)), LimZ(_mm_set1_epi32(sizeZ - 2)), SizeX(sizeX) {}
+
+    Cells4 operator()(const float* xs, const float* zs) const {
+        const __m128 fx = _mm_min_ps(HiX, _mm_max_ps(Zero, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(xs), Ox), Inv)));
+        const __m128 fz = _mm_min_ps(HiZ, _mm_max_ps(Zero, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(zs), Oz), Inv)));
+        const __m128i ix = Min4(_mm_cvttps_epi32(fx), LimX);
+        const __m128i iz = Min4(_mm_cvttps_epi32(fz), LimZ);
+        alignas(16) int32_t lx[4], lz[4];
+        _mm_store_si128((__m128i*)lx, ix);
+        _mm_store_si128((__m128i*)lz, iz);
+        Cells4 c;
+        for (int k = 0; k < 4; ++k) c.i[k] = (size_t)lz[k] * SizeX + lx[k];
+        c.tx = _mm_sub_ps(fx, _mm_cvtepi32_ps(ix));
+        c.tz = _mm_sub_ps(fz, _mm_cvtepi32_ps(iz));
+        return c;
+    }
+};
+}
+
+#endif
+
+void Heightfield::SampleHeights(const float* xs, const float* zs, float* outH, size_t n) const {
+    const float* g = Heights.data();
+    size_t i = 0;
+#if MADUS_HF_SSE
+    const Locate4 locate(OriginX, OriginZ, InvCell, SizeX, SizeZ);
+    for (; i + 4 <= n; i += 4) {
+        const Cells4 c = locate(xs + i, zs + i);
+        _mm_storeu_ps(outH + i, Bilerp4(g, c, SizeX));
+    }
+#endif
+    for (; i < n; ++i) outH[i] = Bilerp(g, Locate(xs[i], zs[i]));
+}
+
+void Heightfield::SampleNormals(const float* xs, const float* zs, float* outX, float* outY, float* outZ, size_t n) const {
+    size_t i = 0;
+#if MADUS_HF_SSE
+    const Locate4 locate(OriginX, OriginZ, InvCell, SizeX, SizeZ);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f), eps = _mm_set1_ps(1e-6f);
+    for (; i + 4 <= n; i += 4) {
+        const Cells4 c = locate(xs + i, zs + i);
+        const __m128 nx = Bilerp4(NormalX.data(), c, SizeX);
+        const __m128 ny = Bilerp4(NormalY.data(), c, SizeX);
+        const __m128 nz = Bilerp4(NormalZ.data(), c, SizeX);
+        // Normalize(): sqrt(max(0, x*x + y*y + z*z)), then v * (1/L), or zero below 1e-6.
+        const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz));
+        const __m128 len = _mm_sqrt_ps(_mm_max_ps(d, zero));
+        const __m128 s = _mm_div_ps(one, len), keep = _mm_cmpgt_ps(len, eps);
+        _mm_storeu_ps(outX + i, _mm_and_ps(_mm_mul_ps(nx, s), keep));
+        _mm_storeu_ps(outY + i, _mm_and_ps(_mm_mul_ps(ny, s), keep));
+        _mm_storeu_ps(outZ + i, _mm_and_ps(_mm_mul_ps(nz, s), keep));
+    }
+#endif
+    for (; i < n; ++i) {
+        const Vec3 nrm = BilerpNormal(Locate(xs[i], zs[i]));
+        outX[i] = nrm.x; outY[i] = nrm.y; outZ[i] = nrm.z;
+    }
+}
+
+bool Heightfield::CanStepTo(float feetY, float x, float z, float stepOffset, float cosMaxSlope, float* outGroundY) const {
+    const Cell c = Locate(x, z);
+    const float gy = Bilerp(Heights.data(), c);
+    if (outGroundY) *outGroundY = gy;
+    if (gy - feetY > stepOffset) return false;
+    return BilerpNormal(c).y >= cosMaxSlope;
+}
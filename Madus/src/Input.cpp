@@ -2,72 +2,178 @@
 
 #include "Madus/Input.h"
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <chrono>
 #include <cmath>
-#include <algorithm> 
+#include <algorithm>
 
-static GLFWwindow* GWin = nullptr;
-static double LastX = 0.0, LastY = 0.0;
-static bool   FirstMouse = true;
-static bool   GActive = true;
+namespace {
+enum class EventType : uint8_t { Key, Button, Cursor };
+
+struct InputEvent {
+    double    Time;
+    double    X, Y;        // Cursor
+    int       Code;        // GLFW key or mouse button
+    EventType Type;
+    bool      Down;
+};
+
+// Single producer (the GLFW callbacks, on the thread that pumps events),
+// single consumer (Input_Sample). Head and tail only ever grow.
+struct EventRing {
+    InputEvent Events[INPUT_EVENT_RING];
+    alignas(64) std::atomic<uint64_t> Head{0};   // next write
+    alignas(64) std::atomic<uint64_t> Tail{0};   // next read
+    std::atomic<uint64_t> Dropped{0};
+
+    void Push(const InputEvent& e){
+        const uint64_t h = Head.load(std::memory_order_relaxed);
+        if (h - Tail.load(std::memory_order_acquire) >= INPUT_EVENT_RING) {
+            Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Events[h & (INPUT_EVENT_RING - 1)] = e;
+        Head.store(h + 1, std::memory_order_release);
+    }
+};
+
+EventRing   GRing;
+GLFWwindow* GWin = nullptr;
+bool        GActive = true;
+
+GLFWkeyfun         GPrevKey = nullptr;
+GLFWmousebuttonfun GPrevButton = nullptr;
+GLFWcursorposfun   GPrevCursor = nullptr;
+
+// Consumer-side state: what the applied events add up to
+bool   KeyDown[GLFW_KEY_LAST + 1] = {};
+bool   ButtonDown[GLFW_MOUSE_BUTTON_LAST + 1] = {};
+bool   KeyPressed[GLFW_KEY_LAST + 1] = {};            // went down since the last sample
+bool   ButtonPressed[GLFW_MOUSE_BUTTON_LAST + 1] = {};
+double LastX = 0.0, LastY = 0.0;
+double AccumDX = 0.0, AccumDY = 0.0;
+bool   FirstMouse = true;
+
+void OnKey(GLFWwindow* w, int key, int scancode, int action, int mods){
+    if (key >= 0 && key <= GLFW_KEY_LAST && action != GLFW_REPEAT)
+        GRing.Push({ Input_Now(), 0.0, 0.0, key, EventType::Key, action == GLFW_PRESS });
+    if (GPrevKey) GPrevKey(w, key, scancode, action, mods);
+}
+
+void OnButton(GLFWwindow* w, int button, int action, int mods){
+    if (button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST)
+        GRing.Push({ Input_Now(), 0.0, 0.0, button, EventType::Button, action == GLFW_PRESS });
+    if (GPrevButton) GPrevButton(w, button, action, mods);
+}
+
+void OnCursor(GLFWwindow* w, double x, double y){
+    GRing.Push({ Input_Now(), x, y, 0, EventType::Cursor, false });
+    if (GPrevCursor) GPrevCursor(w, x, y);
+}
+
+void Apply(const InputEvent& e){
+    switch (e.Type) {
+    case EventType::Key:
+        KeyPressed[e.Code] |= e.Down && !KeyDown[e.Code];
+        KeyDown[e.Code] = e.Down;
+        break;
+    case EventType::Button:
+        ButtonPressed[e.Code] |= e.Down && !ButtonDown[e.Code];
+        ButtonDown[e.Code] = e.Down;
+        break;
+    case EventType::Cursor:
+        if (FirstMouse) { LastX = e.X; LastY = e.Y; FirstMouse = false; }
+        AccumDX += e.X - LastX;
+        AccumDY += e.Y - LastY;
+        LastX = e.X; LastY = e.Y;
+        break;
+    }
+}
+
+bool Key(int key)   { return KeyDown[key] || KeyPressed[key]; }
+bool Button(int b)  { return ButtonDown[b] || ButtonPressed[b]; }
+}
 
 void Input_BindWindow(void* glfwWindow){
+    if (GWin) {
+        glfwSetKeyCallback(GWin, GPrevKey);
+        glfwSetMouseButtonCallback(GWin, GPrevButton);
+        glfwSetCursorPosCallback(GWin, GPrevCursor);
+        GPrevKey = nullptr; GPrevButton = nullptr; GPrevCursor = nullptr;
+    }
     GWin = (GLFWwindow*)glfwWindow;
     FirstMouse = true;
+    if (!GWin) return;
+    GPrevKey    = glfwSetKeyCallback(GWin, OnKey);
+    GPrevButton = glfwSetMouseButtonCallback(GWin, OnButton);
+    GPrevCursor = glfwSetCursorPosCallback(GWin, OnCursor);
 }
 
-void Input_Poll(InputState& o){
-    if (!GActive || !GWin) return;
-
-    // --- Movement axes (WASD) ---
-    const int w = glfwGetKey(GWin, GLFW_KEY_W);
-    const int s = glfwGetKey(GWin, GLFW_KEY_S);
-    const int a = glfwGetKey(GWin, GLFW_KEY_A);
-    const int d = glfwGetKey(GWin, GLFW_KEY_D);
-
-    //Z movement
-    o.MoveZ = 0.f;
-    if (w == GLFW_PRESS) o.MoveZ += 1.f;
-    if (s == GLFW_PRESS) o.MoveZ -= 1.f;
-
-    //X movement
-    o.MoveX = 0.f;
-    if (d == GLFW_PRESS) o.MoveX += 1.f;
-    if (a == GLFW_PRESS) o.MoveX -= 1.f;
-
-    //input calc
-    const float len = std::sqrt(o.MoveX*o.MoveX + o.MoveZ*o.MoveZ);
-    if (len > 1e-6f){
-        const float inv = 1.0f / std::max(1.0f, len);
-        o.MoveX *= inv;
-        o.MoveZ *= inv;
+// Engine.cpp times frames on the same clock.
+double Input_Now(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+void Input_Sample(InputState& o, double upTo){
+    const uint64_t head = GRing.Head.load(std::memory_order_acquire);
+    uint64_t tail = GRing.Tail.load(std::memory_order_relaxed);
+    for (; tail != head; ++tail) {
+        const InputEvent& e = GRing.Events[tail & (INPUT_EVENT_RING - 1)];
+        if (e.Time > upTo) break;
+        Apply(e);
     }
+    GRing.Tail.store(tail, std::memory_order_release);
+
+    // Inactive (cursor released) or unbound: events still drain, so nothing
+    // stale reaches the simulation when input comes back.
+    if (GActive && GWin) {
+        //Z movement
+        o.MoveZ = 0.f;
+        if (KeyDown[GLFW_KEY_W]) o.MoveZ += 1.f;
+        if (KeyDown[GLFW_KEY_S]) o.MoveZ -= 1.f;
 
-    //Dash
-    o.Dash = (glfwGetKey(GWin, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) ||
-             (glfwGetKey(GWin, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
-
-    //abilities options for later
-    o.AbilityQ = (glfwGetKey(GWin, GLFW_KEY_Q) == GLFW_PRESS);
-    o.AbilityE = (glfwGetKey(GWin, GLFW_KEY_E) == GLFW_PRESS);
-    o.AbilityR = (glfwGetKey(GWin, GLFW_KEY_R) == GLFW_PRESS);
-    o.Ability1 = (glfwGetKey(GWin, GLFW_KEY_1) == GLFW_PRESS);
-    o.Ability2 = (glfwGetKey(GWin, GLFW_KEY_2) == GLFW_PRESS);
-    o.Ability3 = (glfwGetKey(GWin, GLFW_KEY_3) == GLFW_PRESS);
-    o.Ability4 = (glfwGetKey(GWin, GLFW_KEY_4) == GLFW_PRESS);
-
-    // right input (can decide later for like npc interaction)
-    o.InputRMB = (glfwGetMouseButton(GWin, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS);
-
-
-    //Cursor positioning (for spells)
-    double x, y;
-    glfwGetCursorPos(GWin, &x, &y);
-    if (FirstMouse){ LastX = x; LastY = y; FirstMouse = false; }
-    o.MouseDX = float(x - LastX);
-    o.MouseDY = float(y - LastY);
-    LastX = x; LastY = y;
+        //X movement
+        o.MoveX = 0.f;
+        if (KeyDown[GLFW_KEY_D]) o.MoveX += 1.f;
+        if (KeyDown[GLFW_KEY_A]) o.MoveX -= 1.f;
+
+        //input calc
+        const float len = std::sqrt(o.MoveX*o.MoveX + o.MoveZ*o.MoveZ);
+        if (len > 1e-6f){
+            const float inv = 1.0f / std::max(1.0f, len);
+            o.MoveX *= inv;
+            o.MoveZ *= inv;
+        }
+
+        //Dash, Jump
+        o.Dash = Key(GLFW_KEY_LEFT_SHIFT) || Key(GLFW_KEY_RIGHT_SHIFT);
+        o.Jump = Key(GLFW_KEY_SPACE);
+
+        //abilities options for later
+        o.AbilityQ = Key(GLFW_KEY_Q);
+        o.AbilityE = Key(GLFW_KEY_E);
+        o.AbilityR = Key(GLFW_KEY_R);
+        o.Ability1 = Key(GLFW_KEY_1);
+        o.Ability2 = Key(GLFW_KEY_2);
+        o.Ability3 = Key(GLFW_KEY_3);
+        o.Ability4 = Key(GLFW_KEY_4);
+
+        // right input (can decide later for like npc interaction)
+        o.InputRMB = Button(GLFW_MOUSE_BUTTON_RIGHT);
+
+        //Cursor movement since the last sample (for spells)
+        o.MouseDX = float(AccumDX);
+        o.MouseDY = float(AccumDY);
+    }
+    std::fill(std::begin(KeyPressed), std::end(KeyPressed), false);
+    std::fill(std::begin(ButtonPressed), std::end(ButtonPressed), false);
+    AccumDX = AccumDY = 0.0;
 }
 
+void Input_Poll(InputState& o){ Input_Sample(o, Input_Now()); }
+
 void Input_ResetMouse(){ FirstMouse = true; }
 void Input_SetActive(bool active){ GActive = active; }
 bool Input_IsActive(){ return GActive; }
+uint64_t Input_DroppedEvents(){ return GRing.Dropped.load(std::memory_order_relaxed); }
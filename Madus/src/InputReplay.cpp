@@ -0,0 +1,131 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/InputReplay.h"
+#include "Madus/File.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+// Bit per InputState button, in declaration order. Append only: recordings keep them.
+#define MADUS_INPUT_REC_BUTTONS(X) \
+    X(AbilityQ)                    \
+    X(AbilityE)                    \
+    X(AbilityR)                    \
+    X(Ability1)                    \
+    X(Ability2)                    \
+    X(Ability3)                    \
+    X(Ability4)                    \
+    X(AttackLMB)                   \
+    X(InputRMB)                    \
+    X(Dash)                        \
+    X(Jump)
+
+InputRecSample Pack(uint64_t tick, const InputState& in, bool active){
+    InputRecSample s{};
+    s.Tick = tick;
+    s.Flags = active ? 0u : INPUT_REC_INACTIVE;
+    s.MoveX = in.MoveX; s.MoveZ = in.MoveZ;
+    s.MouseDX = in.MouseDX; s.MouseDY = in.MouseDY;
+    uint32_t bit = 1;
+#define MADUS_INPUT_REC_PACK(name) if (in.name) s.Buttons |= bit; bit <<= 1;
+    MADUS_INPUT_REC_BUTTONS(MADUS_INPUT_REC_PACK)
+#undef MADUS_INPUT_REC_PACK
+    return s;
+}
+
+InputState Unpack(const InputRecSample& s){
+    InputState in{};
+    in.MoveX = s.MoveX; in.MoveZ = s.MoveZ;
+    in.MouseDX = s.MouseDX; in.MouseDY = s.MouseDY;
+    uint32_t bit = 1;
+#define MADUS_INPUT_REC_UNPACK(name) in.name = (s.Buttons & bit) != 0; bit <<= 1;
+    MADUS_INPUT_REC_BUTTONS(MADUS_INPUT_REC_UNPACK)
+#undef MADUS_INPUT_REC_UNPACK
+    return in;
+}
+
+bool SameInput(const InputRecSample& a, const InputRecSample& b){
+    return std::memcmp(&a.MoveX, &b.MoveX, sizeof(float) * 4) == 0 && a.Buttons == b.Buttons && a.Flags == b.Flags;
+}
+}
+
+void InputRecording::Clear(){
+    TickCount = 0;
+    Samples.clear();
+    m_Cursor = 0;
+}
+
+void InputRecording::Record(uint64_t tick, const InputState& in, bool active){
+    const InputRecSample s = Pack(tick, in, active);
+    if (Samples.empty() || !SameInput(Samples.back(), s)) Samples.push_back(s);
+    TickCount = tick + 1;
+}
+
+InputState InputRecording::At(uint64_t tick, bool* active) const {
+    if (active) *active = true;
+    if (Samples.empty() || tick < Samples[0].Tick) return InputState{};
+    if (m_Cursor >= Samples.size() || Samples[m_Cursor].Tick > tick) m_Cursor = 0;   // went back: start over
+    while (m_Cursor + 1 < Samples.size() && Samples[m_Cursor + 1].Tick <= tick) ++m_Cursor;
+    if (active) *active = (Samples[m_Cursor].Flags & INPUT_REC_INACTIVE) == 0;
+    return Unpack(Samples[m_Cursor]);
+}
+
+bool InputRecording::Save(const char* path) const {
+    InputRecHeader h{};
+    std::memcpy(h.Magic, "MINP", 4);
+    h.Version = INPUT_REC_VERSION;
+    h.HeaderSize = sizeof(h);
+    h.TickRate = TickRate;
+    h.TickCount = TickCount;
+    h.SampleCount = Samples.size();
+
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        std::printf("[Input] Failed to write '%s'\n", path);
+        return false;
+    }
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    ok = ok && (Samples.empty() || std::fwrite(Samples.data(), sizeof(InputRecSample), Samples.size(), f) == Samples.size());
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) std::printf("[Input] Failed to write '%s'\n", path);
+    return ok;
+}
+
+bool InputRecording::Load(const char* path){
+    Clear();
+    std::string data;
+    if (!File_ReadAll(path, data)) {
+        std::printf("[Input] Failed to open '%s'\n", path);
+        return false;
+    }
+    InputRecHeader h;
+    if (data.size() < sizeof(h)) {
+        std::printf("[Input] '%s' is too small to be an input recording\n", path);
+        return false;
+    }
+    std::memcpy(&h, data.data(), sizeof(h));
+    if (std::memcmp(h.Magic, "MINP", 4) != 0 || h.HeaderSize < sizeof(h) || h.HeaderSize > data.size()) {
+        std::printf("[Input] '%s' is not an input recording\n", path);
+        return false;
+    }
+    if (h.Version != INPUT_REC_VERSION) {
+        std::printf("[Input] '%s' has version %u, expected %u\n", path, h.Version, INPUT_REC_VERSION);
+        return false;
+    }
+    if (!(h.TickRate > 0.0) || h.SampleCount > (data.size() - h.HeaderSize) / sizeof(InputRecSample)) {
+        std::printf("[Input] '%s' is truncated or corrupt\n", path);
+        return false;
+    }
+    Samples.resize((size_t)h.SampleCount);
+    if (h.SampleCount) std::memcpy(Samples.data(), data.data() + h.HeaderSize, (size_t)h.SampleCount * sizeof(InputRecSample));
+    for (size_t i = 1; i < Samples.size(); ++i)
+        if (Samples[i].Tick <= Samples[i - 1].Tick) {   // At() walks them in order
+            std::printf("[Input] '%s' has samples out of tick order\n", path);
+            Clear();
+            return false;
+        }
+    TickRate = h.TickRate;
+    TickCount = h.TickCount;
+    return true;
+}
@@ -0,0 +1,310 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Jobs.h"
+#include "Madus/AllocTracker.h"
+#include "Madus/Parallel.h"
+#include "Madus/Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+constexpr int64_t kDequeSize = 1024;   // power of two; a full deque runs the job inline
+constexpr int     kSpins     = 256;    // failed find attempts before a worker sleeps
+
+// Chase-Lev deque holding jobs by value. Push/Pop from the owner only, Steal
+// from anyone. A thief copies the slot before claiming it; the owner can only
+// overwrite that slot after the claim moved Top past it, so a copy that wins
+// the CAS is intact. Slots are relaxed atomic words so losing copies aren't
+// data races either.
+struct Deque {
+    static constexpr size_t kWords = sizeof(Job) / sizeof(uint64_t);
+    static_assert(sizeof(Job) % sizeof(uint64_t) == 0 && std::is_trivially_copyable_v<Job>);
+    struct Slot { std::atomic<uint64_t> W[kWords]; };
+
+    std::atomic<int64_t> Top{0}, Bottom{0};
+    Slot Slots[kDequeSize];
+
+    void Write(int64_t i, const Job& j){
+        uint64_t w[kWords];
+        std::memcpy(w, &j, sizeof(Job));
+        Slot& s = Slots[i & (kDequeSize - 1)];
+        for (size_t k = 0; k < kWords; ++k) s.W[k].store(w[k], std::memory_order_relaxed);
+    }
+    void Read(int64_t i, Job& j) const {
+        uint64_t w[kWords];
+        const Slot& s = Slots[i & (kDequeSize - 1)];
+        for (size_t k = 0; k < kWords; ++k) w[k] = s.W[k].load(std::memory_order_relaxed);
+        std::memcpy(static_cast<void*>(&j), w, sizeof(Job));
+    }
+
+    bool Push(const Job& j){
+        const int64_t b = Bottom.load(std::memory_order_relaxed);
+        const int64_t t = Top.load(std::memory_order_acquire);
+        if (b - t >= kDequeSize) return false;
+        Write(b, j);
+        Bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+    bool Pop(Job& out){
+        const int64_t b = Bottom.load(std::memory_order_relaxed) - 1;
+        Bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = Top.load(std::memory_order_seq_cst);
+        if (t > b) { Bottom.store(b + 1, std::memory_order_relaxed); return false; }
+        Read(b, out);
+        bool ok = true;
+        if (t == b) {
+            // last one: race the thieves for it
+            ok = Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            Bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return ok;
+    }
+    bool Steal(Job& out){
+        int64_t t = Top.load(std::memory_order_seq_cst);
+        const int64_t b = Bottom.load(std::memory_order_seq_cst);
+        if (t >= b) return false;
+        Read(t, out);
+        return Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+};
+
+struct alignas(64) JobThread {
+    Deque    Queue;
+    uint32_t Rng = 0;
+};
+
+struct JobSystem {
+    std::vector<std::unique_ptr<JobThread>> Threads;   // [0] is the main thread
+    std::vector<std::thread> Workers;
+    int WorkerCount = 0;
+    std::atomic<bool>    Quit{false};
+    std::atomic<int64_t> Queued{0};                    // in a deque or the inject queue
+    std::atomic<int>     Sleepers{0};
+    std::mutex SleepMutex;
+    std::condition_variable SleepCv;
+
+    std::mutex InjectMutex;                            // jobs from threads without a deque
+    std::deque<Job> Inject;
+    std::mutex MainMutex;
+    std::vector<Job> MainLane;
+};
+
+std::mutex gInitMutex;
+std::atomic<JobSystem*> gJobs{nullptr};
+thread_local int tThread = -1;
+
+JobSystem& Sys(){
+    JobSystem* s = gJobs.load(std::memory_order_acquire);
+    if (!s) { Jobs_Init(); s = gJobs.load(std::memory_order_acquire); }
+    return *s;
+}
+
+void Execute(const Job& j){
+    j.Fn(const_cast<unsigned char*>(j.Payload));
+    if (j.Counter) j.Counter->Pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void Wake(JobSystem& s){
+    if (s.Sleepers.load(std::memory_order_seq_cst) == 0) return;
+    // Taking the lock orders this with a worker that checked Queued and is about to wait.
+    { std::lock_guard<std::mutex> lock(s.SleepMutex); }
+    s.SleepCv.notify_one();
+}
+
+// Own deque first, then steal from a random victim onwards, then the inject queue.
+bool TakeJob(JobSystem& s, int self, Job& out){
+    bool got = self >= 0 && s.Threads[(size_t)self]->Queue.Pop(out);
+    if (!got) {
+        const int n = (int)s.Threads.size();
+        uint32_t r = 0;
+        if (self >= 0) { uint32_t& rng = s.Threads[(size_t)self]->Rng; rng = rng * 1664525u + 1013904223u; r = rng >> 8; }
+        for (int k = 0; k < n && !got; ++k) {
+            const int v = (int)((r + (uint32_t)k) % (uint32_t)n);
+            if (v != self) got = s.Threads[(size_t)v]->Queue.Steal(out);
+        }
+    }
+    if (got) { s.Queued.fetch_sub(1, std::memory_order_relaxed); return true; }
+
+    std::lock_guard<std::mutex> lock(s.InjectMutex);
+    if (s.Inject.empty()) return false;
+    out = s.Inject.front();
+    s.Inject.pop_front();
+    s.Queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void WorkerLoop(JobSystem* s, int index){
+    MADUS_ALLOC_TAG("Jobs");
+    tThread = index;
+    char name[32];
+    std::snprintf(name, sizeof(name), "Worker %d", index);
+    Profiler_SetThreadName(name);
+    Job j;
+    int idle = 0;
+    while (!s->Quit.load(std::memory_order_relaxed)) {
+        if (TakeJob(*s, index, j)) { Execute(j); idle = 0; continue; }
+        if (++idle < kSpins) { std::this_thread::yield(); continue; }
+
+        s->Sleepers.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(s->SleepMutex);
+            s->SleepCv.wait(lock, [s]{
+                return s->Quit.load(std::memory_order_relaxed) || s->Queued.load(std::memory_order_seq_cst) > 0;
+            });
+        }
+        s->Sleepers.fetch_sub(1, std::memory_order_relaxed);
+        idle = 0;
+    }
+}
+
+// Body of every Jobs_ParallelFor job: split off the upper half until the
+// range is down to the grain, then run what is left.
+struct RangeJob {
+    void (*Fn)(void*, size_t, size_t);
+    void*  Ctx;
+    size_t B, E, Grain;
+    JobCounter* Counter;
+
+    void operator()() const {
+        size_t e = E;
+        while (e - B > Grain) {
+            const size_t mid = B + (e - B) / 2;
+            Jobs_Submit(Jobs_Make(RangeJob{ Fn, Ctx, mid, e, Grain, Counter }, Counter));
+            e = mid;
+        }
+        Fn(Ctx, B, e);
+    }
+};
+}
+
+void Jobs_Init(int workers){
+    std::lock_guard<std::mutex> lock(gInitMutex);
+    if (gJobs.load(std::memory_order_relaxed)) return;
+    if (workers < 0) workers = Parallel_HardwareThreads() - 1;
+
+    JobSystem* s = new JobSystem;
+    s->WorkerCount = workers;
+    for (int i = 0; i <= workers; ++i) {
+        s->Threads.push_back(std::make_unique<JobThread>());
+        s->Threads.back()->Rng = 0x9E3779B9u * (uint32_t)(i + 1);
+    }
+    tThread = 0;
+    gJobs.store(s, std::memory_order_release);
+    for (int i = 1; i <= workers; ++i) s->Workers.emplace_back(WorkerLoop, s, i);
+}
+
+void Jobs_Shutdown(){
+    std::lock_guard<std::mutex> lock(gInitMutex);
+    JobSystem* s = gJobs.load(std::memory_order_relaxed);
+    if (!s) return;
+    assert(tThread == 0 && "Jobs_Shutdown from the main thread");
+    {
+        std::lock_guard<std::mutex> sleep(s->SleepMutex);
+        s->Quit.store(true, std::memory_order_relaxed);
+    }
+    s->SleepCv.notify_all();
+    for (std::thread& t : s->Workers) t.join();
+    gJobs.store(nullptr, std::memory_order_release);
+    tThread = -1;
+    delete s;
+}
+
+int Jobs_WorkerCount(){ return Sys().WorkerCount; }
+int Jobs_ThreadIndex(){ return tThread; }
+
+void Jobs_Submit(const Job& job){
+    JobSystem& s = Sys();
+    if (job.Counter) job.Counter->Pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (tThread >= 0) {
+        // Full deque: nobody is keeping up, so running it here is as good as queueing it.
+        if (!s.Threads[(size_t)tThread]->Queue.Push(job)) { Execute(job); return; }
+    } else {
+        std::lock_guard<std::mutex> lock(s.InjectMutex);
+        s.Inject.push_back(job);
+    }
+    s.Queued.fetch_add(1, std::memory_order_seq_cst);
+    Wake(s);
+}
+
+void Jobs_SubmitMain(const Job& job){
+    JobSystem& s = Sys();
+    if (job.Counter) job.Counter->Pending.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(s.MainMutex);
+    s.MainLane.push_back(job);
+}
+
+int Jobs_PumpMain(){
+    JobSystem& s = Sys();
+    assert(tThread == 0 && "main-lane jobs run on the main thread");
+    std::vector<Job> run;   // local: a main-lane job may wait, which pumps again
+    {
+        std::lock_guard<std::mutex> lock(s.MainMutex);
+        if (s.MainLane.empty()) return 0;
+        run.swap(s.MainLane);
+    }
+    // Jobs queued by these run on the next pump.
+    for (const Job& j : run) Execute(j);
+    return (int)run.size();
+}
+
+void Jobs_Wait(JobCounter& counter){
+    JobSystem& s = Sys();
+    const int self = tThread;
+    Job j;
+    while (!counter.Done()) {
+        if (TakeJob(s, self, j)) { Execute(j); continue; }
+        if (self == 0 && Jobs_PumpMain() > 0) continue;
+        std::this_thread::yield();
+    }
+}
+
+void Jobs_ParallelFor(size_t count, size_t grain, void (*fn)(void* ctx, size_t b, size_t e), void* ctx){
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if (count <= grain || Jobs_WorkerCount() == 0) { fn(ctx, 0, count); return; }
+
+    JobCounter done;
+    RangeJob{ fn, ctx, 0, count, grain, &done }();
+    Jobs_Wait(done);
+}
+
+void TaskGraph::Depend(TaskId task, TaskId dependsOn){
+    assert(task < m_Nodes.size() && dependsOn < m_Nodes.size() && task != dependsOn);
+    m_Nodes[dependsOn].Next.push_back(task);
+    ++m_Nodes[task].Deps;
+}
+
+void TaskGraph::Launch(TaskId id){
+    TaskGraph* g = this;
+    const Job j = Jobs_Make([g, id]{
+        Node& n = g->m_Nodes[id];
+        n.Work.Fn(n.Work.Payload);
+        // Successors are submitted before this job's count drops, so Run() can't see zero early.
+        for (TaskId next : n.Next)
+            if (g->m_Remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) g->Launch(next);
+    }, &m_Counter);
+    if (m_Nodes[id].Main) Jobs_SubmitMain(j);
+    else Jobs_Submit(j);
+}
+
+void TaskGraph::Run(){
+    if (m_Nodes.empty()) return;
+    if (m_RemainingSize < m_Nodes.size()) {
+        m_Remaining = std::make_unique<std::atomic<uint32_t>[]>(m_Nodes.size());
+        m_RemainingSize = m_Nodes.size();
+    }
+    for (size_t i = 0; i < m_Nodes.size(); ++i) m_Remaining[i].store(m_Nodes[i].Deps, std::memory_order_relaxed);
+    bool anyRoot = false;
+    for (size_t i = 0; i < m_Nodes.size(); ++i)
+        if (m_Nodes[i].Deps == 0) { Launch((TaskId)i); anyRoot = true; }
+    assert(anyRoot && "TaskGraph has a cycle");
+    (void)anyRoot;
+    Jobs_Wait(m_Counter);
+}
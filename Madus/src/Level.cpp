@@ -1,49 +1,148 @@
 // Copyright Lukas Licon 2025, All Rights Reserved.
 
-#include "Level.h"
-#include <fstream>
-#include <sstream>
-#include <string>
+#include "Madus/Level.h"
+#include <algorithm>
+#include <charconv>
 #include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+static bool IsSpace(char c){ return c == ' ' || c == '\t' || c == '\r'; }
 
-static bool IsCommentOrBlank(const std::string& s){
-    // trim left
-    size_t i = s.find_first_not_of(" \t\r\n");
-    if (i == std::string::npos) return true;
-    if (s[i] == '#') return true;
-    if (i + 1 < s.size() && s[i] == '/' && s[i+1] == '/') return true;
-    return false;
+// Parses one float at p (skipping blanks and an optional '+', which
+// from_chars does not accept). Returns the position after it, or nullptr.
+static const char* ParseFloat(const char* p, const char* end, float& out){
+    while (p < end && IsSpace(*p)) ++p;
+    if (p < end && *p == '+') ++p;
+    const std::from_chars_result r = std::from_chars(p, end, out);
+    return r.ec == std::errc() ? r.ptr : nullptr;
+}
+
+bool Level::ParseTxt(const char* text, size_t len, const char* name){
+    Clear();
+    const char* p = text;
+    const char* const end = text + len;
+    m_Owned.reserve((size_t)std::count(p, end, '\n') + 1);
+
+    int lineno = 0;
+    while (p < end) {
+        const char* eol = (const char*)std::memchr(p, '\n', (size_t)(end - p));
+        if (!eol) eol = end;
+        ++lineno;
+
+        const char* s = p;
+        while (s < eol && IsSpace(*s)) ++s;
+        const bool skip = s == eol || *s == '#' || (s + 1 < eol && s[0] == '/' && s[1] == '/');
+        if (!skip) {
+            AABB2 b;
+            const char* q = ParseFloat(s, eol, b.minx);
+            if (q) q = ParseFloat(q, eol, b.minz);
+            if (q) q = ParseFloat(q, eol, b.maxx);
+            if (q) q = ParseFloat(q, eol, b.maxz);
+            if (q) {
+                if (b.maxx < b.minx) std::swap(b.maxx, b.minx);
+                if (b.maxz < b.minz) std::swap(b.maxz, b.minz);
+                m_Owned.push_back(b);
+            } else {
+                std::printf("[Level] Parse error at %s:%d -> '%.*s'\n", name, lineno, (int)std::min<ptrdiff_t>(eol - p, 120), p);
+            }
+        }
+        p = eol + 1;
+    }
+
+    m_Colliders = m_Owned.data();
+    m_Count = m_Owned.size();
+    return m_Count > 0;
 }
 
 bool Level::LoadTxt(const char* path){
-    std::ifstream f(path);
-    if (!f.is_open()){
+    std::string text;
+    if (!File_ReadAll(path, text)){
         std::printf("[Level] Failed to open '%s'\n", path);
+        Clear();
         return false;
     }
+    const bool ok = ParseTxt(text.data(), text.size(), path);
+    std::printf("[Level] Loaded %zu colliders from '%s'\n", m_Count, path);
+    return ok;
+}
 
-    Colliders.clear();
-    std::string line;
-    int lineno = 0;
-    int added = 0;
+bool Level::LoadBin(const char* path){
+    Clear();
+    MappedFile f;
+    if (!f.Open(path)) {
+        std::printf("[Level] Failed to open '%s'\n", path);
+        return false;
+    }
+    LevelBinHeader h;
+    if (f.Size() < sizeof(h)) {
+        std::printf("[Level] '%s' is too small to be a cooked level\n", path);
+        return false;
+    }
+    std::memcpy(&h, f.Data(), sizeof(h));
+    if (std::memcmp(h.Magic, "MLVL", 4) != 0 || h.HeaderSize < sizeof(h)) {
+        std::printf("[Level] '%s' is not a cooked level\n", path);
+        return false;
+    }
+    if (h.Version != LEVEL_BIN_VERSION) {
+        std::printf("[Level] '%s' has version %u, expected %u (re-cook it)\n", path, h.Version, LEVEL_BIN_VERSION);
+        return false;
+    }
+    // Structure only: the collider block is trusted as cooked (normalized min/max)
+    // so loading never touches its pages. It must start past the header, aligned
+    // for AABB2 (the mapping itself is page-aligned).
+    if (h.ColliderOffset < h.HeaderSize || h.ColliderOffset % alignof(AABB2) != 0 || h.ColliderOffset > f.Size()
+        || h.ColliderCount > (f.Size() - h.ColliderOffset) / sizeof(AABB2)) {
+        std::printf("[Level] '%s' is truncated or corrupt\n", path);
+        return false;
+    }
 
-    while (std::getline(f, line)){
-        ++lineno;
-        if (IsCommentOrBlank(line)) continue;
+    m_File = std::move(f);
+    m_Colliders = reinterpret_cast<const AABB2*>(m_File.Data() + h.ColliderOffset);
+    m_Count = (size_t)h.ColliderCount;
+    std::printf("[Level] Mapped %zu colliders from '%s'\n", m_Count, path);
+    return m_Count > 0;
+}
 
-        std::istringstream iss(line);
-        float minx, minz, maxx, maxz;
-        if (!(iss >> minx >> minz >> maxx >> maxz)){
-            std::printf("[Level] Parse error at %s:%d -> '%s'\n", path, lineno, line.c_str());
-            continue;
-        }
-        if (maxx < minx) std::swap(maxx, minx);
-        if (maxz < minz) std::swap(maxz, minz);
+bool Level::SaveBin(const char* path) const {
+    LevelBinHeader h{};
+    std::memcpy(h.Magic, "MLVL", 4);
+    h.Version = LEVEL_BIN_VERSION;
+    h.HeaderSize = sizeof(h);
+    h.ColliderOffset = (sizeof(h) + 15) & ~(uint64_t)15;
+    h.ColliderCount = m_Count;
+    h.Bounds = m_Count ? m_Colliders[0] : AABB2{0, 0, 0, 0};
+    for (size_t i = 1; i < m_Count; ++i) {
+        const AABB2& b = m_Colliders[i];
+        h.Bounds.minx = std::min(h.Bounds.minx, b.minx); h.Bounds.minz = std::min(h.Bounds.minz, b.minz);
+        h.Bounds.maxx = std::max(h.Bounds.maxx, b.maxx); h.Bounds.maxz = std::max(h.Bounds.maxz, b.maxz);
+    }
 
-        Colliders.push_back(AABB2{minx, minz, maxx, maxz});
-        ++added;
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        std::printf("[Level] Failed to write '%s'\n", path);
+        return false;
     }
+    static const unsigned char pad[16] = {};
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    ok = ok && std::fwrite(pad, 1, h.ColliderOffset - sizeof(h), f) == h.ColliderOffset - sizeof(h);
+    ok = ok && (m_Count == 0 || std::fwrite(m_Colliders, sizeof(AABB2), m_Count, f) == m_Count);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) std::printf("[Level] Failed to write '%s'\n", path);
+    return ok;
+}
+
+void Level::SetColliders(std::vector<AABB2> colliders){
+    Clear();
+    m_Owned = std::move(colliders);
+    m_Colliders = m_Owned.data();
+    m_Count = m_Owned.size();
+}
 
-    std::printf("[Level] Loaded %d colliders from '%s'\n", added, path);
-    return (added > 0);
+void Level::Clear(){
+    m_File.Close();
+    m_Owned.clear();
+    m_Colliders = nullptr;
+    m_Count = 0;
 }
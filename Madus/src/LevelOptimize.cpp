@@ -0,0 +1,377 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/LevelOptimize.h"
+#include "Madus/Collision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+// Resolve order of a box: source index in the high half, piece of a split
+// box in the low half. Surviving boxes keep their source order.
+using Key = uint64_t;
+
+bool Contains(const AABB2& c, const AABB2& b){
+    return c.minx <= b.minx && c.minz <= b.minz && c.maxx >= b.maxx && c.maxz >= b.maxz;
+}
+
+bool Inside(const AABB2& w, float x, float z){ return x >= w.minx && x <= w.maxx && z >= w.minz && z <= w.maxz; }
+
+AABB2 Grown(const AABB2& b, float by){ return { b.minx - by, b.minz - by, b.maxx + by, b.maxz + by }; }
+
+AABB2 Union(const AABB2& a, const AABB2& b){
+    return { std::min(a.minx, b.minx), std::min(a.minz, b.minz), std::max(a.maxx, b.maxx), std::max(a.maxz, b.maxz) };
+}
+
+// Boxes (grown by the query radius) bucketed into a uniform grid. Each cell
+// lists its boxes in resolve order. Boxes can be edited in place: a box only
+// ever gains cells, and one listed in a cell it no longer reaches is harmless,
+// so the optimizer can try a change and take it back without a rebuild.
+struct BoxGrid {
+    float ox = 0, oz = 0, inv = 1, radius = 0;
+    int   nx = 1, nz = 1;
+    std::vector<AABB2>    boxes;
+    std::vector<Key>      keys;
+    std::vector<uint8_t>  alive;
+    std::vector<std::vector<uint32_t>> cells;
+
+    void Init(const AABB2& bounds, float r, size_t count){
+        const float ext = std::max(bounds.maxx - bounds.minx, bounds.maxz - bounds.minz);
+        const float side = std::clamp(std::sqrt((float)count), 64.f, 4096.f); // ~1 box per cell
+        const float cell = std::max(ext / side, 1e-3f);
+        ox = bounds.minx; oz = bounds.minz; inv = 1.f / cell; radius = r;
+        nx = std::max(1, (int)std::ceil((bounds.maxx - bounds.minx) * inv));
+        nz = std::max(1, (int)std::ceil((bounds.maxz - bounds.minz) * inv));
+        cells.assign((size_t)nx * nz, {});
+        boxes.clear(); keys.clear(); alive.clear();
+    }
+    void Build(std::span<const AABB2> b, const AABB2& bounds, float r){
+        Init(bounds, r, b.size());
+        for (size_t i = 0; i < b.size(); ++i) Add(b[i], (Key)i << 32);
+    }
+
+    int CellX(float x) const { return std::clamp((int)std::floor((x - ox) * inv), 0, nx - 1); }
+    int CellZ(float z) const { return std::clamp((int)std::floor((z - oz) * inv), 0, nz - 1); }
+    size_t Cell(float x, float z) const { return (size_t)CellZ(z) * nx + CellX(x); }
+
+    template<class F> void ForCells(const AABB2& bb, F&& fn) const {
+        const int x0 = CellX(bb.minx), x1 = CellX(bb.maxx);
+        const int z0 = CellZ(bb.minz), z1 = CellZ(bb.maxz);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x) fn((size_t)z * nx + x);
+    }
+
+    uint32_t Add(const AABB2& b, Key k){
+        const uint32_t s = (uint32_t)boxes.size();
+        boxes.push_back(b); keys.push_back(k); alive.push_back(1);
+        Set(s, b);
+        return s;
+    }
+    void Set(uint32_t s, const AABB2& b){
+        boxes[s] = b;
+        ForCells(Grown(b, radius), [&](size_t c){
+            std::vector<uint32_t>& list = cells[c];
+            auto it = std::lower_bound(list.begin(), list.end(), keys[s], [this](uint32_t o, Key k){ return keys[o] < k; });
+            while (it != list.end() && keys[*it] == keys[s] && *it != s) ++it;
+            if (it == list.end() || *it != s) list.insert(it, s);
+        });
+    }
+
+    // Same closest-point math as ResolveCircleAABB2.
+    float MinDist2(float px, float pz, float cap) const {
+        float best = cap;
+        for (uint32_t s : cells[Cell(px, pz)]) {
+            if (!alive[s]) continue;
+            const AABB2& b = boxes[s];
+            const float qx = std::min(std::max(px, b.minx), b.maxx);
+            const float qz = std::min(std::max(pz, b.minz), b.maxz);
+            const float dx = px - qx, dz = pz - qz;
+            best = std::min(best, dx*dx + dz*dz);
+        }
+        return best;
+    }
+
+    // ResolveCircleAABB2 over every live box in key order, as MoveAndSlideXZ
+    // depenetrates. A box can only move the circle while it is within radius,
+    // i.e. listed in the cell under the current position; so after each push
+    // continue with the next key in the cell the circle is now in.
+    void Resolve(Vec3& pos, Vec3& vel) const {
+        Key next = 0;
+        for (;;) {
+            const std::vector<uint32_t>& list = cells[Cell(pos.x, pos.z)];
+            auto it = std::lower_bound(list.begin(), list.end(), next, [this](uint32_t o, Key k){ return keys[o] < k; });
+            while (it != list.end() && !alive[*it]) ++it;
+            if (it == list.end()) return;
+            ResolveCircleAABB2(pos, vel, radius, boxes[*it]);
+            next = keys[*it] + 1;
+        }
+    }
+};
+
+// A circle position with a velocity to be cancelled, and where the pushout leaves it.
+struct Probe { float x, z, vx, vz; };
+struct Outcome {
+    float x, z, vx, vz, d2;
+    bool operator==(const Outcome&) const = default;
+};
+
+Outcome Evaluate(const BoxGrid& g, const Probe& p){
+    Vec3 pos{ p.x, 0.f, p.z }, vel{ p.vx, 0.f, p.vz };
+    const float d2 = g.MinDist2(p.x, p.z, g.radius * g.radius);
+    g.Resolve(pos, vel);
+    return { pos.x, pos.z, vel.x, vel.z, d2 };
+}
+
+AABB2 ProbeBounds(std::span<const AABB2> a, std::span<const AABB2> b, float radius){
+    AABB2 bounds{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                 -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+    for (std::span<const AABB2> set : { a, b })
+        for (const AABB2& bb : set) bounds = Union(bounds, bb);
+    return Grown(bounds, 2.f * radius);
+}
+
+// A jittered grid over the bounds plus points at and around every source
+// corner, where seams and merges would show up.
+std::vector<Probe> MakeProbes(std::span<const AABB2> source, const AABB2& bounds, float radius, size_t gridSamples){
+    uint32_t seed = 0x9E3779B9u;
+    auto jitter = [&seed]{ seed = seed * 1664525u + 1013904223u; return (float)(seed >> 8) * (1.f / 16777216.f); };
+    std::vector<Probe> probes;
+    auto add = [&](float x, float z){
+        const float a = jitter() * 6.2831853f;
+        probes.push_back({ x, z, std::cos(a), std::sin(a) });
+    };
+
+    const int side = std::max(2, (int)std::sqrt((double)gridSamples));
+    const float sx = (bounds.maxx - bounds.minx) / (float)side, sz = (bounds.maxz - bounds.minz) / (float)side;
+    probes.reserve((size_t)side * side + source.size() * 20);
+    for (int j = 0; j < side; ++j)
+        for (int i = 0; i < side; ++i) {
+            const float jx = jitter(), jz = jitter();
+            add(bounds.minx + (i + jx) * sx, bounds.minz + (j + jz) * sz);
+        }
+    const float h = 0.5f * radius;
+    for (const AABB2& b : source)
+        for (float cx : { b.minx, b.maxx })
+            for (float cz : { b.minz, b.maxz }) {
+                add(cx, cz);
+                add(cx - h, cz - h); add(cx + h, cz - h);
+                add(cx - h, cz + h); add(cx + h, cz + h);
+            }
+    return probes;
+}
+
+// One optimization attempt over the source. Every edit is applied to the
+// grid, the probes near it are resolved again, and it is taken back unless
+// all of them still end exactly where the source leaves them.
+struct Optimizer {
+    const LevelOptimizeOptions& Opt;
+    std::span<const AABB2> Source;
+    const std::vector<Probe>& Probes;
+    const std::vector<Outcome>& Expected;
+    const std::vector<uint8_t>& Frozen;   // source boxes no edit may touch
+    BoxGrid Grid;
+    std::vector<std::vector<uint32_t>> ProbeCells;
+    LevelOptimizeStats Stats;
+
+    struct Edit { AABB2 Window; uint32_t A, B; };
+    std::vector<Edit> Edits;
+
+    uint32_t Src(uint32_t s) const { return (uint32_t)(Grid.keys[s] >> 32); }
+    bool Editable(uint32_t s) const { return Grid.alive[s] && !Frozen[Src(s)]; }
+
+    void Init(const AABB2& bounds){
+        Grid.Build(Source, bounds, Opt.Radius);
+        ProbeCells.assign(Grid.cells.size(), {});
+        for (uint32_t i = 0; i < (uint32_t)Probes.size(); ++i) ProbeCells[Grid.Cell(Probes[i].x, Probes[i].z)].push_back(i);
+    }
+
+    // Probes starting within two radii of what changed.
+    bool Agrees(const AABB2& changed) const {
+        const AABB2 w = Grown(changed, 2.f * Opt.Radius);
+        bool ok = true;
+        Grid.ForCells(w, [&](size_t c){
+            for (uint32_t i : ProbeCells[c]) {
+                if (!ok) return;
+                if (Inside(w, Probes[i].x, Probes[i].z) && !(Evaluate(Grid, Probes[i]) == Expected[i])) ok = false;
+            }
+        });
+        return ok;
+    }
+    template<class Undo> bool Commit(const AABB2& changed, uint32_t a, uint32_t b, Undo&& undo){
+        if (Agrees(changed)) { Edits.push_back({ Grown(changed, 2.f * Opt.Radius), Src(a), Src(b) }); return true; }
+        undo();
+        ++Stats.Rejected;
+        return false;
+    }
+
+    // Dropping a box inside another; of two equal boxes the later one goes.
+    bool TryDrop(uint32_t s){
+        const AABB2 b = Grid.boxes[s];
+        for (uint32_t o : Grid.cells[Grid.Cell(b.minx, b.minz)]) {
+            if (o == s || !Grid.alive[o] || !Contains(Grid.boxes[o], b)) continue;
+            if (Contains(b, Grid.boxes[o]) && Grid.keys[o] > Grid.keys[s]) continue;
+            Grid.alive[s] = 0;
+            if (Commit(b, s, s, [&]{ Grid.alive[s] = 1; })) { ++Stats.Dropped; return true; }
+            return false;
+        }
+        return false;
+    }
+
+    // Merging with a box of identical extent across 'axis' whose interval
+    // along it touches or overlaps; the union is a box and takes the place
+    // of whichever part resolves first.
+    bool TryMerge(uint32_t s, bool alongX){
+        auto lo  = [alongX](const AABB2& b){ return alongX ? b.minx : b.minz; };
+        auto hi  = [alongX](const AABB2& b){ return alongX ? b.maxx : b.maxz; };
+        auto lo2 = [alongX](const AABB2& b){ return alongX ? b.minz : b.minx; };
+        auto hi2 = [alongX](const AABB2& b){ return alongX ? b.maxz : b.maxx; };
+        const AABB2 a = Grid.boxes[s];
+        uint32_t found = UINT32_MAX;
+        Grid.ForCells(a, [&](size_t c){
+            for (uint32_t o : Grid.cells[c]) {
+                if (found != UINT32_MAX) return;
+                const AABB2& b = Grid.boxes[o];
+                if (o != s && Editable(o) && lo2(a) == lo2(b) && hi2(a) == hi2(b) && lo(b) <= hi(a) && lo(a) <= hi(b)) found = o;
+            }
+        });
+        if (found == UINT32_MAX) return false;
+        const uint32_t keep = Grid.keys[s] < Grid.keys[found] ? s : found, gone = keep == s ? found : s;
+        const AABB2 old = Grid.boxes[keep], merged = Union(a, Grid.boxes[found]);
+        Grid.Set(keep, merged);
+        Grid.alive[gone] = 0;
+        if (Commit(merged, keep, gone, [&]{ Grid.boxes[keep] = old; Grid.alive[gone] = 1; })) { ++Stats.Merged; return true; }
+        return false;
+    }
+
+    // Cuts are computed once and shared by both neighbours, so the pieces
+    // tile the box exactly; they resolve in place of it, in order.
+    bool TrySplit(uint32_t s, float maxLen){
+        const AABB2 b = Grid.boxes[s];
+        const float lx = b.maxx - b.minx, lz = b.maxz - b.minz;
+        const bool  alongX = lx >= lz;
+        const float len = alongX ? lx : lz;
+        if (!(len > maxLen)) return false;
+        const int   n = (int)std::ceil(len / maxLen);
+        const float base = alongX ? b.minx : b.minz, end = alongX ? b.maxx : b.maxz;
+        const size_t firstAdded = Grid.boxes.size();
+        float prev = base;
+        for (int k = 1; k <= n; ++k) {
+            const float cut = (k == n) ? end : std::min(end, base + len * (float)k / (float)n);
+            AABB2 p = b;
+            if (alongX) { p.minx = prev; p.maxx = cut; } else { p.minz = prev; p.maxz = cut; }
+            if (k == 1) Grid.boxes[s] = p; else Grid.Add(p, Grid.keys[s] + (Key)(k - 1));
+            prev = cut;
+        }
+        auto undo = [&]{
+            Grid.boxes[s] = b;
+            for (size_t i = firstAdded; i < Grid.boxes.size(); ++i) Grid.alive[i] = 0;
+        };
+        if (Commit(b, s, s, undo)) { Stats.Split += (size_t)n - 1; return true; }
+        return false;
+    }
+
+    void Run(){
+        // Merging exposes new containments and vice versa; iterate to a fixed point.
+        const uint32_t count = (uint32_t)Grid.boxes.size();
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (uint32_t s = 0; s < count; ++s) {
+                if (!Editable(s)) continue;
+                if (Opt.DropContained && TryDrop(s)) { changed = true; continue; }
+                if (Opt.MergeAdjacent) changed |= TryMerge(s, true) || TryMerge(s, false);
+            }
+            ++Stats.Passes;
+        }
+        if (Opt.SplitLength > 0.f)
+            for (uint32_t s = 0; s < count; ++s)
+                if (Editable(s)) TrySplit(s, Opt.SplitLength);
+    }
+
+    std::vector<AABB2> Result() const {
+        std::vector<uint32_t> live;
+        for (uint32_t s = 0; s < (uint32_t)Grid.boxes.size(); ++s) if (Grid.alive[s]) live.push_back(s);
+        std::sort(live.begin(), live.end(), [this](uint32_t a, uint32_t b){ return Grid.keys[a] < Grid.keys[b]; });
+        std::vector<AABB2> out;
+        out.reserve(live.size());
+        for (uint32_t s : live) out.push_back(Grid.boxes[s]);
+        return out;
+    }
+};
+
+} // namespace
+
+std::vector<AABB2> Level_Optimize(std::span<const AABB2> in, const LevelOptimizeOptions& opt, LevelOptimizeStats* stats){
+    std::vector<AABB2> source(in.begin(), in.end());
+    for (AABB2& b : source) {
+        if (b.maxx < b.minx) std::swap(b.minx, b.maxx);
+        if (b.maxz < b.minz) std::swap(b.minz, b.maxz);
+    }
+    LevelOptimizeStats s;
+    s.Before = s.After = source.size();
+    if (source.empty() || opt.Radius <= 0.f) { if (stats) *stats = s; return source; }
+
+    // What the source does to every probe Level_VerifyPushout will use.
+    const AABB2 bounds = ProbeBounds(source, source, opt.Radius);
+    const std::vector<Probe> probes = MakeProbes(source, bounds, opt.Radius, opt.VerifySamples);
+    std::vector<Outcome> expected(probes.size());
+    {
+        BoxGrid ref;
+        ref.Build(source, bounds, opt.Radius);
+        for (size_t i = 0; i < probes.size(); ++i) expected[i] = Evaluate(ref, probes[i]);
+    }
+
+    // Edits are checked near where they happen. A circle pushed in from
+    // further away can still tell the difference, so check every probe at
+    // the end; edits around a miss are frozen and the pass starts over.
+    std::vector<uint8_t> frozen(source.size(), 0);
+    for (;;) {
+        Optimizer o{ opt, source, probes, expected, frozen, {}, {}, {}, {} };
+        o.Init(bounds);
+        o.Run();
+
+        bool newlyFrozen = false, missed = false;
+        for (size_t i = 0; i < probes.size(); ++i) {
+            const Outcome got = Evaluate(o.Grid, probes[i]);
+            if (got == expected[i]) continue;
+            missed = true;
+            for (const Optimizer::Edit& e : o.Edits) {
+                if (!Inside(e.Window, probes[i].x, probes[i].z) && !Inside(e.Window, got.x, got.z) &&
+                    !Inside(e.Window, expected[i].x, expected[i].z)) continue;
+                for (uint32_t b : { e.A, e.B }) if (!frozen[b]) { frozen[b] = 1; newlyFrozen = true; }
+            }
+        }
+        if (missed && !newlyFrozen) std::fill(frozen.begin(), frozen.end(), 1);   // keep the source as is
+        if (missed) continue;
+
+        s = o.Stats;
+        s.Before = source.size();
+        std::vector<AABB2> out = o.Result();
+        s.After = out.size();
+        if (stats) *stats = s;
+        return out;
+    }
+}
+
+LevelVerifyResult Level_VerifyPushout(std::span<const AABB2> original, std::span<const AABB2> optimized,
+                                      float radius, size_t gridSamples){
+    LevelVerifyResult r;
+    if (original.empty() && optimized.empty()) return r;
+
+    const AABB2 bounds = ProbeBounds(original, optimized, radius);
+    BoxGrid ga, gb;
+    ga.Build(original, bounds, radius);
+    gb.Build(optimized, bounds, radius);
+
+    for (const Probe& p : MakeProbes(original, bounds, radius, gridSamples)) {
+        ++r.Samples;
+        const Outcome a = Evaluate(ga, p), b = Evaluate(gb, p);
+        if (a.d2 != b.d2) ++r.Mismatches;
+        if (a.x != b.x || a.z != b.z || a.vx != b.vx || a.vz != b.vz) {
+            ++r.ResolveMismatches;
+            r.MaxResolveError = std::max(r.MaxResolveError, std::max(std::fabs(a.x - b.x), std::fabs(a.z - b.z)));
+        }
+    }
+    return r;
+}
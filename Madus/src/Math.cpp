@@ -2,6 +2,13 @@
 
 #include "Madus/Math.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+  #include <xmmintrin.h>
+  #define MADUS_MATH_SSE 1
+#else
+  #define MADUS_MATH_SSE 0
+#endif
+
 Mat4 Perspective(float fovY, float a, float n, float f){
     float s = 1.f / std::tan(fovY*0.5f);
     Mat4 M{};
@@ -49,3 +56,62 @@ Mat4 TRS(const Vec3& t, const Quat& r, const Vec3& s){
     R.m[12]=t.x; R.m[13]=t.y; R.m[14]=t.z;
     return R;
 }
+Mat4 MulM(const Mat4& A, const Mat4& B){
+    Mat4 R{};
+    for(int c=0;c<4;++c)
+        for(int r=0;r<4;++r)
+            R.m[c*4+r] = A.m[0*4+r]*B.m[c*4+0] + A.m[1*4+r]*B.m[c*4+1] + A.m[2*4+r]*B.m[c*4+2] + A.m[3*4+r]*B.m[c*4+3];
+    return R;
+}
+
+// Column c of A*B is A.col0*B[c][0] + A.col1*B[c][1] + A.col2*B[c][2] + A.col3*B[c][3],
+// summed in the same order as MulM (and never contracted to FMA), so both agree exactly.
+void MulMBatch(const Mat4* A, const Mat4* B, Mat4* out, size_t n){
+#if MADUS_MATH_SSE
+    for (size_t i = 0; i < n; ++i) {
+        const float* a = A[i].m;
+        const float* b = B[i].m;
+        const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+        __m128 r[4];
+        for (int c = 0; c < 4; ++c) {
+            __m128 v = _mm_mul_ps(a0, _mm_set1_ps(b[c*4 + 0]));
+            v = _mm_add_ps(v, _mm_mul_ps(a1, _mm_set1_ps(b[c*4 + 1])));
+            v = _mm_add_ps(v, _mm_mul_ps(a2, _mm_set1_ps(b[c*4 + 2])));
+            v = _mm_add_ps(v, _mm_mul_ps(a3, _mm_set1_ps(b[c*4 + 3])));
+            r[c] = v;
+        }
+        // store after computing so out may alias A or B
+        for (int c = 0; c < 4; ++c) _mm_storeu_ps(out[i].m + c*4, r[c]);
+    }
+#else
+    for (size_t i = 0; i < n; ++i) out[i] = MulM(A[i], B[i]);
+#endif
+}
+
+Frustum FrustumFromMatrix(const Mat4& M){
+    // Gribb/Hartmann: planes are row 3 +/- rows 0..2 of the (column-major) matrix.
+    auto row = [&](int r, int c){ return M.m[c*4 + r]; };
+    Frustum f{};
+    for (int i = 0; i < 3; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            f.p[i*2 + 0][c] = row(3,c) + row(i,c);
+            f.p[i*2 + 1][c] = row(3,c) - row(i,c);
+        }
+    }
+    for (auto& pl : f.p) {
+        float L = std::sqrt(pl[0]*pl[0] + pl[1]*pl[1] + pl[2]*pl[2]);
+        if (L > 1e-6f) { pl[0] /= L; pl[1] /= L; pl[2] /= L; pl[3] /= L; }
+    }
+    return f;
+}
+
+bool FrustumTestAABB(const Frustum& f, const Vec3& mn, const Vec3& mx){
+    for (const auto& pl : f.p) {
+        // Corner furthest along the plane normal
+        const float x = pl[0] >= 0.f ? mx.x : mn.x;
+        const float y = pl[1] >= 0.f ? mx.y : mn.y;
+        const float z = pl[2] >= 0.f ? mx.z : mn.z;
+        if (pl[0]*x + pl[1]*y + pl[2]*z + pl[3] < 0.f) return false;
+    }
+    return true;
+}
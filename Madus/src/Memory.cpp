@@ -0,0 +1,136 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Memory.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+constexpr size_t kBlockAlign = 64;   // arena blocks start on a cache line
+
+size_t AlignUp(size_t v, size_t a){ return (v + a - 1) & ~(a - 1); }
+}
+
+// ---- LinearArena ----
+
+LinearArena::LinearArena(size_t bytes){
+    m_Resource.Arena = this;
+    if (bytes) {
+        m_Block = static_cast<unsigned char*>(::operator new(bytes, std::align_val_t(kBlockAlign)));
+        m_Size = bytes;
+    }
+}
+
+LinearArena::~LinearArena(){
+    FreeOverflow(0);
+    if (m_Block) ::operator delete(m_Block, std::align_val_t(kBlockAlign));
+}
+
+void* LinearArena::Alloc(size_t bytes, size_t align){
+    assert(align && (align & (align - 1)) == 0);
+    if (m_Block) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(m_Block);
+        const size_t at = AlignUp(base + m_Used, align) - base;
+        if (at + bytes <= m_Size) {
+            m_Used = at + bytes;
+            m_HighWater = std::max(m_HighWater, m_Used + m_OverflowBytes);
+            return m_Block + at;
+        }
+    }
+    // Out of block: heap until the next Reset makes the block big enough.
+    align = std::max(align, alignof(std::max_align_t));
+    void* p = ::operator new(std::max<size_t>(bytes, 1), std::align_val_t(align));
+    m_Overflow.push_back({ p, bytes, align });
+    m_OverflowBytes += bytes + align;
+    m_HighWater = std::max(m_HighWater, m_Used + m_OverflowBytes);
+    return p;
+}
+
+void LinearArena::FreeOverflow(size_t keep){
+    while (m_Overflow.size() > keep) {
+        const Overflow& o = m_Overflow.back();
+        ::operator delete(o.Ptr, std::align_val_t(o.Align));
+        m_OverflowBytes -= o.Bytes + o.Align;
+        m_Overflow.pop_back();
+    }
+}
+
+void LinearArena::Rewind(const Marker& m){
+    assert(m.Used <= m_Used && m.Overflow <= m_Overflow.size());
+    FreeOverflow(m.Overflow);
+    m_Used = m.Used;
+}
+
+void LinearArena::Reset(){
+    FreeOverflow(0);
+    m_Used = 0;
+    if (m_HighWater > m_Size) {
+        if (m_Block) ::operator delete(m_Block, std::align_val_t(kBlockAlign));
+        m_Size = AlignUp(m_HighWater + m_HighWater / 4, 4096);
+        m_Block = static_cast<unsigned char*>(::operator new(m_Size, std::align_val_t(kBlockAlign)));
+    }
+}
+
+LinearArena& Memory_Scratch(){
+    static thread_local LinearArena tScratch(64 * 1024);
+    // Nothing outlives the outermost scope, so an idle arena may grow here.
+    if (tScratch.Used() == 0 && tScratch.HighWater() > tScratch.Capacity()) tScratch.Reset();
+    return tScratch;
+}
+
+// ---- FixedPool ----
+
+FixedPool::FixedPool(size_t blockSize, size_t blockAlign, size_t blocksPerPage)
+    : m_BlockAlign(std::max(blockAlign, alignof(FreeBlock)))
+    , m_PerPage(std::max<size_t>(1, blocksPerPage)){
+    assert((m_BlockAlign & (m_BlockAlign - 1)) == 0);
+    m_BlockSize = AlignUp(std::max(blockSize, sizeof(FreeBlock)), m_BlockAlign);
+    m_Resource.Pool = this;
+}
+
+FixedPool::~FixedPool(){ Clear(); }
+
+void FixedPool::AddPage(){
+    unsigned char* page = static_cast<unsigned char*>(::operator new(m_BlockSize * m_PerPage, std::align_val_t(m_BlockAlign)));
+    m_Pages.push_back(page);
+    // Pushed back to front, so the page is handed out in address order.
+    for (size_t i = m_PerPage; i-- > 0;) {
+        FreeBlock* b = reinterpret_cast<FreeBlock*>(page + i * m_BlockSize);
+        b->Next = m_Free;
+        m_Free = b;
+    }
+}
+
+void* FixedPool::Alloc(){
+    if (!m_Free) AddPage();
+    FreeBlock* b = m_Free;
+    m_Free = b->Next;
+    ++m_Live;
+    return b;
+}
+
+void FixedPool::Free(void* p){
+    if (!p) return;
+    assert(m_Live > 0);
+    FreeBlock* b = static_cast<FreeBlock*>(p);
+    b->Next = m_Free;
+    m_Free = b;
+    --m_Live;
+}
+
+void FixedPool::Clear(){
+    assert(m_Live == 0 && "FixedPool cleared with blocks still in use");
+    for (void* page : m_Pages) ::operator delete(page, std::align_val_t(m_BlockAlign));
+    m_Pages.clear();
+    m_Free = nullptr;
+    m_Live = 0;
+}
+
+void* FixedPool::PoolResource::do_allocate(size_t bytes, size_t align){
+    if (bytes <= Pool->m_BlockSize && align <= Pool->m_BlockAlign) return Pool->Alloc();
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+}
+
+void FixedPool::PoolResource::do_deallocate(void* p, size_t bytes, size_t align){
+    if (bytes <= Pool->m_BlockSize && align <= Pool->m_BlockAlign) Pool->Free(p);
+    else std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+}
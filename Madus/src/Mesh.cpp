@@ -1,12 +1,14 @@
 // Copyright Lukas Licon 2025, All Rights Reserved.
 
 #include "Madus/Mesh.h"
+#include "Madus/Memory.h"
+#include "Madus/ResourceMemory.h"
 #include <glad/glad.h>
 #include <vector>
 
 struct V { float p[3]; float n[3]; float uv[2]; };
 
-static GpuMesh Upload(const std::vector<V>& vtx, const std::vector<uint32_t>& idx){
+static GpuMesh Upload(const std::pmr::vector<V>& vtx, const std::pmr::vector<uint32_t>& idx){
     GpuMesh g{};
     glGenVertexArrays(1,&g.vao); glBindVertexArray(g.vao);
     glGenBuffers(1,&g.vbo); glBindBuffer(GL_ARRAY_BUFFER, g.vbo);
@@ -18,12 +20,15 @@ static GpuMesh Upload(const std::vector<V>& vtx, const std::vector<uint32_t>& id
     glEnableVertexAttribArray(2); glVertexAttribPointer(2,2,GL_FLOAT,GL_FALSE,sizeof(V),(void*)(sizeof(float)*6));
     glBindVertexArray(0);
     g.indexCount = (uint32_t)idx.size();
+    ResourceMemory_Track(ResourceKind::Buffer, g.vbo, vtx.size()*sizeof(V));
+    ResourceMemory_Track(ResourceKind::Buffer, g.ibo, idx.size()*sizeof(uint32_t));
     return g;
 }
 
 GpuMesh CreateBoxUnit(){
+    ArenaScope scratch(Memory_Scratch());
     const float s = 0.5f;
-    std::vector<V> v = {
+    std::pmr::vector<V> v({
         // +X (right)
         {{ s,-s,-s},{ 1,0,0},{0,0}}, {{ s, s,-s},{ 1,0,0},{0,1}}, {{ s, s, s},{ 1,0,0},{1,1}}, {{ s,-s, s},{ 1,0,0},{1,0}},
         // -X (left)
@@ -36,28 +41,29 @@ GpuMesh CreateBoxUnit(){
         {{-s,-s, s},{0,0, 1},{0,0}}, {{ s,-s, s},{0,0, 1},{1,0}}, {{ s, s, s},{0,0, 1},{1,1}}, {{-s, s, s},{0,0, 1},{0,1}},
         // -Z (back)
         {{ s,-s,-s},{0,0,-1},{0,0}}, {{-s,-s,-s},{0,0,-1},{1,0}}, {{-s, s,-s},{0,0,-1},{1,1}}, {{ s, s,-s},{0,0,-1},{0,1}},
-    };
-    std::vector<uint32_t> idx; idx.reserve(36);
+    }, scratch.Resource());
+    std::pmr::vector<uint32_t> idx(scratch.Resource()); idx.reserve(36);
     for(uint32_t i=0;i<24;i+=4) idx.insert(idx.end(), {i, i+1, i+2,  i, i+2, i+3}); // CCW
     return Upload(v, idx);
 }
 
 GpuMesh CreatePlane(float size){
+    ArenaScope scratch(Memory_Scratch());
     float s=size*0.5f;
-    std::vector<V> v = {
+    std::pmr::vector<V> v({
         {{-s,0,-s},{0,1,0},{0,0}},
         {{ s,0,-s},{0,1,0},{1,0}},
         {{ s,0, s},{0,1,0},{1,1}},
         {{-s,0, s},{0,1,0},{0,1}},
-    };
-    std::vector<uint32_t> i = {0,2,1, 0,3,2};
+    }, scratch.Resource());
+    std::pmr::vector<uint32_t> i({0,2,1, 0,3,2}, scratch.Resource());
     return Upload(v,i);
 }
 
 
 void DestroyMesh(GpuMesh& m){
-    if(m.ibo) glDeleteBuffers(1,&m.ibo);
-    if(m.vbo) glDeleteBuffers(1,&m.vbo);
+    if(m.ibo){ ResourceMemory_Untrack(ResourceKind::Buffer, m.ibo); glDeleteBuffers(1,&m.ibo); }
+    if(m.vbo){ ResourceMemory_Untrack(ResourceKind::Buffer, m.vbo); glDeleteBuffers(1,&m.vbo); }
     if(m.vao) glDeleteVertexArrays(1,&m.vao);
     m = {};
 }
@@ -0,0 +1,32 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Parallel.h"
+#include "Madus/Jobs.h"
+#include <algorithm>
+#include <thread>
+
+int Parallel_HardwareThreads(){
+    const unsigned n = std::thread::hardware_concurrency();
+    return n ? (int)n : 1;
+}
+
+void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn, int workers){
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if (workers <= 0) workers = Jobs_WorkerCount() + 1;
+
+    const size_t maxChunks = (count + grain - 1) / grain;
+    const size_t chunks = std::min(maxChunks, (size_t)workers);
+    if (chunks <= 1) { fn(0, count); return; }
+
+    // Exactly 'chunks' jobs, so 'workers' still caps the parallelism; the caller runs the first.
+    const size_t per = (count + chunks - 1) / chunks;
+    const std::function<void(size_t, size_t)>* f = &fn;
+    JobCounter done;
+    for (size_t c = 1; c < chunks; ++c) {
+        const size_t b = c * per, e = std::min(count, b + per);
+        if (b < e) Jobs_Run(done, [f, b, e]{ (*f)(b, e); });
+    }
+    fn(0, std::min(count, per));
+    Jobs_Wait(done);
+}
@@ -0,0 +1,322 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Profiler.h"
+#include "Madus/AllocTracker.h"
+
+#if MADUS_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define MADUS_PROFILER_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MADUS_PROFILER_TSC 1
+#endif
+
+namespace {
+constexpr int    kMaxThreads = 64;
+constexpr size_t kRingMask   = PROFILER_RING_EVENTS - 1;
+static_assert((PROFILER_RING_EVENTS & kRingMask) == 0, "ring size must be a power of two");
+
+// ---- clock ----
+
+inline uint64_t SteadyNs(){
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The TSC where there is one (invariant on anything recent), else steady_clock.
+inline uint64_t Ticks(){
+#if MADUS_PROFILER_TSC
+    return __rdtsc();
+#else
+    return SteadyNs();
+#endif
+}
+
+struct Calibration {
+    uint64_t Ticks0, Ns0;
+    Calibration() : Ticks0(Ticks()), Ns0(SteadyNs()) {}
+
+    // Measured against steady_clock over the whole run so far, so it only gets better.
+    double NsPerTick() const {
+#if MADUS_PROFILER_TSC
+        uint64_t ns = SteadyNs(), t = Ticks();
+        while (ns - Ns0 < 1000000) { ns = SteadyNs(); t = Ticks(); }   // at least 1 ms of baseline
+        return double(ns - Ns0) / double(t - Ticks0);
+#else
+        return 1.0;
+#endif
+    }
+};
+const Calibration& Clock(){ static const Calibration c; return c; }
+
+// ---- zones ----
+
+struct ZoneInfo { const char* Name; const char* File; int Line; };
+ZoneInfo          gZones[PROFILER_MAX_ZONES];
+std::atomic<int>  gZoneCount{0};
+std::mutex        gZoneMutex;
+
+struct Event {
+    std::atomic<uint64_t> Start, End, Zone;
+};
+struct ZoneTotal {
+    std::atomic<uint64_t> Ticks, Calls;
+};
+}
+
+// A thread's timeline, or a track fed by Profiler_RecordZone.
+struct ProfTrack {
+    // Written by the owning thread (the track's one writer) only.
+    Event                 Ring[PROFILER_RING_EVENTS];
+    std::atomic<uint64_t> Head{0};
+    ZoneTotal             Totals[PROFILER_MAX_ZONES];
+
+    // Profiler_EndFrame / Profiler_Reset only.
+    uint64_t              SeenTicks[PROFILER_MAX_ZONES];
+    uint64_t              SeenCalls[PROFILER_MAX_ZONES];
+    std::atomic<uint64_t> Floor{0};   // events before this were dropped by Profiler_Reset
+
+    char Name[32];   // under gThreadMutex
+
+    void Push(uint32_t zone, uint64_t start, uint64_t end){
+        const uint64_t h = Head.load(std::memory_order_relaxed);
+        // Orders the previous Head store before the slot writes, for CopyRing.
+        std::atomic_thread_fence(std::memory_order_release);
+        Event& e = Ring[h & kRingMask];
+        e.Start.store(start, std::memory_order_relaxed);
+        e.End.store(end, std::memory_order_relaxed);
+        e.Zone.store(zone, std::memory_order_relaxed);
+        Head.store(h + 1, std::memory_order_release);
+
+        // Single writer: a plain load and store, no locked add.
+        ZoneTotal& t = Totals[zone];
+        t.Ticks.store(t.Ticks.load(std::memory_order_relaxed) + (end - start), std::memory_order_relaxed);
+        t.Calls.store(t.Calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+namespace {
+// ---- threads and tracks ----
+
+ProfTrack*               gThreads[kMaxThreads];
+std::atomic<int>         gThreadCount{0};
+std::atomic<uint64_t>    gDroppedThreads{0};
+std::mutex               gThreadMutex;
+thread_local ProfTrack*  tData = nullptr;
+thread_local bool        tFull = false;
+
+// Never freed: traces can still show threads that have exited.
+ProfTrack* NewTrack(const char* name){
+    MADUS_ALLOC_ALLOW("Profiler");   // once per thread or track
+    std::lock_guard<std::mutex> lock(gThreadMutex);
+    const int n = gThreadCount.load(std::memory_order_relaxed);
+    if (n == kMaxThreads) { gDroppedThreads.fetch_add(1, std::memory_order_relaxed); return nullptr; }
+    ProfTrack* d = new ProfTrack();
+    if (name) std::snprintf(d->Name, sizeof(d->Name), "%s", name);
+    else      std::snprintf(d->Name, sizeof(d->Name), "Thread %d", n);
+    gThreads[n] = d;
+    gThreadCount.store(n + 1, std::memory_order_release);
+    return d;
+}
+
+ProfTrack* Attach(){
+    if (tFull) return nullptr;
+    tData = NewTrack(nullptr);
+    tFull = !tData;
+    return tData;
+}
+
+// ---- frame window ----
+
+struct ZoneWindow {
+    float    Ms[PROFILER_WINDOW_FRAMES];
+    uint32_t Calls[PROFILER_WINDOW_FRAMES];
+};
+ZoneWindow gWindow[PROFILER_MAX_ZONES];
+uint64_t   gFrames = 0;
+std::mutex gWindowMutex;
+
+// Every event still in d's ring, oldest first; anything overwritten while copying is dropped.
+struct Copied { uint64_t Start, End; uint32_t Zone; };
+void CopyRing(const ProfTrack& d, std::vector<Copied>& out){
+    out.clear();
+    const uint64_t head = d.Head.load(std::memory_order_acquire);
+    const uint64_t floor = d.Floor.load(std::memory_order_relaxed);
+    uint64_t from = head > PROFILER_RING_EVENTS ? head - PROFILER_RING_EVENTS : 0;
+    from = std::max(from, floor);
+    out.reserve((size_t)(head - from));
+    for (uint64_t i = from; i < head; ++i) {
+        const Event& e = d.Ring[i & kRingMask];
+        out.push_back({ e.Start.load(std::memory_order_relaxed), e.End.load(std::memory_order_relaxed),
+                        (uint32_t)e.Zone.load(std::memory_order_relaxed) });
+    }
+    // Pairs with the fence in ProfTrack::Push: any slot the owner has started
+    // rewriting since has an index below now + 1 - ring size.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t now = d.Head.load(std::memory_order_relaxed);
+    const uint64_t valid = now + 1 > PROFILER_RING_EVENTS ? now + 1 - PROFILER_RING_EVENTS : 0;
+    if (valid > from) out.erase(out.begin(), out.begin() + (ptrdiff_t)std::min<uint64_t>(valid - from, out.size()));
+}
+
+void WriteJsonString(FILE* f, const char* s){
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) std::fputc(*s, f);
+    }
+    std::fputc('"', f);
+}
+}
+
+uint32_t Profiler_RegisterZone(const char* name, const char* file, int line){
+    Clock();   // the first zone starts the calibration baseline
+    std::lock_guard<std::mutex> lock(gZoneMutex);
+    const int n = gZoneCount.load(std::memory_order_relaxed);
+    if (n == PROFILER_MAX_ZONES) return PROFILER_MAX_ZONES - 1;   // lumped into the last one
+    gZones[n] = { name, file, line };
+    gZoneCount.store(n + 1, std::memory_order_release);
+    return (uint32_t)n;
+}
+
+ProfScope::ProfScope(uint32_t zone) : m_Start(Ticks()), m_Zone(zone) {}
+
+ProfScope::~ProfScope(){
+    const uint64_t end = Ticks();
+    if (ProfTrack* d = tData ? tData : Attach()) d->Push(m_Zone, m_Start, end);
+}
+
+void Profiler_SetThreadName(const char* name){
+    ProfTrack* d = tData ? tData : Attach();
+    if (!d) return;
+    std::lock_guard<std::mutex> lock(gThreadMutex);
+    std::snprintf(d->Name, sizeof(d->Name), "%s", name);
+}
+
+uint64_t Profiler_Ticks(){ return Ticks(); }
+double   Profiler_NsPerTick(){ return Clock().NsPerTick(); }
+
+ProfTrack* Profiler_CreateTrack(const char* name){ return NewTrack(name); }
+
+void Profiler_RecordZone(ProfTrack* track, uint32_t zone, uint64_t startTicks, uint64_t endTicks){
+    if (track) track->Push(zone, startTicks, std::max(startTicks, endTicks));
+}
+
+void Profiler_EndFrame(){
+    const int zones = gZoneCount.load(std::memory_order_acquire);
+    const int threads = gThreadCount.load(std::memory_order_acquire);
+    const double msPerTick = Clock().NsPerTick() * 1e-6;
+
+    std::lock_guard<std::mutex> lock(gWindowMutex);
+    const size_t slot = (size_t)(gFrames % PROFILER_WINDOW_FRAMES);
+    for (int z = 0; z < zones; ++z) {
+        uint64_t ticks = 0, calls = 0;
+        for (int i = 0; i < threads; ++i) {
+            ProfTrack& d = *gThreads[i];
+            const uint64_t t = d.Totals[z].Ticks.load(std::memory_order_relaxed);
+            const uint64_t c = d.Totals[z].Calls.load(std::memory_order_relaxed);
+            ticks += t - d.SeenTicks[z]; d.SeenTicks[z] = t;
+            calls += c - d.SeenCalls[z]; d.SeenCalls[z] = c;
+        }
+        gWindow[z].Ms[slot]    = (float)(double(ticks) * msPerTick);
+        gWindow[z].Calls[slot] = (uint32_t)calls;
+    }
+    ++gFrames;
+}
+
+size_t Profiler_GetZoneStats(std::vector<ProfZoneStats>& out){
+    out.clear();
+    const int zones = gZoneCount.load(std::memory_order_acquire);
+
+    std::lock_guard<std::mutex> lock(gWindowMutex);
+    const size_t frames = (size_t)std::min<uint64_t>(gFrames, PROFILER_WINDOW_FRAMES);
+    if (!frames) return 0;
+    for (int z = 0; z < zones; ++z) {
+        const ZoneWindow& w = gWindow[z];
+        double ms = 0.0, worst = 0.0, calls = 0.0;
+        for (size_t f = 0; f < frames; ++f) {
+            ms += w.Ms[f];
+            worst = std::max(worst, (double)w.Ms[f]);
+            calls += w.Calls[f];
+        }
+        if (calls == 0.0) continue;
+        ProfZoneStats s;
+        s.Name = gZones[z].Name;
+        s.File = gZones[z].File;
+        s.Line = gZones[z].Line;
+        s.AvgMs = ms / double(frames);
+        s.MaxMs = worst;
+        s.CallsPerFrame = calls / double(frames);
+        out.push_back(s);
+    }
+    std::sort(out.begin(), out.end(), [](const ProfZoneStats& a, const ProfZoneStats& b){ return a.AvgMs > b.AvgMs; });
+    return out.size();
+}
+
+bool Profiler_WriteChromeTrace(const char* path){
+    MADUS_ALLOC_ALLOW("Profiler");
+    FILE* f = std::fopen(path, "wb");
+    if (!f) { std::fprintf(stderr, "[Profiler] cannot write '%s'\n", path); return false; }
+
+    const Calibration& clock = Clock();
+    const double usPerTick = clock.NsPerTick() * 1e-3;
+    const int threads = gThreadCount.load(std::memory_order_acquire);
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Madus\"}}");
+
+    size_t written = 0;
+    std::vector<Copied> events;
+    for (int i = 0; i < threads; ++i) {
+        const ProfTrack& d = *gThreads[i];
+        {
+            std::lock_guard<std::mutex> lock(gThreadMutex);
+            std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", i);
+            WriteJsonString(f, d.Name);
+            std::fprintf(f, "}}");
+        }
+        CopyRing(d, events);
+        for (const Copied& e : events) {
+            if (e.Start < clock.Ticks0) continue;
+            std::fprintf(f, ",\n{\"name\":");
+            WriteJsonString(f, gZones[e.Zone].Name);
+            std::fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", i,
+                         double(e.Start - clock.Ticks0) * usPerTick, double(e.End - e.Start) * usPerTick);
+        }
+        written += events.size();
+    }
+    std::fprintf(f, "\n]}\n");
+    const bool ok = std::fclose(f) == 0;
+
+    const uint64_t dropped = gDroppedThreads.load(std::memory_order_relaxed);
+    std::printf("[Profiler] %zu zones from %d threads -> %s", written, threads, path);
+    if (dropped) std::printf(" (%llu threads past the first %d not recorded)", (unsigned long long)dropped, kMaxThreads);
+    std::printf("\n");
+    return ok;
+}
+
+void Profiler_Reset(){
+    const int zones = gZoneCount.load(std::memory_order_acquire);
+    const int threads = gThreadCount.load(std::memory_order_acquire);
+    std::lock_guard<std::mutex> lock(gWindowMutex);
+    for (int i = 0; i < threads; ++i) {
+        ProfTrack& d = *gThreads[i];
+        d.Floor.store(d.Head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        for (int z = 0; z < zones; ++z) {
+            d.SeenTicks[z] = d.Totals[z].Ticks.load(std::memory_order_relaxed);
+            d.SeenCalls[z] = d.Totals[z].Calls.load(std::memory_order_relaxed);
+        }
+    }
+    std::memset(gWindow, 0, sizeof(gWindow));
+    gFrames = 0;
+}
+
+#endif
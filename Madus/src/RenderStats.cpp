@@ -0,0 +1,93 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/RenderStats.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+namespace {
+RenderStats gCurrent;   // GL thread
+
+// Under gMutex.
+std::mutex  gMutex;
+RenderStats gWindow[RENDER_STATS_WINDOW_FRAMES];
+uint64_t    gFinished = 0;
+FILE*       gCsv = nullptr;
+
+void WriteCsvHeader(FILE* f){
+    std::fprintf(f, "frame");
+#define MADUS_RENDER_STATS_COLUMN(name) std::fprintf(f, "," #name);
+    MADUS_RENDER_STATS_FIELDS(MADUS_RENDER_STATS_COLUMN)
+#undef MADUS_RENDER_STATS_COLUMN
+    std::fprintf(f, "\n");
+}
+
+void WriteCsvRow(FILE* f, uint64_t frame, const RenderStats& s){
+    std::fprintf(f, "%llu", (unsigned long long)frame);
+#define MADUS_RENDER_STATS_VALUE(name) std::fprintf(f, ",%llu", (unsigned long long)s.name);
+    MADUS_RENDER_STATS_FIELDS(MADUS_RENDER_STATS_VALUE)
+#undef MADUS_RENDER_STATS_VALUE
+    std::fprintf(f, "\n");
+}
+}
+
+RenderStats& RenderStats_Frame(){ return gCurrent; }
+
+void RenderStats_EndFrame(uint64_t frame){
+    {
+        std::lock_guard<std::mutex> lock(gMutex);
+        gWindow[gFinished % RENDER_STATS_WINDOW_FRAMES] = gCurrent;
+        ++gFinished;
+        if (gCsv) WriteCsvRow(gCsv, frame, gCurrent);
+    }
+    gCurrent = RenderStats{};
+}
+
+RenderStats RenderStats_Last(){
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (!gFinished) return RenderStats{};
+    return gWindow[(gFinished - 1) % RENDER_STATS_WINDOW_FRAMES];
+}
+
+bool RenderStats_GetSummary(RenderStatsSummary& out){
+    std::lock_guard<std::mutex> lock(gMutex);
+    out = RenderStatsSummary{};
+    const int frames = (int)std::min<uint64_t>(gFinished, RENDER_STATS_WINDOW_FRAMES);
+    if (!frames) return false;
+
+    out.Min = out.Max = gWindow[0];
+    for (int i = 0; i < frames; ++i) {
+        const RenderStats& s = gWindow[i];
+#define MADUS_RENDER_STATS_FOLD(name)                   \
+        out.Min.name = std::min(out.Min.name, s.name);  \
+        out.Max.name = std::max(out.Max.name, s.name);  \
+        out.Avg.name += double(s.name);
+        MADUS_RENDER_STATS_FIELDS(MADUS_RENDER_STATS_FOLD)
+#undef MADUS_RENDER_STATS_FOLD
+    }
+#define MADUS_RENDER_STATS_AVG(name) out.Avg.name /= double(frames);
+    MADUS_RENDER_STATS_FIELDS(MADUS_RENDER_STATS_AVG)
+#undef MADUS_RENDER_STATS_AVG
+    out.Frames = frames;
+    return true;
+}
+
+bool RenderStats_OpenCsv(const char* path){
+    FILE* f = std::fopen(path, "w");
+    if (!f) { std::fprintf(stderr, "[RenderStats] cannot write '%s'\n", path); return false; }
+    WriteCsvHeader(f);
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (gCsv) std::fclose(gCsv);
+    gCsv = f;
+    return true;
+}
+
+void RenderStats_CloseCsv(){
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (gCsv) { std::fclose(gCsv); gCsv = nullptr; }
+}
+
+bool RenderStats_CsvOpen(){
+    std::lock_guard<std::mutex> lock(gMutex);
+    return gCsv != nullptr;
+}
@@ -0,0 +1,116 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/RenderThread.h"
+#include "Madus/AllocTracker.h"
+#include "Madus/Headless.h"
+#include "Madus/Profiler.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+
+static double NowMs(){
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+void RenderThread::Start(GLFWwindow* window, HeadlessContext* headless, int maxInFlight){
+    Stop();
+    m_Window = window;
+    m_Headless = headless;
+    m_Packets.clear();
+    const int ring = std::max(1, maxInFlight) + 1;
+    for (int i = 0; i < ring; ++i) m_Packets.push_back(std::make_unique<FramePacket>());
+    m_Submitted = m_Presented = 0;
+    m_Quit = false;
+
+    // Still on the caller's context: GPU state for every packet, instance regions
+    // begun for their first recording. One more region than packets, so the
+    // fence a packet waits on is a frame older than the one it just drew.
+    m_Stream.Init(PACKET_INSTANCE_BYTES, ring + 1);
+    for (auto& p : m_Packets) { FramePacket_InitGpu(*p); FramePacket_BeginInstances(*p, m_Stream); }
+    if (m_Headless) Headless_Release(m_Headless);
+    else glfwMakeContextCurrent(nullptr);
+    m_Thread = std::thread(&RenderThread::Loop, this);
+}
+
+void RenderThread::Stop(){
+    if (!m_Thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+    m_Cv.notify_all();
+    m_Thread.join();
+}
+
+FramePacket& RenderThread::Acquire(){
+    const double t0 = NowMs();
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    // The slot after the last submitted one is free once the ring isn't full.
+    m_Cv.wait(lock, [this]{ return m_Submitted - m_Presented < m_Packets.size(); });
+    m_LastAcquireWaitMs = NowMs() - t0;
+    FramePacket& p = *m_Packets[m_Submitted % m_Packets.size()];
+    lock.unlock();
+    p.Reset();
+    return p;
+}
+
+void RenderThread::Submit(){
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Submitted;
+    }
+    m_Cv.notify_all();
+}
+
+void RenderThread::Flush(){
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Cv.wait(lock, [this]{ return m_Presented == m_Submitted; });
+}
+
+RenderThread::Stats RenderThread::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Stats s;
+    s.Presented = m_Presented;
+    s.LastGLMs = m_LastGLMs;
+    s.LastAcquireWaitMs = m_LastAcquireWaitMs;
+    return s;
+}
+
+void RenderThread::Loop(){
+    MADUS_ALLOC_TAG("RenderThread");
+    Profiler_SetThreadName("Render");
+    if (m_Headless) Headless_MakeCurrent(m_Headless);
+    else glfwMakeContextCurrent(m_Window);
+    for (;;) {
+        FramePacket* p = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cv.wait(lock, [this]{ return m_Quit || m_Presented < m_Submitted; });
+            if (m_Presented == m_Submitted) break;   // quitting with nothing left to draw
+            p = m_Packets[m_Presented % m_Packets.size()].get();
+        }
+
+        const double t0 = NowMs();
+        FramePacket_Execute(*p);
+        {
+            MADUS_PROFILE_ZONE("SwapBuffers");
+            MADUS_ALLOC_ALLOW("Platform");
+            if (m_Headless) Headless_Present(m_Headless);
+            else glfwSwapBuffers(m_Window);
+        }
+        FramePacket_BeginInstances(*p, m_Stream);   // ready for the main thread to record into again
+        const double ms = NowMs() - t0;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            ++m_Presented;
+            m_LastGLMs = ms;
+        }
+        m_Cv.notify_all();
+    }
+    for (auto& p : m_Packets) FramePacket_DestroyGpu(*p);
+    m_Stream.Shutdown();
+    if (m_Headless) Headless_Release(m_Headless);
+    else glfwMakeContextCurrent(nullptr);
+}
@@ -1,30 +1,28 @@
 // Copyright Lukas Licon 2025, All Rights Reserved.
 
 #include "Madus/Renderer.h"
+#include "Madus/GpuProfiler.h"
+#include "Madus/RenderStats.h"
+#include "Madus/ResourceMemory.h"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <initializer_list>
 
 // Shaders
 static ShaderHandle GBasicShader = 0;
+static ShaderHandle GInstancedShader = 0;
 static ShaderHandle GSkyShader = 0;
 static GLuint gDummyVAO = 0;
+static GLuint gTargetFBO = 0;
 
 // Shadows
 static unsigned gShadowTex = 0;
 static unsigned gShadowFBO = 0;
 static int      gShadowSize = 2048;
 static ShaderHandle gShadowDepthShader = 0; // simple depth-only VS/FS
+static ShaderHandle gShadowDepthInstShader = 0;
 static Mat4     gLightVP = Identity();
 
-//helper 
-static Mat4 MulM(const Mat4& A, const Mat4& B){
-    Mat4 R{};
-    for(int c=0;c<4;++c)
-        for(int r=0;r<4;++r)
-            R.m[c*4+r] = A.m[0*4+r]*B.m[c*4+0] + A.m[1*4+r]*B.m[c*4+1] + A.m[2*4+r]*B.m[c*4+2] + A.m[3*4+r]*B.m[c*4+3];
-    return R;
-}
-
 // Depth shaders
 static const char* VS_DEPTH = R"(#version 330 core
 layout(location=0) in vec3 aPos;
@@ -34,6 +32,14 @@ uniform mat4 uLightProj;
 void main(){
     gl_Position = uLightProj * uLightView * uModel * vec4(aPos,1.0);
 })";
+static const char* VS_DEPTH_INST = R"(#version 330 core
+layout(location=0) in vec3 aPos;
+layout(location=3) in mat4 aModel;
+uniform mat4 uLightView;
+uniform mat4 uLightProj;
+void main(){
+    gl_Position = uLightProj * uLightView * aModel * vec4(aPos,1.0);
+})";
 static const char* FS_DEPTH = R"(#version 330 core
 void main(){ /* depth only */ }
 )";
@@ -56,6 +62,24 @@ void main(){
     gl_Position = uProj * uView * ws;
 })";
 
+// Same as VS with the model matrix per instance (attributes 3-6, see BindInstances)
+static const char* VS_INST = R"(#version 330 core
+layout(location=0) in vec3 aPos;
+layout(location=1) in vec3 aNrm;
+layout(location=2) in vec2 aUV;
+layout(location=3) in mat4 aModel;
+
+uniform mat4 uView, uProj;
+out vec3 vNrm; out vec3 vWS; out vec2 vUV;
+
+void main(){
+    vec4 ws = aModel * vec4(aPos,1.0);
+    vWS = ws.xyz;
+    vNrm = mat3(aModel) * aNrm;
+    vUV = aUV;
+    gl_Position = uProj * uView * ws;
+})";
+
 static const char* FS = R"(#version 330 core
 in vec3 vNrm; in vec3 vWS; in vec2 vUV;
 out vec4 FragColor;
@@ -173,6 +197,7 @@ void main(){
 
 
 void Renderer_Init(void*){
+    MADUS_PROFILE_FUNCTION();
     glEnable(GL_FRAMEBUFFER_SRGB);
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
@@ -181,6 +206,7 @@ void Renderer_Init(void*){
     glFrontFace(GL_CCW);
 
     GBasicShader = CreateShaderProgram(VS,FS);
+    GInstancedShader = CreateShaderProgram(VS_INST,FS);
     GSkyShader   = CreateShaderProgram(VS_SKY, FS_SKY);
 
     glGenVertexArrays(1, &gDummyVAO);
@@ -188,19 +214,32 @@ void Renderer_Init(void*){
 }
 
 void Renderer_Shutdown(){
+    MADUS_PROFILE_FUNCTION();
     DestroyShaderProgram(GBasicShader); GBasicShader = 0;
+    DestroyShaderProgram(GInstancedShader); GInstancedShader = 0;
     DestroyShaderProgram(GSkyShader);   GSkyShader   = 0; 
+    if (gShadowFBO) { glDeleteFramebuffers(1, &gShadowFBO); gShadowFBO = 0; }
+    if (gShadowTex) {
+        ResourceMemory_Untrack(ResourceKind::RenderTarget, gShadowTex);
+        glDeleteTextures(1, &gShadowTex); gShadowTex = 0;
+    }
 }
 void Renderer_Resize(int w,int h){
+    MADUS_PROFILE_FUNCTION();
     glViewport(0,0,w,h);
 }
+void Renderer_SetTargetFramebuffer(unsigned fbo){ gTargetFBO = fbo; }
 void Renderer_Begin(const FrameParams& fp){
+    MADUS_PROFILE_FUNCTION();
+    MADUS_GPU_ZONE_BEGIN("GPU Main");   // until Renderer_End
     glClearColor(fp.Clear[0], fp.Clear[1], fp.Clear[2], 1.0f);
     glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
     glUseProgram(GBasicShader);
+    ++RenderStats_Frame().ProgramBinds;
     (void)fp;
 }
 void Renderer_DrawMesh(const GpuMesh& mesh, ShaderHandle sh, const Mat4& model, unsigned albedoTex){
+    MADUS_PROFILE_FUNCTION();
     glUseProgram(sh);
     int locM = GetUniformLocation(sh,"uModel");
     int locS = GetUniformLocation(sh,"uAlbedo");
@@ -216,19 +255,90 @@ void Renderer_DrawMesh(const GpuMesh& mesh, ShaderHandle sh, const Mat4& model,
     glBindVertexArray(mesh.vao);
     glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+
+    RenderStats& st = RenderStats_Frame();
+    ++st.ProgramBinds; ++st.TextureBinds; ++st.VaoBinds;
+    st.UniformUploads += 2;
+    RenderStats_CountDraw(mesh.indexCount);
+}
+void Renderer_End(){
+    MADUS_PROFILE_FUNCTION();
+    MADUS_GPU_ZONE_END();
+}
+
+// Points attributes 3-6 of the mesh VAO (bound) at 'count' column-major
+// matrices starting at byteOffset in vbo, one per instance.
+static void BindInstances(unsigned vbo, size_t byteOffset){
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    for (GLuint c = 0; c < 4; ++c) {
+        glEnableVertexAttribArray(3 + c);
+        glVertexAttribPointer(3 + c, 4, GL_FLOAT, GL_FALSE, sizeof(Mat4), (void*)(byteOffset + c * 4 * sizeof(float)));
+        glVertexAttribDivisor(3 + c, 1);
+    }
+}
+// Mesh VAOs are shared with the non-instanced path; leave them as they were.
+static void UnbindInstances(){
+    for (GLuint c = 0; c < 4; ++c) { glVertexAttribDivisor(3 + c, 0); glDisableVertexAttribArray(3 + c); }
+}
+
+void Renderer_DrawMeshInstanced(const GpuMesh& mesh, ShaderHandle sh, unsigned albedoTex, unsigned instanceVbo, size_t byteOffset, uint32_t count){
+    MADUS_PROFILE_FUNCTION();
+    glUseProgram(sh);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, albedoTex);
+    glUniform1i(GetUniformLocation(sh,"uAlbedo"), 0);
+
+    glBindVertexArray(mesh.vao);
+    BindInstances(instanceVbo, byteOffset);
+    glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0, (GLsizei)count);
+    UnbindInstances();
+    glBindVertexArray(0);
+
+    RenderStats& st = RenderStats_Frame();
+    ++st.ProgramBinds; ++st.TextureBinds; ++st.VaoBinds; ++st.UniformUploads;
+    RenderStats_CountDraw(mesh.indexCount, count);
 }
-void Renderer_End(){}
 
 ShaderHandle Renderer_GetBasicLitShader(){ return GBasicShader; }
+ShaderHandle Renderer_GetInstancedLitShader(){ return GInstancedShader; }
+
+ShaderHandle Renderer_CreateLitProgram(const char* vsSrc){ return CreateShaderProgram(vsSrc, FS); }
+
+void Renderer_ApplyLighting(ShaderHandle sh, const FrameParams& fp){
+    MADUS_PROFILE_FUNCTION();
+    glUseProgram(sh);
+    glUniformMatrix4fv(GetUniformLocation(sh,"uView"),1,GL_FALSE, fp.View.m);
+    glUniformMatrix4fv(GetUniformLocation(sh,"uProj"),1,GL_FALSE, fp.Proj.m);
+
+    glUniform3f(GetUniformLocation(sh,"uSunDir"), fp.Sun.dir[0], fp.Sun.dir[1], fp.Sun.dir[2]);
+    glUniform3f(GetUniformLocation(sh,"uSunColor"), fp.Sun.color[0], fp.Sun.color[1], fp.Sun.color[2]);
+    glUniform1f(GetUniformLocation(sh,"uSunIntensity"), fp.Sun.intensity);
+
+    glUniform3f(GetUniformLocation(sh,"uCamPos"), fp.CamPos.x, fp.CamPos.y, fp.CamPos.z);
+    glUniform3f(GetUniformLocation(sh,"uSkyColor"), 0.32f, 0.42f, 0.62f);
+    glUniform3f(GetUniformLocation(sh,"uGroundColor"), 0.10f, 0.09f, 0.09f);
+
+    glUniformMatrix4fv(GetUniformLocation(sh,"uLightVP"), 1, GL_FALSE, gLightVP.m);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, gShadowTex);
+    glUniform1i(GetUniformLocation(sh,"uShadowMap"), 1);
+    glActiveTexture(GL_TEXTURE0);
+
+    RenderStats& st = RenderStats_Frame();
+    ++st.ProgramBinds; ++st.TextureBinds;
+    st.UniformUploads += 10;
+}
 
 
 void Renderer_Shadow_Init(int size){
+    MADUS_PROFILE_FUNCTION();
     gShadowSize = size;
 
     glGenTextures(1, &gShadowTex);
     glBindTexture(GL_TEXTURE_2D, gShadowTex);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, gShadowSize, gShadowSize, 0,
                  GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    ResourceMemory_Track(ResourceKind::RenderTarget, gShadowTex, ResourceMemory_TextureBytes(gShadowSize, gShadowSize, 3, false));
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
@@ -241,12 +351,15 @@ void Renderer_Shadow_Init(int size){
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, gShadowTex, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, gTargetFBO);
 
     gShadowDepthShader = CreateShaderProgram(VS_DEPTH, FS_DEPTH);
+    gShadowDepthInstShader = CreateShaderProgram(VS_DEPTH_INST, FS_DEPTH);
 }
 
 void Renderer_Shadow_Begin(const ShadowMapInfo& sm){
+    MADUS_PROFILE_FUNCTION();
+    MADUS_GPU_ZONE_BEGIN("GPU Shadow");   // until Renderer_Shadow_End
     gLightVP = MulM(sm.LightProj, sm.LightView); 
 
     glViewport(0,0,gShadowSize,gShadowSize);
@@ -257,29 +370,57 @@ void Renderer_Shadow_Begin(const ShadowMapInfo& sm){
     glPolygonOffset(2.0f, 4.0f);
     glCullFace(GL_FRONT);
 
-    glUseProgram(gShadowDepthShader);
-    int locLV = GetUniformLocation(gShadowDepthShader, "uLightView");
-    int locLP = GetUniformLocation(gShadowDepthShader, "uLightProj");
-    glUniformMatrix4fv(locLV, 1, GL_FALSE, sm.LightView.m);
-    glUniformMatrix4fv(locLP, 1, GL_FALSE, sm.LightProj.m);
+    for (ShaderHandle s : { gShadowDepthInstShader, gShadowDepthShader }) {
+        glUseProgram(s);
+        glUniformMatrix4fv(GetUniformLocation(s, "uLightView"), 1, GL_FALSE, sm.LightView.m);
+        glUniformMatrix4fv(GetUniformLocation(s, "uLightProj"), 1, GL_FALSE, sm.LightProj.m);
+    }
+    RenderStats& st = RenderStats_Frame();
+    ++st.FboSwitches;
+    st.ProgramBinds += 2;
+    st.UniformUploads += 4;
 }
 
 void Renderer_Shadow_DrawDepth(const GpuMesh& mesh, const Mat4& model){
+    MADUS_PROFILE_FUNCTION();
+    glUseProgram(gShadowDepthShader); // other casters (terrain) may have switched programs
     int locM = GetUniformLocation(gShadowDepthShader, "uModel");
     glUniformMatrix4fv(locM, 1, GL_FALSE, model.m);
     glBindVertexArray(mesh.vao);
     glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+
+    RenderStats& st = RenderStats_Frame();
+    ++st.ProgramBinds; ++st.VaoBinds; ++st.UniformUploads;
+    RenderStats_CountDraw(mesh.indexCount);
+}
+void Renderer_Shadow_DrawDepthInstanced(const GpuMesh& mesh, unsigned instanceVbo, size_t byteOffset, uint32_t count){
+    MADUS_PROFILE_FUNCTION();
+    glUseProgram(gShadowDepthInstShader);
+    glBindVertexArray(mesh.vao);
+    BindInstances(instanceVbo, byteOffset);
+    glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0, (GLsizei)count);
+    UnbindInstances();
+    glBindVertexArray(0);
+
+    RenderStats& st = RenderStats_Frame();
+    ++st.ProgramBinds; ++st.VaoBinds;
+    RenderStats_CountDraw(mesh.indexCount, count);
 }
 void Renderer_Shadow_End(){
+    MADUS_PROFILE_FUNCTION();
     glCullFace(GL_BACK);
     glDisable(GL_POLYGON_OFFSET_FILL);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, gTargetFBO);
+    ++RenderStats_Frame().FboSwitches;
+    MADUS_GPU_ZONE_END();
 }
 unsigned Renderer_Shadow_GetTexture(){ return gShadowTex; }
 Mat4 Renderer_Shadow_GetLightVP(){ return gLightVP; } 
 
 void Renderer_DrawSky(const Mat4& view, const Mat4& proj, const DirectionalLight& sun){
+    MADUS_PROFILE_FUNCTION();
+    MADUS_GPU_ZONE("GPU Sky");
     glDisable(GL_DEPTH_TEST);
     glDepthMask(GL_FALSE);
     glDisable(GL_CULL_FACE);
@@ -300,6 +441,11 @@ void Renderer_DrawSky(const Mat4& view, const Mat4& proj, const DirectionalLight
     glBindVertexArray(gDummyVAO);
     glDrawArrays(GL_TRIANGLES, 0, 3);
 
+    RenderStats& st = RenderStats_Frame();
+    ++st.ProgramBinds; ++st.VaoBinds;
+    st.UniformUploads += 7;
+    RenderStats_CountDraw(3);
+
     glEnable(GL_CULL_FACE);
     glDepthMask(GL_TRUE);
     glEnable(GL_DEPTH_TEST);
@@ -0,0 +1,113 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/ResourceMemory.h"
+#include "Madus/AllocTracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+struct Kind {
+    std::unordered_map<uintptr_t, size_t> Live;   // id -> bytes
+    ResourceMemoryKindStats Stats;
+    bool Over = false;
+};
+
+// Under gMutex.
+std::mutex gMutex;
+Kind       gKinds[RESOURCE_KIND_COUNT];
+size_t     gGpuCurrent = 0, gGpuPeak = 0, gGpuBudget = 0;
+bool       gGpuOver = false;
+
+const char* const kNames[RESOURCE_KIND_COUNT] = { "Texture", "Buffer", "RenderTarget", "CpuAsset" };
+
+double Mb(size_t bytes){ return double(bytes) / (1024.0 * 1024.0); }
+
+void CheckBudget(const char* what, size_t current, size_t budget, bool& over){
+    if (!budget) { over = false; return; }
+    if (current <= budget) { over = false; return; }
+    if (over) return;
+    over = true;
+    std::fprintf(stderr, "[ResourceMemory] %s over budget: %.2f MB of %.2f MB\n", what, Mb(current), Mb(budget));
+}
+
+void Apply(ResourceKind kind, size_t oldBytes, size_t newBytes){
+    Kind& k = gKinds[(int)kind];
+    k.Stats.Current = k.Stats.Current - oldBytes + newBytes;
+    k.Stats.Peak = std::max(k.Stats.Peak, k.Stats.Current);
+    CheckBudget(kNames[(int)kind], k.Stats.Current, k.Stats.Budget, k.Over);
+    if (kind == ResourceKind::CpuAsset) return;
+    gGpuCurrent = gGpuCurrent - oldBytes + newBytes;
+    gGpuPeak = std::max(gGpuPeak, gGpuCurrent);
+    CheckBudget("GPU total", gGpuCurrent, gGpuBudget, gGpuOver);
+}
+}
+
+void ResourceMemory_Track(ResourceKind kind, uintptr_t id, size_t bytes){
+    MADUS_ALLOC_ALLOW("ResourceMemory");   // new ids only (load time); growing buffers re-track rarely
+    std::lock_guard<std::mutex> lock(gMutex);
+    Kind& k = gKinds[(int)kind];
+    auto [it, added] = k.Live.try_emplace(id, 0);
+    if (added) ++k.Stats.Count;
+    const size_t old = it->second;
+    it->second = bytes;
+    Apply(kind, old, bytes);
+}
+
+void ResourceMemory_Untrack(ResourceKind kind, uintptr_t id){
+    std::lock_guard<std::mutex> lock(gMutex);
+    Kind& k = gKinds[(int)kind];
+    auto it = k.Live.find(id);
+    if (it == k.Live.end()) return;
+    const size_t old = it->second;
+    k.Live.erase(it);
+    --k.Stats.Count;
+    Apply(kind, old, 0);
+}
+
+void ResourceMemory_SetBudget(ResourceKind kind, size_t bytes){
+    std::lock_guard<std::mutex> lock(gMutex);
+    Kind& k = gKinds[(int)kind];
+    k.Stats.Budget = bytes;
+    k.Over = false;
+    CheckBudget(kNames[(int)kind], k.Stats.Current, k.Stats.Budget, k.Over);
+}
+
+void ResourceMemory_SetGpuBudget(size_t bytes){
+    std::lock_guard<std::mutex> lock(gMutex);
+    gGpuBudget = bytes;
+    gGpuOver = false;
+    CheckBudget("GPU total", gGpuCurrent, gGpuBudget, gGpuOver);
+}
+
+ResourceMemoryStats ResourceMemory_GetStats(){
+    std::lock_guard<std::mutex> lock(gMutex);
+    ResourceMemoryStats s;
+    for (int i = 0; i < RESOURCE_KIND_COUNT; ++i) s.Kinds[i] = gKinds[i].Stats;
+    s.GpuCurrent = gGpuCurrent;
+    s.GpuPeak = gGpuPeak;
+    s.GpuBudget = gGpuBudget;
+    return s;
+}
+
+void ResourceMemory_ResetPeaks(){
+    std::lock_guard<std::mutex> lock(gMutex);
+    for (Kind& k : gKinds) k.Stats.Peak = k.Stats.Current;
+    gGpuPeak = gGpuCurrent;
+}
+
+const char* ResourceMemory_KindName(ResourceKind kind){
+    return (int)kind < RESOURCE_KIND_COUNT ? kNames[(int)kind] : "?";
+}
+
+size_t ResourceMemory_TextureBytes(int w, int h, size_t bytesPerTexel, bool mips){
+    size_t total = 0;
+    w = std::max(1, w); h = std::max(1, h);
+    for (;;) {
+        total += (size_t)w * (size_t)h * bytesPerTexel;
+        if (!mips || (w == 1 && h == 1)) break;
+        w = std::max(1, w / 2); h = std::max(1, h / 2);
+    }
+    return total;
+}
@@ -0,0 +1,35 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Scene.h"
+
+void Scene_TickControllers(EcsWorld& w, float dt, int workers){
+    // Each controller only reads shared, immutable level data, so chunks are independent.
+    w.ParallelEach<CharacterController, CControllerInput>([dt](Entity, CharacterController& c, CControllerInput& in){
+        if (in.Active) c.Tick(in.In, dt, in.CamFwd, in.CamRight);
+    }, workers);
+    w.EachChunk<CharacterController, CTransform>([](size_t n, const Entity*, CharacterController* c, CTransform* t){
+        for (size_t i = 0; i < n; ++i) t[i].Position = c[i].Position;
+    });
+}
+
+void Scene_UpdateWorldMatrices(EcsWorld& w, int workers){
+    w.ParallelEach<CTransform, CWorldMatrix>([](Entity, const CTransform& t, CWorldMatrix& m){
+        m.M = TRS(t.Position, t.Rotation, t.Scale);
+    }, workers);
+}
+
+void Scene_GatherColliders(EcsWorld& w, std::vector<AABB2>& out){
+    out.clear();
+    w.EachChunk<CCollider>([&](size_t n, const Entity*, CCollider* c){
+        for (size_t i = 0; i < n; ++i) out.push_back(c[i].Box);
+    });
+}
+
+void Scene_RecordDraws(EcsWorld& w, ShaderHandle sh, FramePacket& packet, int workers){
+    // Every job records into its own list; the packet sorts and merges them.
+    w.ParallelEach<CWorldMatrix, CRenderMesh>([sh, &packet](Entity, const CWorldMatrix& m, const CRenderMesh& r){
+        if (!r.Mesh) return;
+        const uint8_t passes = r.CastShadow ? DrawList::Main | DrawList::Shadow : DrawList::Main;
+        packet.ThreadList().Add(*r.Mesh, sh, r.Albedo, m.M, passes);
+    }, workers);
+}
@@ -0,0 +1,127 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/StreamBuffer.h"
+#include "Madus/ResourceMemory.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+StreamAlloc StreamFrame::Alloc(size_t bytes, size_t align){
+    assert(align && (align & (align - 1)) == 0);
+    size_t cur = Used.load(std::memory_order_relaxed), at;
+    do {
+        at = (cur + align - 1) & ~(align - 1);
+    } while (!Used.compare_exchange_weak(cur, at + bytes, std::memory_order_relaxed));
+
+    StreamAlloc a;
+    if (Base && at + bytes <= Size) {
+        a.Ptr = Base + at;
+        a.Buffer = Buffer;
+        a.Offset = at;
+    }
+    return a;
+}
+
+static bool HasBufferStorage(){
+    GLint major = 0, minor = 0, n = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    bool has = major > 4 || (major == 4 && minor >= 4);
+    glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+    for (GLint i = 0; i < n && !has; ++i)
+        has = std::strcmp((const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i), "GL_ARB_buffer_storage") == 0;
+    return has && glBufferStorage;   // the loader may not have resolved it
+}
+
+void StreamBuffer::Create(Region& r, size_t bytes){
+    glGenBuffers(1, &r.Buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, r.Buffer);
+    if (m_Persistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, (GLsizeiptr)bytes, nullptr, flags);
+        r.Mapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)bytes, flags));
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)bytes, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    r.Size = bytes;
+    ResourceMemory_Track(ResourceKind::Buffer, r.Buffer, bytes);
+}
+
+void StreamBuffer::Destroy(Region& r){
+    if (r.Fence) glDeleteSync(static_cast<GLsync>(r.Fence));
+    if (r.Buffer) {
+        ResourceMemory_Untrack(ResourceKind::Buffer, r.Buffer);
+        glDeleteBuffers(1, &r.Buffer);   // unmaps a persistent mapping too
+    }
+    r = Region{};
+}
+
+void StreamBuffer::Init(size_t frameBytes, int frames, bool allowPersistent){
+    Shutdown();
+    m_Persistent = allowPersistent && HasBufferStorage();
+    m_Regions.resize((size_t)std::max(1, frames));
+    for (Region& r : m_Regions) Create(r, frameBytes);
+    m_Wanted = frameBytes;
+    m_Next = 0;
+}
+
+void StreamBuffer::Shutdown(){
+    for (Region& r : m_Regions) Destroy(r);
+    m_Regions.clear();
+}
+
+void StreamBuffer::BeginFrame(StreamFrame& f){
+    assert(!m_Regions.empty());
+    const int slot = m_Next;
+    m_Next = (m_Next + 1) % (int)m_Regions.size();
+    Region& r = m_Regions[(size_t)slot];
+
+    // The GPU may still be reading what this region held 'frames' frames ago.
+    if (r.Fence) {
+        GLsync s = static_cast<GLsync>(r.Fence);
+        while (glClientWaitSync(s, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED) {}
+        glDeleteSync(s);
+        r.Fence = nullptr;
+    }
+
+    if (r.Size < m_Wanted) { Destroy(r); Create(r, m_Wanted); }
+
+    if (!m_Persistent) {
+        // The fence makes UNSYNCHRONIZED safe; INVALIDATE lets the driver skip preserving the old contents.
+        glBindBuffer(GL_ARRAY_BUFFER, r.Buffer);
+        r.Mapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)r.Size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    f.Buffer = r.Buffer;
+    f.Base = r.Mapped;
+    f.Size = r.Mapped ? r.Size : 0;
+    f.Slot = slot;
+    f.Used.store(0, std::memory_order_relaxed);
+}
+
+void StreamBuffer::Flush(StreamFrame& f){
+    if (f.Slot < 0 || !f.Base) return;
+    Region& r = m_Regions[(size_t)f.Slot];
+    if (!m_Persistent && r.Mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, r.Buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        r.Mapped = nullptr;
+    }
+    f.Base = nullptr;
+}
+
+void StreamBuffer::EndFrame(StreamFrame& f){
+    if (f.Slot < 0) return;
+    Flush(f);
+    Region& r = m_Regions[(size_t)f.Slot];
+    r.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    const size_t used = f.Used.load(std::memory_order_relaxed);
+    if (used > r.Size) m_Wanted = std::max(m_Wanted, used + used / 2);
+    f.Slot = -1;
+}
@@ -0,0 +1,347 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Terrain.h"
+#include "Madus/RenderStats.h"
+#include "Madus/ResourceMemory.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+static constexpr int kMaxLods = 12;
+static constexpr size_t kInstanceBytes = 4096 * 4 * sizeof(float);   // 4096 nodes per draw; grows on overflow
+
+// Shared displacement + morph code for the lit and the depth variant.
+static const char* VS_TERRAIN_COMMON = R"(#version 330 core
+layout(location=0) in vec2 aGrid;     // [0,1]^2 patch coordinates
+layout(location=3) in vec4 iNode;     // x, z, size, lod
+
+uniform sampler2D uHeight;
+uniform sampler2D uNormal;
+uniform vec4  uField;                 // originX, originZ, cellSize, unused
+uniform vec2  uFieldSize;             // samples in x, z
+uniform vec2  uMorph[12];             // per lod: start, end distance
+uniform float uGridRes;
+uniform vec3  uCamPos;
+
+vec2 FieldUV(vec2 wp){ return ((wp - uField.xy) / uField.z + 0.5) / uFieldSize; }
+float HeightAt(vec2 wp){ return textureLod(uHeight, FieldUV(wp), 0.0).r; }
+
+vec3 TerrainWorldPos(out vec2 outXZ){
+    vec2 wp = iNode.xy + aGrid * iNode.z;
+    float d = distance(uCamPos, vec3(wp.x, HeightAt(wp), wp.y));
+    vec2 m = uMorph[int(iNode.w)];
+    float k = clamp((d - m.x) / max(m.y - m.x, 1e-4), 0.0, 1.0);
+    // Snap odd vertices toward the coarser grid as k -> 1
+    vec2 g = aGrid - fract(aGrid * uGridRes * 0.5) * (2.0 / uGridRes) * k;
+    wp = iNode.xy + g * iNode.z;
+    outXZ = wp;
+    return vec3(wp.x, HeightAt(wp), wp.y);
+}
+)";
+
+static const char* VS_TERRAIN_MAIN = R"(
+uniform mat4 uView, uProj;
+uniform float uUVScale;
+out vec3 vNrm; out vec3 vWS; out vec2 vUV;
+void main(){
+    vec2 wp;
+    vWS = TerrainWorldPos(wp);
+    vNrm = normalize(textureLod(uNormal, FieldUV(wp), 0.0).xyz);
+    vUV = wp * uUVScale;
+    gl_Position = uProj * uView * vec4(vWS, 1.0);
+})";
+
+static const char* VS_TERRAIN_DEPTH_MAIN = R"(
+uniform mat4 uLightView, uLightProj;
+void main(){
+    vec2 wp;
+    vec3 ws = TerrainWorldPos(wp);
+    gl_Position = uLightProj * uLightView * vec4(ws, 1.0);
+})";
+
+static const char* FS_TERRAIN_DEPTH = R"(#version 330 core
+void main(){ /* depth only */ }
+)";
+
+bool TerrainRenderer::Init(const Heightfield& hf){
+    m_Field = &hf;
+    LodLevels = std::clamp(LodLevels, 1, kMaxLods);
+
+    // Patch grid: (GridRes+1)^2 vertices in [0,1]^2
+    std::vector<float> grid;
+    grid.reserve((size_t)(GridRes + 1) * (GridRes + 1) * 2);
+    for (int z = 0; z <= GridRes; ++z)
+        for (int x = 0; x <= GridRes; ++x) { grid.push_back((float)x / GridRes); grid.push_back((float)z / GridRes); }
+    std::vector<uint32_t> idx;
+    idx.reserve((size_t)GridRes * GridRes * 6);
+    for (int z = 0; z < GridRes; ++z)
+        for (int x = 0; x < GridRes; ++x) {
+            uint32_t i0 = z * (GridRes + 1) + x, i1 = i0 + 1, i2 = i0 + (GridRes + 1), i3 = i2 + 1;
+            idx.insert(idx.end(), {i0, i2, i1,  i1, i2, i3}); // CCW seen from +Y
+        }
+    m_IndexCount = (uint32_t)idx.size();
+
+    glGenVertexArrays(1, &m_VAO); glBindVertexArray(m_VAO);
+    glGenBuffers(1, &m_GridVBO); glBindBuffer(GL_ARRAY_BUFFER, m_GridVBO);
+    glBufferData(GL_ARRAY_BUFFER, grid.size()*sizeof(float), grid.data(), GL_STATIC_DRAW);
+    ResourceMemory_Track(ResourceKind::Buffer, m_GridVBO, grid.size()*sizeof(float));
+    glEnableVertexAttribArray(0); glVertexAttribPointer(0,2,GL_FLOAT,GL_FALSE,2*sizeof(float),(void*)0);
+    glGenBuffers(1, &m_IBO); glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx.size()*sizeof(uint32_t), idx.data(), GL_STATIC_DRAW);
+    ResourceMemory_Track(ResourceKind::Buffer, m_IBO, idx.size()*sizeof(uint32_t));
+    glEnableVertexAttribArray(3); glVertexAttribDivisor(3, 1);   // pointed at the stream region per draw
+    glBindVertexArray(0);
+    // Shadow and main pass each take a region, for three frames in flight.
+    m_Instances.Init(kInstanceBytes, 2 * 3);
+
+    glGenTextures(1, &m_HeightTex);
+    glGenTextures(1, &m_NormalTex);
+    for (unsigned t : {m_HeightTex, m_NormalTex}) {
+        glBindTexture(GL_TEXTURE_2D, t);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    UploadHeights();
+
+    const std::string vs      = std::string(VS_TERRAIN_COMMON) + VS_TERRAIN_MAIN;
+    const std::string vsDepth = std::string(VS_TERRAIN_COMMON) + VS_TERRAIN_DEPTH_MAIN;
+    m_Shader      = Renderer_CreateLitProgram(vs.c_str());
+    m_DepthShader = CreateShaderProgram(vsDepth.c_str(), FS_TERRAIN_DEPTH);
+
+    // Quadtree layout: leaves cover GridRes cells, each level up doubles.
+    m_RootSize = hf.CellSize * GridRes * (float)(1 << (LodLevels - 1));
+    m_RootsX = std::max(1, (int)std::ceil(hf.ExtentX() / m_RootSize));
+    m_RootsZ = std::max(1, (int)std::ceil(hf.ExtentZ() / m_RootSize));
+
+    m_Ranges.resize(LodLevels);
+    for (int i = 0; i < LodLevels; ++i) m_Ranges[i] = Lod0Range * (float)(1 << i);
+    BuildMinMax();
+    return true;
+}
+
+void TerrainRenderer::Shutdown(){
+    m_Instances.Shutdown();
+    for (unsigned b : {m_IBO, m_GridVBO}) ResourceMemory_Untrack(ResourceKind::Buffer, b);
+    for (unsigned t : {m_HeightTex, m_NormalTex})    ResourceMemory_Untrack(ResourceKind::Texture, t);
+    if (m_Field) ResourceMemory_Untrack(ResourceKind::CpuAsset, m_Field);
+    if (m_IBO)     glDeleteBuffers(1, &m_IBO);
+    if (m_GridVBO) glDeleteBuffers(1, &m_GridVBO);
+    if (m_VAO)     glDeleteVertexArrays(1, &m_VAO);
+    if (m_HeightTex) glDeleteTextures(1, &m_HeightTex);
+    if (m_NormalTex) glDeleteTextures(1, &m_NormalTex);
+    DestroyShaderProgram(m_Shader);
+    DestroyShaderProgram(m_DepthShader);
+    m_VAO = m_GridVBO = m_IBO = m_HeightTex = m_NormalTex = m_Shader = m_DepthShader = 0;
+    m_Field = nullptr;
+}
+
+void TerrainRenderer::UploadHeights(){
+    const Heightfield& hf = *m_Field;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, m_HeightTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, hf.SizeX, hf.SizeZ, 0, GL_RED, GL_FLOAT, hf.Heights.data());
+
+    std::vector<float> nrm((size_t)hf.SizeX * hf.SizeZ * 3);
+    for (size_t i = 0; i < hf.Heights.size(); ++i) {
+        nrm[i*3+0] = hf.NormalX[i]; nrm[i*3+1] = hf.NormalY[i]; nrm[i*3+2] = hf.NormalZ[i];
+    }
+    glBindTexture(GL_TEXTURE_2D, m_NormalTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, hf.SizeX, hf.SizeZ, 0, GL_RGB, GL_FLOAT, nrm.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    ResourceMemory_Track(ResourceKind::Texture, m_HeightTex, ResourceMemory_TextureBytes(hf.SizeX, hf.SizeZ, 4, false));
+    ResourceMemory_Track(ResourceKind::Texture, m_NormalTex, ResourceMemory_TextureBytes(hf.SizeX, hf.SizeZ, 6, false));
+    // The field itself is the CPU copy the collision queries read.
+    ResourceMemory_Track(ResourceKind::CpuAsset, &hf, (hf.Heights.capacity() + hf.NormalX.capacity() +
+                         hf.NormalY.capacity() + hf.NormalZ.capacity()) * sizeof(float));
+}
+
+void TerrainRenderer::BuildMinMax(){
+    const Heightfield& hf = *m_Field;
+    m_MinMax.assign(LodLevels, {});
+
+    // Leaves scan their samples; parents merge their four children.
+    const int leafX = m_RootsX << (LodLevels - 1), leafZ = m_RootsZ << (LodLevels - 1);
+    m_MinMax[0].resize((size_t)leafX * leafZ);
+    for (int nz = 0; nz < leafZ; ++nz)
+        for (int nx = 0; nx < leafX; ++nx) {
+            const int x0 = std::min(nx * GridRes, hf.SizeX - 1), x1 = std::min(x0 + GridRes, hf.SizeX - 1);
+            const int z0 = std::min(nz * GridRes, hf.SizeZ - 1), z1 = std::min(z0 + GridRes, hf.SizeZ - 1);
+            MinMax mm{ hf.At(x0, z0), hf.At(x0, z0) };
+            for (int z = z0; z <= z1; ++z)
+                for (int x = x0; x <= x1; ++x) { mm.lo = std::min(mm.lo, hf.At(x, z)); mm.hi = std::max(mm.hi, hf.At(x, z)); }
+            m_MinMax[0][(size_t)nz * leafX + nx] = mm;
+        }
+    for (int lod = 1; lod < LodLevels; ++lod) {
+        const int cx = m_RootsX << (LodLevels - 1 - lod), cz = m_RootsZ << (LodLevels - 1 - lod);
+        const int childX = cx * 2;
+        m_MinMax[lod].resize((size_t)cx * cz);
+        for (int nz = 0; nz < cz; ++nz)
+            for (int nx = 0; nx < cx; ++nx) {
+                MinMax mm = m_MinMax[lod-1][(size_t)(nz*2) * childX + nx*2];
+                for (int k = 1; k < 4; ++k) {
+                    const MinMax& c = m_MinMax[lod-1][(size_t)(nz*2 + k/2) * childX + nx*2 + (k&1)];
+                    mm.lo = std::min(mm.lo, c.lo); mm.hi = std::max(mm.hi, c.hi);
+                }
+                m_MinMax[lod][(size_t)nz * cx + nx] = mm;
+            }
+    }
+}
+
+TerrainRenderer::MinMax TerrainRenderer::NodeMinMax(int lod, int nx, int nz) const {
+    const int cx = m_RootsX << (LodLevels - 1 - lod);
+    return m_MinMax[lod][(size_t)nz * cx + nx];
+}
+
+static bool SphereTouchesAABB(const Vec3& c, float r, const Vec3& mn, const Vec3& mx){
+    const float dx = std::max({mn.x - c.x, 0.f, c.x - mx.x});
+    const float dy = std::max({mn.y - c.y, 0.f, c.y - mx.y});
+    const float dz = std::max({mn.z - c.z, 0.f, c.z - mx.z});
+    return dx*dx + dy*dy + dz*dz <= r*r;
+}
+
+// Returns false if the node is out of its own LOD range (the parent then
+// draws that quarter at its coarser level).
+bool TerrainRenderer::SelectNode(int lod, int nx, int nz, const Vec3& cam, const Frustum& fr, Stats& st){
+    const float size = m_RootSize / (float)(1 << (LodLevels - 1 - lod));
+    const Heightfield& hf = *m_Field;
+    const float x0 = hf.OriginX + nx * size, z0 = hf.OriginZ + nz * size;
+    if (x0 >= hf.OriginX + hf.ExtentX() || z0 >= hf.OriginZ + hf.ExtentZ()) return true; // off the field
+
+    const MinMax mm = NodeMinMax(lod, nx, nz);
+    const Vec3 mn{x0, mm.lo, z0}, mx{x0 + size, mm.hi, z0 + size};
+
+    if (!SphereTouchesAABB(cam, m_Ranges[lod], mn, mx)) return false;
+    if (!FrustumTestAABB(fr, mn, mx)) { ++st.Culled; return true; }
+
+    if (lod == 0 || !SphereTouchesAABB(cam, m_Ranges[lod - 1], mn, mx)) {
+        m_Selection.push_back({x0, z0, size, (float)lod});
+        ++st.Selected;
+        return true;
+    }
+    for (int k = 0; k < 4; ++k) {
+        const int cx = nx*2 + (k&1), cz = nz*2 + (k>>1);
+        if (!SelectNode(lod - 1, cx, cz, cam, fr, st)) {
+            // Child quarter drawn at the child size but fully morphed, i.e. at this level's density.
+            const float half = size * 0.5f;
+            m_Selection.push_back({x0 + (k&1) * half, z0 + (k>>1) * half, half, (float)(lod - 1)});
+            ++st.Selected;
+        }
+    }
+    return true;
+}
+
+void TerrainRenderer::Select(const Vec3& camPos, const Mat4& cullVP, Stats& st){
+    st = {};
+    m_Selection.clear();
+    const Frustum fr = FrustumFromMatrix(cullVP);
+    for (int z = 0; z < m_RootsZ; ++z)
+        for (int x = 0; x < m_RootsX; ++x)
+            if (!SelectNode(LodLevels - 1, x, z, camPos, fr, st)) {
+                // Beyond the last range: still draw at the coarsest level.
+                const float x0 = m_Field->OriginX + x * m_RootSize, z0 = m_Field->OriginZ + z * m_RootSize;
+                const MinMax mm = NodeMinMax(LodLevels - 1, x, z);
+                if (FrustumTestAABB(fr, {x0, mm.lo, z0}, {x0 + m_RootSize, mm.hi, z0 + m_RootSize})) {
+                    m_Selection.push_back({x0, z0, m_RootSize, (float)(LodLevels - 1)});
+                    ++st.Selected;
+                } else {
+                    ++st.Culled;
+                }
+            }
+}
+
+void TerrainRenderer::SetCommonUniforms(unsigned sh, const Vec3& camPos){
+    const Heightfield& hf = *m_Field;
+    float morph[kMaxLods * 2] = {};
+    for (int i = 0; i < LodLevels; ++i) {
+        const float lo = (i == 0) ? 0.f : m_Ranges[i - 1];
+        const float end = m_Ranges[i];
+        morph[i*2 + 0] = lo + (end - lo) * MorphStart;
+        morph[i*2 + 1] = end;
+    }
+    glUniform2fv(GetUniformLocation(sh, "uMorph"), kMaxLods, morph);
+    glUniform4f(GetUniformLocation(sh, "uField"), hf.OriginX, hf.OriginZ, hf.CellSize, 0.f);
+    glUniform2f(GetUniformLocation(sh, "uFieldSize"), (float)hf.SizeX, (float)hf.SizeZ);
+    glUniform1f(GetUniformLocation(sh, "uGridRes"), (float)GridRes);
+    glUniform3f(GetUniformLocation(sh, "uCamPos"), camPos.x, camPos.y, camPos.z);
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, m_HeightTex);
+    glUniform1i(GetUniformLocation(sh, "uHeight"), 2);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, m_NormalTex);
+    glUniform1i(GetUniformLocation(sh, "uNormal"), 3);
+    glActiveTexture(GL_TEXTURE0);
+
+    RenderStats& st = RenderStats_Frame();
+    st.TextureBinds += 2;
+    st.UniformUploads += 7;
+}
+
+void TerrainRenderer::DrawSelection(){
+    if (m_Selection.empty()) return;
+    const size_t bytes = m_Selection.size() * sizeof(Node);
+    StreamFrame f;
+    m_Instances.BeginFrame(f);
+    StreamAlloc a = f.Alloc(bytes, alignof(Node));
+    if (!a.Ptr) {
+        // Out of room: fencing this region records the size, so the next one grows to fit.
+        m_Instances.EndFrame(f);
+        m_Instances.BeginFrame(f);
+        a = f.Alloc(bytes, alignof(Node));
+    }
+    if (!a.Ptr) { m_Instances.EndFrame(f); return; }   // the region couldn't be mapped
+    std::memcpy(a.Ptr, m_Selection.data(), bytes);
+    m_Instances.Flush(f);
+
+    // Same as the DrawList path: the instance base is the attribute's byte offset into the region.
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, a.Buffer);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Node), (void*)a.Offset);
+    glDrawElementsInstanced(GL_TRIANGLES, m_IndexCount, GL_UNSIGNED_INT, 0, (GLsizei)m_Selection.size());
+    glBindVertexArray(0);
+    m_Instances.EndFrame(f);
+
+    RenderStats& st = RenderStats_Frame();
+    st.BufferBytes += bytes;
+    ++st.VaoBinds;
+    RenderStats_CountDraw(m_IndexCount, m_Selection.size());
+}
+
+void TerrainRenderer::Draw(const FrameParams& fp, unsigned albedoTex){
+    Select(fp.CamPos, MulM(fp.Proj, fp.View), LastMain);
+
+    Renderer_ApplyLighting(m_Shader, fp);   // binds the program
+    SetCommonUniforms(m_Shader, fp.CamPos);
+    glUniform1f(GetUniformLocation(m_Shader, "uUVScale"), UVScale);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, albedoTex);
+    glUniform1i(GetUniformLocation(m_Shader, "uAlbedo"), 0);
+    DrawSelection();
+
+    RenderStats& st = RenderStats_Frame();
+    ++st.TextureBinds;
+    st.UniformUploads += 2;
+    st.MainSubmitted += (uint64_t)LastMain.Selected;
+    st.MainCulled    += (uint64_t)LastMain.Culled;
+}
+
+void TerrainRenderer::DrawShadow(const ShadowMapInfo& sm, const Vec3& camPos){
+    Select(camPos, MulM(sm.LightProj, sm.LightView), LastShadow);
+
+    glUseProgram(m_DepthShader);
+    glUniformMatrix4fv(GetUniformLocation(m_DepthShader, "uLightView"), 1, GL_FALSE, sm.LightView.m);
+    glUniformMatrix4fv(GetUniformLocation(m_DepthShader, "uLightProj"), 1, GL_FALSE, sm.LightProj.m);
+    SetCommonUniforms(m_DepthShader, camPos);
+    DrawSelection();
+
+    RenderStats& st = RenderStats_Frame();
+    ++st.ProgramBinds;
+    st.UniformUploads += 2;
+    st.ShadowSubmitted += (uint64_t)LastShadow.Selected;
+    st.ShadowCulled    += (uint64_t)LastShadow.Culled;
+}
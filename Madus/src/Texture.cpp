@@ -1,10 +1,12 @@
 // Copyright Lukas Licon 2025, All Rights Reserved.
 
 #include "Madus/Texture.h"
+#include "Madus/Memory.h"
+#include "Madus/ResourceMemory.h"
 #include <glad/glad.h>
-#include <vector>          // <-- needed for CreateCheckerTexture
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
+#include <algorithm>
 #include <iostream>
 
 unsigned CreateTexture2DWhite(){
@@ -16,6 +18,7 @@ unsigned CreateTexture2DWhite(){
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
+    ResourceMemory_Track(ResourceKind::Texture, t, ResourceMemory_TextureBytes(1,1,4,true));
     return t;
 }
 unsigned CreateTexture2DFromFile(const char* path, bool srgb){
@@ -30,32 +33,50 @@ unsigned CreateTexture2DFromFile(const char* path, bool srgb){
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
     stbi_image_free(d);
+    ResourceMemory_Track(ResourceKind::Texture, t, ResourceMemory_TextureBytes(w,h,4,true));
     return t;
 }
-void DestroyTexture(unsigned& t){ if(t){ glDeleteTextures(1,&t); t=0; } }
+void DestroyTexture(unsigned& t){ if(t){ ResourceMemory_Untrack(ResourceKind::Texture, t); glDeleteTextures(1,&t); t=0; } }
 
 
-unsigned CreateCheckerTexture(int size, int checks, bool srgb){
-    const int comp = 4;
-    std::vector<unsigned char> pixels(size*size*comp);
-    for(int y=0;y<size;++y){
+void GenerateCheckerRows(unsigned char* rgba, int size, int checks, int y0, int rows){
+    for(int r=0;r<rows;++r){
+        const int y = y0 + r;
         for(int x=0;x<size;++x){
             int cx = (x * checks / size);
             int cy = (y * checks / size);
             bool odd = ((cx + cy) & 1) != 0;
             unsigned char c = odd ? 200 : 120; // two grays
-            pixels[(y*size + x)*4 + 0] = c;
-            pixels[(y*size + x)*4 + 1] = c;
-            pixels[(y*size + x)*4 + 2] = c;
-            pixels[(y*size + x)*4 + 3] = 255;
+            rgba[(r*size + x)*4 + 0] = c;
+            rgba[(r*size + x)*4 + 1] = c;
+            rgba[(r*size + x)*4 + 2] = c;
+            rgba[(r*size + x)*4 + 3] = 255;
         }
     }
+}
+void GenerateCheckerPixels(unsigned char* rgba, int size, int checks){ GenerateCheckerRows(rgba, size, checks, 0, size); }
+
+unsigned CreateCheckerTexture(int size, int checks, bool srgb){
+    const int comp = 4;
     unsigned t=0; glGenTextures(1,&t); glBindTexture(GL_TEXTURE_2D,t);
-    glTexImage2D(GL_TEXTURE_2D,0,(srgb?GL_SRGB8_ALPHA8:GL_RGBA8),size,size,0,GL_RGBA,GL_UNSIGNED_BYTE,pixels.data());
+    glTexImage2D(GL_TEXTURE_2D,0,(srgb?GL_SRGB8_ALPHA8:GL_RGBA8),size,size,0,GL_RGBA,GL_UNSIGNED_BYTE,nullptr);
+    {
+        // Upload in bands that fit the scratch arena instead of building the whole image.
+        const size_t rowBytes = (size_t)size*comp;
+        const int band = (int)std::max<size_t>(1, (32 * 1024) / rowBytes);
+        ArenaScope scratch(Memory_Scratch());
+        unsigned char* pixels = scratch.Arena().AllocArray<unsigned char>(rowBytes * std::min(band, size));
+        for(int y=0;y<size;y+=band){
+            const int rows = std::min(band, size - y);
+            GenerateCheckerRows(pixels, size, checks, y, rows);
+            glTexSubImage2D(GL_TEXTURE_2D,0,0,y,size,rows,GL_RGBA,GL_UNSIGNED_BYTE,pixels);
+        }
+    }
     glGenerateMipmap(GL_TEXTURE_2D);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
+    ResourceMemory_Track(ResourceKind::Texture, t, ResourceMemory_TextureBytes(size,size,4,true));
     return t;
 }
\ No newline at end of file
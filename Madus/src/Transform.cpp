@@ -0,0 +1,156 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/Transform.h"
+#include <algorithm>
+#include <cassert>
+
+uint32_t TransformHierarchy::Create(uint32_t parent){
+    assert(parent == None || IsValid(parent));
+    uint32_t h;
+    if (!m_FreeHandles.empty()) { h = m_FreeHandles.back(); m_FreeHandles.pop_back(); }
+    else { h = (uint32_t)m_HandleToDense.size(); m_HandleToDense.push_back(None); m_HandleParent.push_back(None); }
+
+    // Appended out of order; Update() re-sorts before using it.
+    m_HandleToDense[h] = (uint32_t)m_World.size();
+    m_HandleParent[h] = parent;
+    m_Parent.push_back(parent == None ? None : Dense(parent));
+    m_Pos.push_back({}); m_Rot.push_back({}); m_Scale.push_back({1, 1, 1});
+    m_Local.push_back(Identity()); m_World.push_back(Identity());
+    m_Dirty.push_back(1);
+    m_DenseToHandle.push_back(h);
+    m_StructureDirty = true;
+    return h;
+}
+
+void TransformHierarchy::SetParent(uint32_t node, uint32_t parent){
+    assert(IsValid(node) && (parent == None || IsValid(parent)));
+    for (uint32_t p = parent; p != None; p = m_HandleParent[p])
+        if (p == node) { assert(!"SetParent would create a cycle"); return; }
+    m_HandleParent[node] = parent;
+    m_Dirty[Dense(node)] = 1;
+    m_StructureDirty = true;
+}
+
+void TransformHierarchy::Destroy(uint32_t node){
+    if (!IsValid(node)) return;
+    if (m_StructureDirty) Resort();
+
+    // Breadth-first order puts every descendant after its parent.
+    const uint32_t n = (uint32_t)m_World.size();
+    std::vector<uint8_t> dead(n, 0);
+    dead[Dense(node)] = 1;
+    for (uint32_t i = Dense(node) + 1; i < n; ++i)
+        if (m_Parent[i] != None && dead[m_Parent[i]]) dead[i] = 1;
+
+    std::vector<uint32_t> remap(n, None);
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t h = m_DenseToHandle[i];
+        if (dead[i]) { m_HandleToDense[h] = None; m_HandleParent[h] = None; m_FreeHandles.push_back(h); continue; }
+        remap[i] = out;
+        m_Parent[out] = m_Parent[i] == None ? None : remap[m_Parent[i]];
+        m_Pos[out] = m_Pos[i]; m_Rot[out] = m_Rot[i]; m_Scale[out] = m_Scale[i];
+        m_Local[out] = m_Local[i]; m_World[out] = m_World[i];
+        m_Dirty[out] = m_Dirty[i];
+        m_DenseToHandle[out] = h;
+        m_HandleToDense[h] = out;
+        ++out;
+    }
+    m_Parent.resize(out); m_DenseToHandle.resize(out);
+    m_Pos.resize(out); m_Rot.resize(out); m_Scale.resize(out);
+    m_Local.resize(out); m_World.resize(out); m_Dirty.resize(out);
+    m_StructureDirty = true;   // level ranges shrank
+}
+
+void TransformHierarchy::SetLocal(uint32_t node, const Vec3& pos, const Quat& rot, const Vec3& scale){
+    const uint32_t i = Dense(node);
+    m_Pos[i] = pos; m_Rot[i] = rot; m_Scale[i] = scale;
+    m_Dirty[i] = 1;
+}
+void TransformHierarchy::SetLocalPosition(uint32_t node, const Vec3& pos){ const uint32_t i = Dense(node); m_Pos[i] = pos; m_Dirty[i] = 1; }
+void TransformHierarchy::SetLocalRotation(uint32_t node, const Quat& rot){ const uint32_t i = Dense(node); m_Rot[i] = rot; m_Dirty[i] = 1; }
+void TransformHierarchy::SetLocalScale(uint32_t node, const Vec3& scale){ const uint32_t i = Dense(node); m_Scale[i] = scale; m_Dirty[i] = 1; }
+
+// Rebuilds the breadth-first order from the handle parents: roots in their
+// current order, then each level's children grouped under their parent.
+void TransformHierarchy::Resort(){
+    const uint32_t n = (uint32_t)m_World.size();
+    const uint32_t handles = (uint32_t)m_HandleToDense.size();
+
+    // Children per handle (CSR), in current dense order so siblings keep their order.
+    std::vector<uint32_t> first(handles + 1, 0), kids(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t p = m_HandleParent[m_DenseToHandle[i]];
+        if (p != None) ++first[p + 1];
+    }
+    for (uint32_t h = 0; h < handles; ++h) first[h + 1] += first[h];
+    std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t h = m_DenseToHandle[i], p = m_HandleParent[h];
+        if (p != None) kids[fill[p]++] = h;
+    }
+
+    std::vector<uint32_t> order;   // handles, breadth-first
+    order.reserve(n);
+    m_LevelStart.assign(1, 0);
+    for (uint32_t i = 0; i < n; ++i)
+        if (m_HandleParent[m_DenseToHandle[i]] == None) order.push_back(m_DenseToHandle[i]);
+    for (size_t b = 0, e = order.size(); b < e; b = e, e = order.size()) {
+        m_LevelStart.push_back((uint32_t)e);
+        for (size_t k = b; k < e; ++k)
+            for (uint32_t c = first[order[k]]; c < first[order[k] + 1]; ++c) order.push_back(kids[c]);
+    }
+
+    auto permute = [&](auto& v){
+        auto tmp = v;
+        for (uint32_t i = 0; i < n; ++i) v[i] = tmp[m_HandleToDense[order[i]]];
+    };
+    permute(m_Pos); permute(m_Rot); permute(m_Scale);
+    permute(m_Local); permute(m_World); permute(m_Dirty);
+    for (uint32_t i = 0; i < n; ++i) { m_DenseToHandle[i] = order[i]; m_HandleToDense[order[i]] = i; }
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t p = m_HandleParent[order[i]];
+        m_Parent[i] = p == None ? None : m_HandleToDense[p];
+    }
+    m_StructureDirty = false;
+}
+
+void TransformHierarchy::Update(){
+    if (m_StructureDirty) Resort();
+    const uint32_t n = (uint32_t)m_World.size();
+    m_Changed.assign(n, 0);
+    LastRecomputed = 0;
+
+    for (size_t lvl = 0; lvl + 1 < m_LevelStart.size(); ++lvl) {
+        const uint32_t b = m_LevelStart[lvl], e = m_LevelStart[lvl + 1];
+
+        // A node changes if its local did or its parent's world did.
+        m_Batch.clear();
+        for (uint32_t i = b; i < e; ++i) {
+            const bool parentChanged = m_Parent[i] != None && m_Changed[m_Parent[i]];
+            if (!m_Dirty[i] && !parentChanged) continue;
+            if (m_Dirty[i]) { m_Local[i] = TRS(m_Pos[i], m_Rot[i], m_Scale[i]); m_Dirty[i] = 0; }
+            m_Changed[i] = 1;
+            m_Batch.push_back(i);
+        }
+        const size_t cnt = m_Batch.size();
+        if (cnt == 0) continue;
+        LastRecomputed += (uint32_t)cnt;
+
+        if (lvl == 0) {   // roots: world = local
+            for (uint32_t i : m_Batch) m_World[i] = m_Local[i];
+            continue;
+        }
+        m_ParentW.resize(cnt);
+        for (size_t k = 0; k < cnt; ++k) m_ParentW[k] = m_World[m_Parent[m_Batch[k]]];
+        if (cnt == e - b) {
+            // whole level: locals and worlds are already contiguous
+            MulMBatch(m_ParentW.data(), &m_Local[b], &m_World[b], cnt);
+        } else {
+            m_LocalW.resize(cnt); m_OutW.resize(cnt);
+            for (size_t k = 0; k < cnt; ++k) m_LocalW[k] = m_Local[m_Batch[k]];
+            MulMBatch(m_ParentW.data(), m_LocalW.data(), m_OutW.data(), cnt);
+            for (size_t k = 0; k < cnt; ++k) m_World[m_Batch[k]] = m_OutW[k];
+        }
+    }
+}
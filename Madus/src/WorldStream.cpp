@@ -0,0 +1,239 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+#include "Madus/WorldStream.h"
+#include "Madus/AllocTracker.h"
+#include "Madus/File.h"
+#include "Madus/Profiler.h"
+#include "Madus/ResourceMemory.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+static uint64_t TileKey(int x, int z){ return ((uint64_t)(uint32_t)x << 32) | (uint32_t)z; }
+static int KeyX(uint64_t k){ return (int)(uint32_t)(k >> 32); }
+static int KeyZ(uint64_t k){ return (int)(uint32_t)k; }
+
+static bool Overlaps(const AABB2& a, const AABB2& b){
+    return a.minx <= b.maxx && a.maxx >= b.minx && a.minz <= b.maxz && a.maxz >= b.minz;
+}
+
+int WorldStreamer::TileOf(float v) const { return (int)std::floor(v / m_TileSize); }
+
+// world.mwld:
+//   MWLD 1
+//   tilesize <metres>
+//   <x> <z> <colliders>     one line per non-empty tile
+bool WorldStreamer::ReadManifest(const std::string& path){
+    std::string text;
+    if (!File_ReadAll(path.c_str(), text)) return false;
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    auto word = [&](std::string_view& w){
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+        const char* b = p;
+        while (p < end && !(*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+        w = std::string_view(b, (size_t)(p - b));
+        return !w.empty();
+    };
+    auto number = [&](auto& v){
+        std::string_view w;
+        return word(w) && std::from_chars(w.data(), w.data() + w.size(), v).ec == std::errc();
+    };
+
+    std::string_view w;
+    int version = 0;
+    if (!word(w) || w != "MWLD" || !number(version) || version != 1) return false;
+    if (!word(w) || w != "tilesize" || !number(m_TileSize) || !(m_TileSize > 0.f)) return false;
+    int x, z; uint64_t count;
+    while (number(x) && number(z) && number(count))
+        m_Existing.insert(TileKey(x, z));
+    return true;
+}
+
+bool WorldStreamer::Open(const WorldStreamConfig& cfg){
+    Close();
+    m_Cfg = cfg;
+    m_Cfg.UnloadRadius = std::max(m_Cfg.UnloadRadius, m_Cfg.LoadRadius);
+    const std::string manifest = cfg.Dir + "/world.mwld";
+    if (!ReadManifest(manifest)) {
+        std::printf("[World] Failed to read '%s'\n", manifest.c_str());
+        m_Existing.clear();
+        return false;
+    }
+    m_Quit = false;
+    m_Thread = std::thread(&WorldStreamer::IoThread, this);
+    std::printf("[World] '%s': %zu tiles of %.1f m\n", cfg.Dir.c_str(), m_Existing.size(), m_TileSize);
+    return true;
+}
+
+void WorldStreamer::Close(){
+    if (m_Thread.joinable()) {
+        { std::lock_guard<std::mutex> lock(m_Mutex); m_Quit = true; }
+        m_Wake.notify_all();
+        m_Thread.join();
+    }
+    m_Queue.clear(); m_Done.clear(); m_DoneFailed.clear(); m_Retire.clear();
+    m_Busy = 0;
+    m_Resident.clear(); m_InFlight.clear(); m_ResidentList.clear(); m_Existing.clear();
+    m_Loaded = m_Evicted = m_Failed = 0;
+}
+
+std::unique_ptr<WorldChunk> WorldStreamer::LoadChunk(int x, int z) const {
+    char name[64];
+    std::snprintf(name, sizeof(name), "/tile_%d_%d.mlvl", x, z);
+    auto c = std::make_unique<WorldChunk>();
+    c->TileX = x; c->TileZ = z;
+    if (!c->Colliders.LoadBin((m_Cfg.Dir + name).c_str())) return nullptr;
+
+    // Reading every box here faults the mapping in on this thread, not in the frame.
+    std::span<const AABB2> boxes = c->Colliders.Colliders();
+    c->Bounds = boxes[0];
+    c->WallModels.reserve(boxes.size());
+    for (const AABB2& b : boxes) {
+        c->Bounds.minx = std::min(c->Bounds.minx, b.minx); c->Bounds.minz = std::min(c->Bounds.minz, b.minz);
+        c->Bounds.maxx = std::max(c->Bounds.maxx, b.maxx); c->Bounds.maxz = std::max(c->Bounds.maxz, b.maxz);
+        const Vec3 center{ 0.5f*(b.minx + b.maxx), m_Cfg.WallCenterY, 0.5f*(b.minz + b.maxz) };
+        const Vec3 size{ b.maxx - b.minx, m_Cfg.WallHeight, b.maxz - b.minz };
+        c->WallModels.push_back(TRS(center, AngleAxis(0, {0,1,0}), size));
+    }
+    ResourceMemory_Track(ResourceKind::CpuAsset, c.get(), boxes.size_bytes() + c->WallModels.capacity() * sizeof(Mat4));
+    return c;
+}
+
+WorldChunk::~WorldChunk(){ ResourceMemory_Untrack(ResourceKind::CpuAsset, this); }
+
+void WorldStreamer::IoThread(){
+    MADUS_ALLOC_TAG("WorldIO");
+    Profiler_SetThreadName("WorldIO");
+    std::vector<std::unique_ptr<WorldChunk>> retire;
+    for (;;) {
+        Request r{};
+        bool work = false;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Wake.wait(lock, [this]{ return m_Quit || !m_Queue.empty() || !m_Retire.empty(); });
+            if (m_Quit) break;
+            retire.swap(m_Retire);
+            if (!m_Queue.empty()) { r = m_Queue.back(); m_Queue.pop_back(); ++m_Busy; work = true; }
+        }
+        retire.clear();   // unmap and free evicted chunks off the main thread
+        if (!work) continue;
+
+        std::unique_ptr<WorldChunk> c = LoadChunk(r.x, r.z);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (c) m_Done.push_back(std::move(c));
+            else   m_DoneFailed.push_back(TileKey(r.x, r.z));
+            --m_Busy;
+            if (m_Queue.empty() && m_Busy == 0) m_Idle.notify_all();
+        }
+    }
+}
+
+void WorldStreamer::Adopt(){
+    std::vector<std::unique_ptr<WorldChunk>> done;
+    std::vector<uint64_t> failed;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        done.swap(m_Done);
+        failed.swap(m_DoneFailed);
+    }
+    for (std::unique_ptr<WorldChunk>& c : done) {
+        const uint64_t k = TileKey(c->TileX, c->TileZ);
+        m_InFlight.erase(k);
+        m_Resident[k] = std::move(c);
+        ++m_Loaded;
+    }
+    for (uint64_t k : failed) {
+        m_InFlight.erase(k);
+        m_Existing.erase(k);   // don't retry a broken tile every frame
+        ++m_Failed;
+    }
+    if (!done.empty()) {
+        m_ResidentList.clear();
+        for (const auto& [k, c] : m_Resident) m_ResidentList.push_back(c.get());
+    }
+}
+
+void WorldStreamer::Update(const Vec3& focus, const Vec3& velocity){
+    if (!IsOpen()) return;
+    Adopt();
+
+    const int hx = TileOf(focus.x), hz = TileOf(focus.z);
+    const int ax = TileOf(focus.x + velocity.x * m_Cfg.PrefetchSeconds);
+    const int az = TileOf(focus.z + velocity.z * m_Cfg.PrefetchSeconds);
+    auto dist = [](int x0, int z0, int x1, int z1){ return std::max(std::abs(x1 - x0), std::abs(z1 - z0)); };
+
+    // Evict: outside the unload ring and not on the prefetch path.
+    std::vector<std::unique_ptr<WorldChunk>> evicted;
+    for (auto it = m_Resident.begin(); it != m_Resident.end();) {
+        const int x = KeyX(it->first), z = KeyZ(it->first);
+        if (dist(hx, hz, x, z) > m_Cfg.UnloadRadius && dist(ax, az, x, z) > 1) {
+            evicted.push_back(std::move(it->second));
+            it = m_Resident.erase(it);
+        } else ++it;
+    }
+    if (!evicted.empty()) {
+        m_Evicted += evicted.size();
+        m_ResidentList.clear();
+        for (const auto& [k, c] : m_Resident) m_ResidentList.push_back(c.get());
+    }
+
+    // Wanted set: the load ring by distance, then the ring ahead of the motion.
+    std::vector<Request> want;
+    auto consider = [&](int x, int z, int priority){
+        const uint64_t k = TileKey(x, z);
+        if (!m_Existing.count(k) || m_Resident.count(k)) return;
+        for (const Request& r : want) if (r.x == x && r.z == z) return;
+        want.push_back({ x, z, priority });
+    };
+    const int R = m_Cfg.LoadRadius;
+    for (int z = hz - R; z <= hz + R; ++z)
+        for (int x = hx - R; x <= hx + R; ++x) consider(x, z, dist(hx, hz, x, z));
+    if (ax != hx || az != hz)
+        for (int z = az - 1; z <= az + 1; ++z)
+            for (int x = ax - 1; x <= ax + 1; ++x) consider(x, z, R + dist(ax, az, x, z));
+    std::stable_sort(want.begin(), want.end(), [](const Request& a, const Request& b){ return a.priority > b.priority; });
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        // Requests not started yet are replaced wholesale; ones already loading finish.
+        for (const Request& r : m_Queue) m_InFlight.erase(TileKey(r.x, r.z));
+        m_Queue.clear();
+        for (const Request& r : want)
+            if (m_InFlight.insert(TileKey(r.x, r.z)).second) m_Queue.push_back(r);
+        for (std::unique_ptr<WorldChunk>& c : evicted) m_Retire.push_back(std::move(c));
+    }
+    if (!want.empty() || !evicted.empty()) m_Wake.notify_one();
+}
+
+void WorldStreamer::Flush(){
+    if (!IsOpen()) return;
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Idle.wait(lock, [this]{ return m_Queue.empty() && m_Busy == 0; });
+    }
+    Adopt();
+}
+
+size_t WorldStreamer::QueryColliders(const AABB2& area, std::vector<AABB2>& out) const {
+    const size_t before = out.size();
+    for (const WorldChunk* c : m_ResidentList) {
+        if (!Overlaps(c->Bounds, area)) continue;
+        for (const AABB2& b : c->Colliders.Colliders())
+            if (Overlaps(b, area)) out.push_back(b);
+    }
+    return out.size() - before;
+}
+
+WorldStreamer::Stats WorldStreamer::GetStats() const {
+    Stats s;
+    s.Resident = m_Resident.size();
+    s.Loaded = m_Loaded; s.Evicted = m_Evicted; s.Failed = m_Failed;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    s.Queued = m_Queue.size() + (size_t)m_Busy;
+    return s;
+}
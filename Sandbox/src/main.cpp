@@ -5,32 +5,36 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm> // std::clamp, std::min/max
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
 #include <vector>
-#include <fstream>
-#include <sstream>
-#include <string>
 
+#include "Madus/Engine.h"
+#include "Madus/App.h"
 #include "Madus/Math.h"
 #include "Madus/Camera.h"
 #include "Madus/Input.h"
+#include "Madus/InputReplay.h"
 #include "Madus/Mesh.h"
 #include "Madus/Texture.h"
 #include "Madus/Renderer.h"
 #include "Madus/CharacterController.h"
+#include "Madus/Heightfield.h"
+#include "Madus/Terrain.h"
+#include "Madus/Level.h"
+#include "Madus/WorldStream.h"
+#include "Madus/Scene.h"
+#include "Madus/Transform.h"
+#include "Madus/Jobs.h"
+#include "Madus/Profiler.h"
+#include "Madus/RenderStats.h"
+#include "Madus/ResourceMemory.h"
 
 static void GLAPIENTRY glDbg(GLenum, GLenum, GLuint, GLenum, GLsizei, const GLchar* msg, const void*) {
     std::cerr << "[GL] " << msg << "\n";
 }
 
-static Mat4 MulM(const Mat4& A, const Mat4& B){
-    Mat4 R{};
-    for(int c=0;c<4;++c)
-        for(int r=0;r<4;++r)
-            R.m[c*4+r] = A.m[0*4+r]*B.m[c*4+0] + A.m[1*4+r]*B.m[c*4+1]
-                       + A.m[2*4+r]*B.m[c*4+2] + A.m[3*4+r]*B.m[c*4+3];
-    return R;
-}
-
 static Vec3 LerpExp(const Vec3& from, const Vec3& to, float dt, float halfLifeSeconds)
 {
     if (halfLifeSeconds <= 0.f) return to;
@@ -39,117 +43,148 @@ static Vec3 LerpExp(const Vec3& from, const Vec3& to, float dt, float halfLifeSe
     return Add(from, Mul(Add(to, Mul(from, -1.f)), t));
 }
 
-// ----------------------------
-// Simple 2D AABB on XZ plane
-// ----------------------------
-struct AABB2 { float minx, minz, maxx, maxz; };
-
-// ----------------------------
-// Level loader (text file)
-// Each non-empty line: minx minz maxx maxz
-// '#' or '//' start a comment
-// ----------------------------
-struct Level {
-    std::vector<AABB2> Colliders;
-
-    static bool IsCommentOrBlank(const std::string& s){
-        size_t i = s.find_first_not_of(" \t\r\n");
-        if (i == std::string::npos) return true;
-        if (s[i] == '#') return true;
-        if (i+1 < s.size() && s[i]=='/' && s[i+1]=='/') return true;
-        return false;
-    }
-
-    bool LoadTxt(const char* path){
-        std::ifstream f(path);
-        if (!f.is_open()){
-            std::printf("[Level] Failed to open '%s'\n", path);
-            return false;
-        }
-        Colliders.clear();
-        std::string line;
-        int lineno = 0, added = 0;
-        while (std::getline(f, line)){
-            ++lineno;
-            if (IsCommentOrBlank(line)) continue;
-            std::istringstream iss(line);
-            float minx, minz, maxx, maxz;
-            if (!(iss >> minx >> minz >> maxx >> maxz)){
-                std::printf("[Level] Parse error at %s:%d -> '%s'\n", path, lineno, line.c_str());
-                continue;
-            }
-            if (maxx < minx) std::swap(maxx, minx);
-            if (maxz < minz) std::swap(maxz, minz);
-            Colliders.push_back({minx, minz, maxx, maxz});
-            ++added;
+// Flat arena floor (the old 40 m plane) surrounded by rolling hills.
+static void BuildSandboxTerrain(Heightfield& hf){
+    hf.Init(257, 257, 0.5f, -64.f, -64.f);
+    for (int z = 0; z < hf.SizeZ; ++z)
+        for (int x = 0; x < hf.SizeX; ++x) {
+            const float wx = hf.OriginX + x * hf.CellSize, wz = hf.OriginZ + z * hf.CellSize;
+            const float edge = std::max(std::fabs(wx), std::fabs(wz)) - 20.f;
+            const float t = std::clamp(edge / 12.f, 0.f, 1.f);
+            const float hills = 2.5f + 1.5f * std::sin(wx * 0.15f) * std::cos(wz * 0.11f);
+            hf.At(x, z) = t * t * (3.f - 2.f * t) * hills;
         }
-        std::printf("[Level] Loaded %d colliders from '%s'\n", added, path);
-        return (added > 0);
+    hf.RebuildNormals();
+}
+
+static Vec3 Lerp(const Vec3& a, const Vec3& b, float t){ return Add(a, Mul(Sub(b, a), t)); }
+
+class SandboxApp : public madus::IApp {
+public:
+    void OnStartup() override;
+    void OnShutdown() override;
+    void OnUpdate(double frameDt) override;
+    void OnFixedUpdate(double step) override;
+    void OnRecord(FramePacket& packet, double alpha) override;
+
+    // --record: what each tick was handed, saved on exit (ticks while the
+    // cursor is released record as inactive, the hero sits them out).
+    // --replay: ticks take it from the recording instead of the keyboard.
+    InputRecording inputRec;
+    const char* recordPath = nullptr;
+    bool replaying = false;
+    uint64_t simTick = 0;
+
+private:
+    GLFWwindow* win = nullptr;   // null when headless
+    bool Key(int key) const { return win && glfwGetKey(win, key) == GLFW_PRESS; }
+    bool gMouseCaptured = true;
+    int w = 1920, h = 1080;
+    Camera cam;
+
+    const float baseYawDeg   = 45.f;    // face down world diagonal
+    const float basePitchDeg = -35.f;   // tilt downward
+
+    float targetOffX = 0.f;
+    float targetOffY = 0.f;
+
+    // Geometry & materials
+    Heightfield terrainField;
+    TerrainRenderer terrain;
+    GpuMesh box{};
+    unsigned ground = 0, white = 0;
+    ShaderHandle sh = 0, shInst = 0;   // per-draw and instanced lit
+
+    // Scene entities: the hero and, without streaming, the level walls
+    EcsWorld scene;
+    Entity   heroEnt{};
+    CharacterController& Hero(){ return *scene.Get<CharacterController>(heroEnt); }
+
+    // Hero visual rig: root at the interpolated pose, body and nose attached
+    TransformHierarchy xforms;
+    uint32_t heroNode = 0, bodyNode = 0, noseNode = 0;
+
+    // Profiler: F9 writes a Chrome trace and prints the render stats and
+    // resource memory; F10 toggles render_stats.csv; the title shows the
+    // rolling frame time
+    bool traceKeyDown = false, csvKeyDown = false;
+    std::vector<ProfZoneStats> zoneStats;
+    double FrameMs() const {
+        for (const ProfZoneStats& z : zoneStats) if (std::string_view(z.Name) == "Frame") return z.AvgMs;
+        return 0.0;
     }
+
+    // Hero state at the start of the last fixed tick, for render interpolation
+    Vec3  prevHeroPos{};
+    float prevBobT = 0.f;
+
+    // Streamed tiles when assets/world/room01 exists, else one static level
+    WorldStreamer world;
+    std::vector<AABB2> nearColliders;   // resident colliders around the hero, refilled per tick
+    std::vector<AABB2> levelColliders;  // dense copy of the wall entities' CCollider
+
+    // Resident chunks whose wall batch survives the light / camera frustum, refilled per frame
+    std::vector<const WorldChunk*> shadowChunks, viewChunks;
+    uint32_t shadowCulledWalls = 0, viewCulledWalls = 0;
+    Frustum lightFr{}, viewFr{};
+
+    // Rig update and both culls on job threads; built once, Run() per frame
+    TaskGraph frameTasks;
+
+    uint32_t CullWallBatches(const Frustum& fr, std::vector<const WorldChunk*>& out) const;
+    void PrintReport();
 };
 
-// ------------------------------------------------------
-// Circle (hero) vs AABB2 resolve on XZ, keeps on ground
-// (This stays identical to your old resolver)
-// ------------------------------------------------------
-static bool ResolveCircleAABB2(Vec3& pos, Vec3& vel, float radius, const AABB2& b)
-{
-    float qx = std::min(std::max(pos.x, b.minx), b.maxx);
-    float qz = std::min(std::max(pos.z, b.minz), b.maxz);
-    float dx = pos.x - qx;
-    float dz = pos.z - qz;
-    float d2 = dx*dx + dz*dz;
-
-    if (d2 > 0.0f) {
-        float r = radius;
-        if (d2 < r*r) {
-            float d = std::sqrt(d2);
-            float nx = dx / d, nz = dz / d;
-            float push = (r - d);
-            pos.x += nx * push; pos.z += nz * push;
-            float vn = vel.x*nx + vel.z*nz;
-            if (vn < 0.f) { vel.x -= vn*nx; vel.z -= vn*nz; }
-            return true;
-        }
-        return false;
-    } else {
-        float left   = pos.x - b.minx;
-        float right  = b.maxx - pos.x;
-        float down   = pos.z - b.minz;
-        float up     = b.maxz - pos.z;
-        float minX = std::min(left, right);
-        float minZ = std::min(down, up);
-        if (minX < minZ) {
-            float nx = (left < right) ? 1.f : -1.f;
-            float push = minX + radius;
-            pos.x += nx * push;
-            float vn = vel.x*nx;
-            if (vn < 0.f) vel.x -= vn*nx;
-        } else {
-            float nz = (down < up) ? 1.f : -1.f;
-            float push = minZ + radius;
-            pos.z += nz * push;
-            float vn = vel.z*nz;
-            if (vn < 0.f) vel.z -= vn*nz;
-        }
-        return true;
+// Resident chunks whose wall bounds intersect the frustum; returns the walls
+// left out. Safe on a job thread.
+uint32_t SandboxApp::CullWallBatches(const Frustum& fr, std::vector<const WorldChunk*>& out) const {
+    out.clear();
+    uint32_t culled = 0;
+    for (const WorldChunk* c : world.Resident()) {
+        const Vec3 mn{ c->Bounds.minx, -0.5f, c->Bounds.minz };   // walls span y in [-0.5, 2.5]
+        const Vec3 mx{ c->Bounds.maxx,  2.5f, c->Bounds.maxz };
+        if (FrustumTestAABB(fr, mn, mx)) out.push_back(c);
+        else culled += (uint32_t)c->WallModels.size();
     }
+    return culled;
 }
 
-int main(){
-    if(!glfwInit()){ std::cerr<<"GLFW init failed\n"; return -1; }
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR,3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR,3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE,GLFW_OPENGL_CORE_PROFILE);
-    GLFWwindow* win = glfwCreateWindow(1920,1080,"Madus Sandbox",nullptr,nullptr);
-    if(!win){ glfwTerminate(); return -1; }
-    glfwMakeContextCurrent(win);
-    glfwSwapInterval(1);
-    glfwSetInputMode(win, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-    if (glfwRawMouseMotionSupported()) glfwSetInputMode(win, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
-    bool gMouseCaptured = true;
+// Slowest zones, render stats and resource memory: on F9, and on exit when headless.
+void SandboxApp::PrintReport(){
+    Profiler_GetZoneStats(zoneStats);
+    for (size_t i = 0; i < zoneStats.size() && i < 12; ++i)
+        std::printf("  %-32s %8.3f ms avg %8.3f ms max %8.1f calls\n", zoneStats[i].Name,
+                    zoneStats[i].AvgMs, zoneStats[i].MaxMs, zoneStats[i].CallsPerFrame);
+    RenderStatsSummary rs;
+    if (RenderStats_GetSummary(rs)) {
+#define SANDBOX_PRINT_STAT(name) \
+        std::printf("  %-32s %10llu min %12.1f avg %10llu max\n", #name, \
+                    (unsigned long long)rs.Min.name, rs.Avg.name, (unsigned long long)rs.Max.name);
+        MADUS_RENDER_STATS_FIELDS(SANDBOX_PRINT_STAT)
+#undef SANDBOX_PRINT_STAT
+    }
+    const ResourceMemoryStats mem = ResourceMemory_GetStats();
+    for (int k = 0; k < RESOURCE_KIND_COUNT; ++k)
+        std::printf("  %-32s %8.2f MB %8.2f MB peak %6zu live\n", ResourceMemory_KindName((ResourceKind)k),
+                    mem.Kinds[k].Current / 1048576.0, mem.Kinds[k].Peak / 1048576.0, mem.Kinds[k].Count);
+    std::printf("  %-32s %8.2f MB %8.2f MB peak\n", "GPU total", mem.GpuCurrent / 1048576.0, mem.GpuPeak / 1048576.0);
+    const madus::FramePacerStats ps = GetEngine().GetPacerStats();
+    std::printf("  %-32s %8.3f ms %8.3f ms sd %8.3f ms max %6.2f ms target%s\n", "Frame interval", ps.FrameMs,
+                ps.FrameStdDevMs, ps.FrameMaxMs, ps.TargetMs, ps.JustInTime ? " (just-in-time)" : "");
+    std::printf("  %-32s %8.3f ms %8.3f ms work %8.3f ms wait %6llu missed\n", "Input to deadline", ps.InputLatencyMs,
+                ps.WorkMs, ps.WaitMs, (unsigned long long)ps.Missed);
+}
+
+static float DegToRad(float d){ return d * (float)MADUS_PI / 180.f; }
+
+void SandboxApp::OnStartup(){
+    win = GetEngine().GetWindow();
+    if (win) {
+        glfwSetInputMode(win, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+        if (glfwRawMouseMotionSupported()) glfwSetInputMode(win, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+    }
+    gMouseCaptured = true;
 
-    if(!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)){ std::cerr<<"glad failed\n"; return -1; }
 #ifndef NDEBUG
     if (glDebugMessageCallback) {
         glEnable(GL_DEBUG_OUTPUT);
@@ -162,291 +197,330 @@ int main(){
     Renderer_Init(win);
     Renderer_Shadow_Init(2048);
 
-    int w=1920,h=1080;
+    GetEngine().GetFramebufferSize(w, h);
     Renderer_Resize(w,h);
-    Camera cam;
-
-    auto DegToRad = [](float d){ return d * (float)MADUS_PI / 180.f; };
-
-    const float baseYawDeg   = 45.f;    // face down world diagonal
-    const float basePitchDeg = -35.f;   // tilt downward
 
     cam.FovY  = DegToRad(65.f);
     cam.Pos   = {0, 8, 12}; // gets snapped below anyway
 
-    // Boom parameters (constant)
-    const float camBack   = 12.0f;
-    const float camUp     = 8.0f;
-    const float eyeLift   = 1.0f;
+    BuildSandboxTerrain(terrainField);
+    terrain.Init(terrainField);
+    box    = CreateBoxUnit();
+    ground = CreateCheckerTexture(1024, 16, true);
+    white  = CreateTexture2DWhite();
 
-    const float maxHoriz = 2.0f;
-    const float maxVert  = 1.5f;
-    const float panSpeed = 3.0f;
-    const float springHalfLife = 0.25f;
+    sh = Renderer_GetBasicLitShader();
+    shInst = Renderer_GetInstancedLitShader();
 
-    float targetOffX = 0.f;
-    float targetOffY = 0.f;
-
-    // Geometry & materials
-    GpuMesh plane = CreatePlane(40.f);
-    GpuMesh box   = CreateBoxUnit();
-    unsigned ground = CreateCheckerTexture(1024, 16, true);
-    unsigned white  = CreateTexture2DWhite();
-
-    ShaderHandle sh = Renderer_GetBasicLitShader();
-
-    CharacterController hero{};
+    heroEnt = scene.Create();
+    scene.Add<CTransform>(heroEnt);
+    scene.Add<CControllerInput>(heroEnt);
+    CharacterController& hero = scene.Add<CharacterController>(heroEnt);  // last Add, so this stays valid
     hero.Position = {0, 0, 0};
-
-    double lastTime = glfwGetTime();
-
-    // load from file with a fallback
+    hero.Ground = &terrainField;
+    prevHeroPos = hero.Position;
+
+    heroNode = xforms.Create();
+    bodyNode = xforms.Create(heroNode);
+    noseNode = xforms.Create(heroNode);
+    xforms.SetLocal(bodyNode, {0, 0, 0}, {}, {1.0f, 1.5f, 1.0f});
+    xforms.SetLocal(noseNode, {0.9f, 0.75f, 0}, {}, {0.18f, 0.18f, 0.55f});   // +X is the yaw forward
+
+    SandboxApp* app = this;
+    frameTasks.Add([app]{ app->xforms.Update(); });
+    frameTasks.Add([app]{ app->shadowCulledWalls = app->CullWallBatches(app->lightFr, app->shadowChunks); });
+    frameTasks.Add([app]{ app->viewCulledWalls = app->CullWallBatches(app->viewFr, app->viewChunks); });
+
+    WorldStreamConfig wc;
+    wc.Dir = "assets/world/room01";
+    if (world.Open(wc)) {
+        world.Update(hero.Position, hero.Velocity);
+        world.Flush();   // the starting ring is resident before the first tick
+        return;
+    }
+    // cooked level first (mapped, zero-copy), then the text source, then a fallback
     Level level;
-    if (!level.LoadTxt("assets/levels/room01.txt")) {
+    if (!level.LoadBin("assets/levels/room01.mlvl") && !level.LoadTxt("assets/levels/room01.txt")) {
         std::printf("[Level] Using fallback layout\n");
         const float halfW = 19.0f, halfD = 19.0f, th = 1.0f;
-        level.Colliders.push_back({-halfW-th, -halfD-th, -halfW,   halfD+th}); // left wall
-        level.Colliders.push_back({ halfW,    -halfD-th,  halfW+th, halfD+th}); // right wall
-        level.Colliders.push_back({-halfW,    -halfD-th,  halfW,   -halfD});    // bottom wall
-        level.Colliders.push_back({-halfW,     halfD,     halfW,    halfD+th}); // top wall
-        level.Colliders.push_back({-0.6f, -0.6f, +0.6f, +0.6f});
+        level.SetColliders({
+            {-halfW-th, -halfD-th, -halfW,   halfD+th}, // left wall
+            { halfW,    -halfD-th,  halfW+th, halfD+th}, // right wall
+            {-halfW,    -halfD-th,  halfW,   -halfD},    // bottom wall
+            {-halfW,     halfD,     halfW,    halfD+th}, // top wall
+            {-0.6f, -0.6f, +0.6f, +0.6f},
+        });
+    }
+    // One entity per wall; made 3m tall so they're visible
+    for (const AABB2& b : level.Colliders()) {
+        const Entity e = scene.Create();
+        scene.Add<CCollider>(e).Box = b;
+        CTransform& t = scene.Add<CTransform>(e);
+        t.Position = { 0.5f*(b.minx + b.maxx), 1.0f, 0.5f*(b.minz + b.maxz) };
+        t.Scale    = { b.maxx - b.minx, 3.0f, b.maxz - b.minz };
+        scene.Add<CWorldMatrix>(e);
+        scene.Add<CRenderMesh>(e, CRenderMesh{ &box, white, true });
     }
+    Scene_UpdateWorldMatrices(scene);
+    Scene_GatherColliders(scene, levelColliders);
+    hero.Colliders     = levelColliders.data();
+    hero.ColliderCount = levelColliders.size();
+}
 
-    while(!glfwWindowShouldClose(win)){
-        glfwPollEvents();
+void SandboxApp::OnShutdown(){
+    if (!win) PrintReport();
+    if (recordPath && inputRec.Save(recordPath))
+        std::printf("[Input] Recorded %llu ticks to '%s'\n", (unsigned long long)inputRec.TickCount, recordPath);
+    DestroyTexture(ground);
+    DestroyTexture(white);
+    DestroyMesh(box);
+    terrain.Shutdown();
+    world.Close();
+    Renderer_Shutdown();
+}
 
-        int fbw, fbh; glfwGetFramebufferSize(win, &fbw, &fbh);
-        if (fbw!=w || fbh!=h){ w=fbw; h=fbh; Renderer_Resize(w,h); }
+void SandboxApp::OnUpdate(double frameDt){
+    const float dt = (float)frameDt;
+    CharacterController& hero = Hero();
 
-        double now = glfwGetTime();
-        float dt = float(now - lastTime);
-        lastTime = now;
+    GetEngine().GetFramebufferSize(w, h);   // the engine hands the size to the GL thread with each packet
 
-        InputState in{}; Input_Poll(in);
+    // Press ESC to release cursor
+    if (Key(GLFW_KEY_ESCAPE) && gMouseCaptured) {
+        glfwSetInputMode(win, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+        if (glfwRawMouseMotionSupported()) glfwSetInputMode(win, GLFW_RAW_MOUSE_MOTION, GLFW_FALSE);
+        gMouseCaptured = false;
+        Input_SetActive(false);
+        Input_ResetMouse();
+    }
+    // Press LMB to recapture cursor
+    if (win && glfwGetMouseButton(win, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && !gMouseCaptured) {
+        glfwSetInputMode(win, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+        if (glfwRawMouseMotionSupported()) glfwSetInputMode(win, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+        gMouseCaptured = true;
+        Input_SetActive(true);
+        Input_ResetMouse();
+    }
 
-        // Press ESC to release cursor
-        if (glfwGetKey(win, GLFW_KEY_ESCAPE) == GLFW_PRESS && gMouseCaptured) {
-            glfwSetInputMode(win, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-            if (glfwRawMouseMotionSupported()) glfwSetInputMode(win, GLFW_RAW_MOUSE_MOTION, GLFW_FALSE);
-            gMouseCaptured = false;
-            Input_SetActive(false);
-            Input_ResetMouse();
-        }
-        // Press LMB to recapture cursor
-        if (glfwGetMouseButton(win, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && !gMouseCaptured) {
-            glfwSetInputMode(win, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-            if (glfwRawMouseMotionSupported()) glfwSetInputMode(win, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
-            gMouseCaptured = true;
-            Input_SetActive(true);
-            Input_ResetMouse();
-        }
+    // F9: dump the profiler rings and the slowest zones
+    const bool traceKey = Key(GLFW_KEY_F9);
+    if (traceKey && !traceKeyDown && Profiler_WriteChromeTrace("madus_trace.json")) PrintReport();
+    traceKeyDown = traceKey;
 
-        if (Input_IsActive()) {
-            hero.Tick(in, dt, cam.Forward(), cam.Right());
+    // F10: start / stop streaming render stats to CSV
+    const bool csvKey = Key(GLFW_KEY_F10);
+    if (csvKey && !csvKeyDown) {
+        if (RenderStats_CsvOpen()) RenderStats_CloseCsv();
+        else RenderStats_OpenCsv("render_stats.csv");
+    }
+    csvKeyDown = csvKey;
+
+    // HUD title (unchanged)
+    static float hudAccum = 0.f;
+    hudAccum += dt;
+    if (hudAccum > 0.10f) {
+        hudAccum = 0.f;
+        const char* stateStr = "Idle";
+        switch (hero.State) {
+            case EPlayerState::Idle: stateStr = "Idle"; break;
+            case EPlayerState::Move: stateStr = "Move"; break;
+            case EPlayerState::Jump: stateStr = "Jump"; break;
+            case EPlayerState::Fall: stateStr = "Fall"; break;
+            case EPlayerState::Dash: stateStr = "Dash"; break;
         }
+        Profiler_GetZoneStats(zoneStats);
+        const madus::FramePacerStats pacer = GetEngine().GetPacerStats();
+        char title[320];
+        std::snprintf(title, sizeof(title),
+            "Madus Sandbox | frame=%.2f ms  sd=%.2f  input lat=%.1f ms | spd=%.2f m/s  acc=%.1f m/s^2  state=%s  dashT=%.2f cd=%.2f  invul=%s  grounded=%s",
+            FrameMs(), pacer.FrameStdDevMs, pacer.InputLatencyMs, hero.LastSpeed, hero.AccelMag, stateStr, hero.DashTimer, hero.DashCDTimer,
+            hero.Invulnerable ? "Y" : "N",
+            hero.Grounded ? "Y" : "N");
+        if (win) glfwSetWindowTitle(win, title);
+    }
 
-        // Collide hero with level colliders on XZ
-        for (const AABB2& b : level.Colliders) {
-            ResolveCircleAABB2(hero.Position, hero.Velocity, hero.CapsuleRadius, b);
-        }
+    // Camera pan offsets (frame-rate independent springs, stay on the frame clock)
+    if (Key(GLFW_KEY_RIGHT)) targetOffX += 3.0f * dt;
+    if (Key(GLFW_KEY_LEFT))  targetOffX -= 3.0f * dt;
+    if (Key(GLFW_KEY_UP))    targetOffY += 3.0f * dt;
+    if (Key(GLFW_KEY_DOWN))  targetOffY -= 3.0f * dt;
+
+    targetOffX = std::clamp(targetOffX, -2.0f, +2.0f);
+    targetOffY = std::clamp(targetOffY, -1.5f, +1.5f);
+
+    auto Spring01 = [](float v, float dt, float halfLife){
+        if (halfLife <= 0.f) return v;
+        float k = 1.f - std::exp(-std::log(2.f) * dt / halfLife);
+        return v * (1.f - k);
+    };
+    bool anyH = Key(GLFW_KEY_LEFT) || Key(GLFW_KEY_RIGHT);
+    bool anyV = Key(GLFW_KEY_UP)   || Key(GLFW_KEY_DOWN);
+    if (!anyH) targetOffX = Spring01(targetOffX, dt, 0.25f);
+    if (!anyV) targetOffY = Spring01(targetOffY, dt, 0.25f);
+
+    // Tile requests follow the hero; finished loads are adopted here, never mid-tick
+    world.Update(hero.Position, hero.Velocity);
+
+    // The camera boom is fixed, so its basis is valid before the sim runs.
+    cam.Yaw   = DegToRad(baseYawDeg);
+    cam.Pitch = DegToRad(basePitchDeg);
+}
 
-        // HUD title (unchanged)
-        static float hudAccum = 0.f;
-        hudAccum += dt;
-        if (hudAccum > 0.10f) {
-            hudAccum = 0.f;
-            const char* stateStr = "Idle";
-            switch (hero.State) {
-                case EPlayerState::Idle: stateStr = "Idle"; break;
-                case EPlayerState::Move: stateStr = "Move"; break;
-                case EPlayerState::Fall: stateStr = "Fall"; break;
-                case EPlayerState::Dash: stateStr = "Dash"; break;
-            }
-            char title[256];
-            std::snprintf(title, sizeof(title),
-                "Madus Sandbox | spd=%.2f m/s  acc=%.1f m/s^2  state=%s  dashT=%.2f cd=%.2f  invul=%s  grounded=%s",
-                hero.LastSpeed, hero.AccelMag, stateStr, hero.DashTimer, hero.DashCDTimer,
-                hero.Invulnerable ? "Y" : "N",
-                hero.Grounded ? "Y" : "N");
-            glfwSetWindowTitle(win, title);
-        }
+void SandboxApp::OnFixedUpdate(double step){
+    CharacterController& hero = Hero();
+    prevHeroPos = hero.Position;
+    prevBobT    = hero.BobT;
+
+    // Swept collision happens inside Tick; when streaming it only sees the
+    // resident boxes this tick's move can reach
+    if (world.IsOpen()) {
+        const float reach = hero.CapsuleRadius + Length(hero.Velocity) * (float)step + 1.0f;
+        const AABB2 area{ hero.Position.x - reach, hero.Position.z - reach, hero.Position.x + reach, hero.Position.z + reach };
+        nearColliders.clear();
+        world.QueryColliders(area, nearColliders);
+        hero.Colliders     = nearColliders.data();
+        hero.ColliderCount = nearColliders.size();
+    }
 
-        const float baseYaw   = DegToRad(baseYawDeg);
-        const float basePitch = DegToRad(basePitchDeg);
-
-        auto ForwardFrom = [](float yaw, float pitch)->Vec3 {
-            float cy = std::cos(yaw), sy = std::sin(yaw);
-            float cp = std::cos(pitch), sp = std::sin(pitch);
-            return Normalize(Vec3{ cy*cp, sp, -sy*cp });
-        };
-
-        Vec3 baseFwd   = ForwardFrom(baseYaw, basePitch);
-        Vec3 baseRight = Normalize(Cross(baseFwd, Vec3{0,1,0}));
-        cam.Pos   = Add(hero.Position, Add(Mul(baseFwd, -12.0f), Vec3{0, 8.0f, 0}));
-        cam.Yaw   = baseYaw;
-        cam.Pitch = basePitch;
-
-        if (glfwGetKey(win, GLFW_KEY_RIGHT) == GLFW_PRESS) targetOffX += 3.0f * dt;
-        if (glfwGetKey(win, GLFW_KEY_LEFT)  == GLFW_PRESS) targetOffX -= 3.0f * dt;
-        if (glfwGetKey(win, GLFW_KEY_UP)    == GLFW_PRESS) targetOffY += 3.0f * dt;
-        if (glfwGetKey(win, GLFW_KEY_DOWN)  == GLFW_PRESS) targetOffY -= 3.0f * dt;
-
-        targetOffX = std::clamp(targetOffX, -2.0f, +2.0f);
-        targetOffY = std::clamp(targetOffY, -1.5f, +1.5f);
-
-        auto Spring01 = [](float v, float dt, float halfLife){
-            if (halfLife <= 0.f) return v;
-            float k = 1.f - std::exp(-std::log(2.f) * dt / halfLife);
-            return v * (1.f - k);
-        };
-        bool anyH = (glfwGetKey(win, GLFW_KEY_LEFT)==GLFW_PRESS) || (glfwGetKey(win, GLFW_KEY_RIGHT)==GLFW_PRESS);
-        bool anyV = (glfwGetKey(win, GLFW_KEY_UP)==GLFW_PRESS)   || (glfwGetKey(win, GLFW_KEY_DOWN)==GLFW_PRESS);
-        if (!anyH) targetOffX = Spring01(targetOffX, dt, 0.25f);
-        if (!anyV) targetOffY = Spring01(targetOffY, dt, 0.25f);
-
-        Vec3 target = Add(hero.Position, Vec3{0, 1.0f, 0});
-        target = Add(target, Mul(baseRight, targetOffX));
-        target = Add(target, Mul(Vec3{0,1,0}, targetOffY));
-
-        FrameParams fp{};
-        fp.View = LookAt(cam.Pos, target, Vec3{0,1,0});
-        fp.Proj = cam.Proj((float)w/(float)h);
-        fp.Sun  = DirectionalLight{};
-        fp.Sun.dir[0] = -0.35f; fp.Sun.dir[1] = -0.90f; fp.Sun.dir[2] = -0.20f;
-        fp.Sun.intensity = 3.0f;
-
-        Vec3 sunDir = Normalize(Vec3{ fp.Sun.dir[0], fp.Sun.dir[1], fp.Sun.dir[2] });
-        fp.Sun.dir[0] = sunDir.x;
-        fp.Sun.dir[1] = sunDir.y;
-        fp.Sun.dir[2] = sunDir.z;
-
-        //  SHADOW PASS 
-        Vec3 center = hero.Position; center.y = 0.0f;
-        float lightDist = 30.0f;
-        Vec3 lightPos = Add(center, Mul(sunDir, -lightDist));  // center - dir * dist
-
-        Mat4 LView = LookAt(lightPos, center, {0,1,0});
-        float R = 18.0f;
-        Mat4 LProj = Ortho(-R, R, -R, R, 0.1f, 80.0f);
-
-        ShadowMapInfo sm{ LView, LProj, 2048 };
-        Renderer_Shadow_Begin(sm);
-        {
-            Renderer_Shadow_DrawDepth(plane, TRS({0,0,0}, AngleAxis(0,{0,1,0}), {1,1,1}));
-            Renderer_Shadow_DrawDepth(box,   TRS(hero.Position, AngleAxis(0,{0,1,0}), {1,1,1}));
-            // Level walls into shadow map
-            for (const AABB2& b : level.Colliders) {
-                float cx = 0.5f*(b.minx + b.maxx);
-                float cz = 0.5f*(b.minz + b.maxz);
-                float sx = (b.maxx - b.minx);
-                float sz = (b.maxz - b.minz);
-                Mat4 M = TRS(Vec3{cx, 1.0f, cz}, AngleAxis(0,{0,1,0}), Vec3{sx, 3.0f, sz});
-                Renderer_Shadow_DrawDepth(box, M);
-            }
-        }
-        Renderer_Shadow_End();
-
-        // Restore viewport after shadow pass
-        glViewport(0,0,w,h);
-
-        //  MAIN PASS 
-        Renderer_Begin(fp);
-
-        // sky
-        Renderer_DrawSky(fp.View, fp.Proj, fp.Sun);
-
-        glUseProgram(sh);
-
-        // Common uniforms
-        int locV   = GetUniformLocation(sh,"uView");
-        int locP   = GetUniformLocation(sh,"uProj");
-        int locDir = GetUniformLocation(sh,"uSunDir");
-        int locCol = GetUniformLocation(sh,"uSunColor");
-        int locInt = GetUniformLocation(sh,"uSunIntensity");
-        int locCam = GetUniformLocation(sh,"uCamPos");
-        int locSky = GetUniformLocation(sh,"uSkyColor");
-        int locGnd = GetUniformLocation(sh,"uGroundColor");
-        int locSh  = GetUniformLocation(sh,"uShadowMap");
-        int locLVP = GetUniformLocation(sh,"uLightVP");
-
-        // upload view/proj
-        glUniformMatrix4fv(locV,1,GL_FALSE, fp.View.m);
-        glUniformMatrix4fv(locP,1,GL_FALSE, fp.Proj.m);
-
-        // upload sun using SAME normalized vector
-        glUniform3f(locDir, sunDir.x, sunDir.y, sunDir.z);
-        glUniform3f(locCol, fp.Sun.color[0], fp.Sun.color[1], fp.Sun.color[2]);
-        glUniform1f(locInt, fp.Sun.intensity);
-
-        // camera + hemisphere colors
-        glUniform3f(locCam, cam.Pos.x, cam.Pos.y, cam.Pos.z);
-        glUniform3f(locSky, 0.32f, 0.42f, 0.62f);
-        glUniform3f(locGnd, 0.10f, 0.09f, 0.09f);
-
-        // shadow bindings
-        Mat4 LightVP = MulM(LProj, LView); // order: P * V
-        glUniformMatrix4fv(locLVP, 1, GL_FALSE, LightVP.m);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, Renderer_Shadow_GetTexture());
-        glUniform1i(locSh, 1);
-        glActiveTexture(GL_TEXTURE0);
-
-        // draw ground
-        Mat4 Mground = TRS({0,0,0}, AngleAxis(0,{0,1,0}), {1,1,1});
-        Renderer_DrawMesh(plane, sh, Mground, ground);
-
-        // hero proxy
-        Vec3 heroPosDraw = hero.Position;
-
-        // vertical bob (subtle)
-        float bobY = std::sin(hero.BobT) * hero.BobAmount;
-        heroPosDraw.y += bobY;
-        auto ForwardFromYawXZ = [](float yaw)->Vec3 {
-            return Normalize(Vec3{ std::cos(yaw), 0.0f, -std::sin(yaw) });
-        };
-        Vec3 fwdXZ = ForwardFromYawXZ(hero.VisualYaw);
-
-        // Main body (box)
-        Mat4 Mhero = TRS(heroPosDraw, AngleAxis(hero.VisualYaw, {0,1,0}), {1.0f, 1.5f, 1.0f});
-        Renderer_DrawMesh(box, sh, Mhero, white);
-
-        // nose 
-        const float noseForwardOffset = 0.9f;
-        const float noseHeightOffset  = 0.75f;
-        const Vec3  noseScale         = {0.18f, 0.18f, 0.55f};
-
-        Vec3 nosePos = heroPosDraw;
-        nosePos.x += fwdXZ.x * noseForwardOffset;
-        nosePos.z += fwdXZ.z * noseForwardOffset;
-        nosePos.y = hero.GroundY + noseHeightOffset + bobY; 
-
-        Mat4 Mnose = TRS(nosePos, AngleAxis(hero.VisualYaw, {0,1,0}), noseScale);
-        Renderer_DrawMesh(box, sh, Mnose, white);
-
-
-        // collider visualization (from level.Colliders)
-        for (const AABB2& b : level.Colliders) {
-            float cx = 0.5f*(b.minx + b.maxx);
-            float cz = 0.5f*(b.minz + b.maxz);
-            float sx = (b.maxx - b.minx);
-            float sz = (b.maxz - b.minz);
-            // make them 3m tall so they're visible
-            Mat4 M = TRS(Vec3{cx, 1.0f, cz}, AngleAxis(0,{0,1,0}), Vec3{sx, 3.0f, sz});
-            Renderer_DrawMesh(box, sh, M, white);
-        }
+    // Events up to this frame's pump; presses since the last tick are kept, so short taps still land
+    InputState in{};
+    Input_Sample(in, GetEngine().GetTickTime());
 
-        Renderer_End();
-        glfwSwapBuffers(win);
+    CControllerInput& ci = *scene.Get<CControllerInput>(heroEnt);
+    if (replaying) ci.In = inputRec.At(simTick, &ci.Active);
+    else {
+        ci.Active = Input_IsActive();
+        ci.In = ci.Active ? in : InputState{};
+        if (recordPath) inputRec.Record(simTick, ci.In, ci.Active);
+    }
+    ++simTick;
+    ci.CamFwd   = cam.Forward();
+    ci.CamRight = cam.Right();
+    Scene_TickControllers(scene, (float)step);
+}
 
-        in.ClearFrameDeltas();
+void SandboxApp::OnRecord(FramePacket& packet, double alpha){
+    const float a = (float)alpha;
+    const CharacterController& hero = Hero();
+    const Vec3  heroPos = Lerp(prevHeroPos, hero.Position, a);
+    const float heroBobT = prevBobT + (hero.BobT - prevBobT) * a;
+
+    Vec3 baseFwd   = cam.Forward();
+    Vec3 baseRight = Normalize(Cross(baseFwd, Vec3{0,1,0}));
+    cam.Pos   = Add(heroPos, Add(Mul(baseFwd, -12.0f), Vec3{0, 8.0f, 0}));
+
+    Vec3 target = Add(heroPos, Vec3{0, 1.0f, 0});
+    target = Add(target, Mul(baseRight, targetOffX));
+    target = Add(target, Mul(Vec3{0,1,0}, targetOffY));
+
+    FrameParams fp{};
+    fp.View = LookAt(cam.Pos, target, Vec3{0,1,0});
+    fp.CamPos = cam.Pos;
+    fp.Proj = cam.Proj((float)w/(float)h);
+    fp.Sun  = DirectionalLight{};
+    fp.Sun.dir[0] = -0.35f; fp.Sun.dir[1] = -0.90f; fp.Sun.dir[2] = -0.20f;
+    fp.Sun.intensity = 3.0f;
+
+    Vec3 sunDir = Normalize(Vec3{ fp.Sun.dir[0], fp.Sun.dir[1], fp.Sun.dir[2] });
+    fp.Sun.dir[0] = sunDir.x;
+    fp.Sun.dir[1] = sunDir.y;
+    fp.Sun.dir[2] = sunDir.z;
+
+    // vertical bob (subtle); only the rig root changes, the hierarchy redoes its subtree
+    const float bobY = std::sin(heroBobT) * hero.BobAmount;
+    xforms.SetLocal(heroNode, Add(heroPos, Vec3{0, bobY, 0}), AngleAxis(hero.VisualYaw, {0,1,0}), {1, 1, 1});
+
+    Vec3 center = heroPos; center.y = terrainField.Height(heroPos.x, heroPos.z);
+    float lightDist = 30.0f;
+    Vec3 lightPos = Add(center, Mul(sunDir, -lightDist));  // center - dir * dist
+
+    Mat4 LView = LookAt(lightPos, center, {0,1,0});
+    float R = 18.0f;
+    Mat4 LProj = Ortho(-R, R, -R, R, 0.1f, 80.0f);
+    packet.Params = fp;
+    packet.HasShadow = true;
+    packet.Shadow = ShadowMapInfo{ LView, LProj, 2048 };
+
+    // Culling and the rig update run on job threads; recording into the packet stays here.
+    lightFr = FrustumFromMatrix(MulM(LProj, LView));
+    viewFr  = FrustumFromMatrix(MulM(fp.Proj, fp.View));
+    frameTasks.Run();
+
+    // Terrain does its own selection and GL, so it runs as callbacks on the GL thread.
+    packet.ShadowPass.push_back({ [](void* ctx, const FramePacket& p){
+        static_cast<SandboxApp*>(ctx)->terrain.DrawShadow(p.Shadow, p.Params.CamPos);
+    }, this });
+    packet.MainPass.push_back({ [](void* ctx, const FramePacket& p){
+        SandboxApp* app = static_cast<SandboxApp*>(ctx);
+        app->terrain.Draw(p.Params, app->ground);
+    }, this });
+
+    // hero proxy
+    packet.Draw(box, sh, xforms.World(bodyNode), white);
+    packet.Draw(box, sh, xforms.World(noseNode), white);
+    packet.CastShadow(box, xforms.World(bodyNode));
+
+    // collider visualization: scene entities, then the walls of each visible resident
+    // chunk, recorded on job threads into per-thread instanced draw lists
+    Scene_RecordDraws(scene, shInst, packet);
+    auto recordWalls = [&](const std::vector<const WorldChunk*>& chunks, uint8_t passes){
+        Jobs_ParallelFor(chunks.size(), 1, [&](size_t b, size_t e){
+            DrawList& list = packet.ThreadList();
+            for (size_t i = b; i < e; ++i)
+                for (const Mat4& m : chunks[i]->WallModels) list.Add(box, shInst, white, m, passes);
+        });
+    };
+    recordWalls(viewChunks, DrawList::Main);
+    recordWalls(shadowChunks, DrawList::Shadow);
+    packet.MainCulled += viewCulledWalls;
+    packet.ShadowCulled += shadowCulledWalls;
+}
+
+// Sandbox [--headless] [--frames N] [--size WxH] [--fps N [--jit]] [--record file.minp | --replay file.minp]
+int main(int argc, char** argv){
+    madus::EngineConfig cfg;
+    cfg.width  = 1920;
+    cfg.height = 1080;
+    cfg.title  = "Madus Sandbox";
+    cfg.vsync  = true;
+    cfg.tickRate = 60.0;
+
+    SandboxApp app;
+    const char* replayPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--headless") {
+            cfg.headless = true;
+        } else if (arg == "--frames" && i + 1 < argc) {
+            cfg.maxFrames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--size" && i + 1 < argc) {
+            std::sscanf(argv[++i], "%dx%d", &cfg.width, &cfg.height);
+        } else if (arg == "--fps" && i + 1 < argc) {
+            cfg.targetFps = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--jit") {
+            cfg.justInTimeFrames = true;
+        } else if (arg == "--record" && i + 1 < argc) {
+            app.recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--headless] [--frames N] [--size WxH] [--fps N [--jit]] [--record file | --replay file]\n", argv[0]);
+            return 2;
+        }
     }
 
-    DestroyTexture(ground);
-    DestroyTexture(white);
-    DestroyMesh(box);
-    DestroyMesh(plane);
-    Renderer_Shutdown();
-    glfwDestroyWindow(win);
-    glfwTerminate();
-    return 0;
+    if (replayPath) {
+        // One tick per frame at the recorded rate, until the recording ends.
+        if (!app.inputRec.Load(replayPath)) return 1;
+        app.replaying = true;
+        app.recordPath = nullptr;
+        cfg.tickRate = app.inputRec.TickRate;
+        cfg.fixedFrameDt = 1.0 / app.inputRec.TickRate;
+        if (!cfg.maxFrames) cfg.maxFrames = app.inputRec.TickCount;
+    }
+    app.inputRec.TickRate = cfg.tickRate;
+    if (cfg.headless && !cfg.maxFrames) cfg.maxFrames = 600;
+
+    madus::Engine engine(cfg, &app);
+    return engine.Run();
 }
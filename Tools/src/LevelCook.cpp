@@ -0,0 +1,130 @@
+// Copyright Lukas Licon 2025, All Rights Reserved.
+
+// Cooks a text level (minx minz maxx maxz per line) into the binary .mlvl
+// format that Level::LoadBin maps at runtime. With -O the colliders are
+// simplified first (contained boxes dropped, adjacent boxes merged) and the
+// result is checked against the source before anything is written.
+// With --tiles the output is a streaming world directory instead (see
+// WorldStream.h): world.mwld plus one tile_<x>_<z>.mlvl per non-empty tile.
+//
+// usage: MadusLevelCook [-O] [--split <len>] [--radius <r>] <in.txt> <out.mlvl>
+//        MadusLevelCook [-O] [--split <len>] [--radius <r>] --tiles <size> <in.txt> <outdir>
+
+#include "Madus/Level.h"
+#include "Madus/LevelOptimize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Clips every box into the tiles it overlaps. Tile edges are k*size for
+// integer k, computed the same way on both sides, so the pieces tile the box.
+static std::map<std::pair<int, int>, std::vector<AABB2>> SplitIntoTiles(std::span<const AABB2> boxes, float size){
+    std::map<std::pair<int, int>, std::vector<AABB2>> tiles;
+    for (const AABB2& b : boxes) {
+        const int x0 = (int)std::floor(b.minx / size), x1 = (int)std::floor(b.maxx / size);
+        const int z0 = (int)std::floor(b.minz / size), z1 = (int)std::floor(b.maxz / size);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x) {
+                AABB2 p{ std::max(b.minx, x * size), std::max(b.minz, z * size),
+                         std::min(b.maxx, (x + 1) * size), std::min(b.maxz, (z + 1) * size) };
+                // a box ending exactly on an edge would leave a zero-width sliver in the next tile
+                if ((p.minx == p.maxx && b.minx < b.maxx) || (p.minz == p.maxz && b.minz < b.maxz)) continue;
+                tiles[{x, z}].push_back(p);
+            }
+    }
+    return tiles;
+}
+
+static bool WriteWorld(const char* dir, std::span<const AABB2> boxes, float size){
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    const auto tiles = SplitIntoTiles(boxes, size);
+
+    const std::string manifest = std::string(dir) + "/world.mwld";
+    std::FILE* f = std::fopen(manifest.c_str(), "wb");
+    if (!f) { std::fprintf(stderr, "[Cook] cannot write '%s'\n", manifest.c_str()); return false; }
+    std::fprintf(f, "MWLD 1\ntilesize %.9g\n", size);
+    size_t pieces = 0;
+    bool ok = true;
+    for (const auto& [key, list] : tiles) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "/tile_%d_%d.mlvl", key.first, key.second);
+        Level tile;
+        tile.SetColliders(list);
+        ok = tile.SaveBin((std::string(dir) + name).c_str()) && ok;
+        std::fprintf(f, "%d %d %zu\n", key.first, key.second, list.size());
+        pieces += list.size();
+    }
+    ok = (std::fclose(f) == 0) && ok;
+    std::printf("[Cook] %zu tiles of %.1f m, %zu colliders after clipping -> %s\n", tiles.size(), size, pieces, dir);
+    return ok;
+}
+
+static int Usage(const char* exe){
+    std::fprintf(stderr, "usage: %s [-O] [--split <len>] [--radius <r>] [--tiles <size>] <in.txt> <out.mlvl|outdir>\n", exe);
+    return 2;
+}
+
+int main(int argc, char** argv){
+    bool optimize = false;
+    float split = 0.f, radius = 0.35f, tileSize = 0.f; // CharacterController::CapsuleRadius default
+    const char* in = nullptr;
+    const char* out = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if      (!std::strcmp(argv[i], "-O")) optimize = true;
+        else if (!std::strcmp(argv[i], "--split")  && i + 1 < argc) { split  = std::strtof(argv[++i], nullptr); optimize = true; }
+        else if (!std::strcmp(argv[i], "--radius") && i + 1 < argc) radius = std::strtof(argv[++i], nullptr);
+        else if (!std::strcmp(argv[i], "--tiles")  && i + 1 < argc) tileSize = std::strtof(argv[++i], nullptr);
+        else if (!in)  in = argv[i];
+        else if (!out) out = argv[i];
+        else return Usage(argv[0]);
+    }
+    if (!in || !out) return Usage(argv[0]);
+
+    Level level;
+    if (!level.LoadTxt(in)) return 1;
+
+    if (optimize) {
+        LevelOptimizeOptions opt;
+        opt.SplitLength = split;
+        opt.Radius = radius;
+        LevelOptimizeStats st;
+        std::vector<AABB2> boxes = Level_Optimize(level.Colliders(), opt, &st);
+        std::printf("[Cook] colliders %zu -> %zu (dropped %zu, merged %zu, split +%zu, %zu rejected, %d passes)\n",
+                    st.Before, st.After, st.Dropped, st.Merged, st.Split, st.Rejected, st.Passes);
+
+        const LevelVerifyResult v = Level_VerifyPushout(level.Colliders(), boxes, radius);
+        std::printf("[Cook] pushout check r=%.3f: %zu samples, %zu distance and %zu resolve mismatches\n",
+                    radius, v.Samples, v.Mismatches, v.ResolveMismatches);
+        if (!v.Ok()) {
+            std::fprintf(stderr, "[Cook] optimized colliders differ from the source, not writing '%s'\n", out);
+            return 1;
+        }
+        level.SetColliders(std::move(boxes));
+    }
+
+    if (tileSize > 0.f) {
+        if (optimize) {
+            // Tiles hold the clipped pieces; check they still add up to the source.
+            // Only the distance can match: WorldStreamer gathers colliders from
+            // whichever tiles are resident, so there is no fixed resolve order.
+            std::vector<AABB2> pieces;
+            for (auto& [key, list] : SplitIntoTiles(level.Colliders(), tileSize)) pieces.insert(pieces.end(), list.begin(), list.end());
+            const LevelVerifyResult v = Level_VerifyPushout(level.Colliders(), pieces, radius);
+            if (v.Mismatches) { std::fprintf(stderr, "[Cook] tiling changed the colliders (%zu mismatches)\n", v.Mismatches); return 1; }
+        }
+        return WriteWorld(out, level.Colliders(), tileSize) ? 0 : 1;
+    }
+
+    if (!level.SaveBin(out)) return 1;
+    std::printf("[Cook] %s -> %s (%zu colliders)\n", in, out, level.Colliders().size());
+    return 0;
+}